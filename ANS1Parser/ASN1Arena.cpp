@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    ASN1Arena.cpp
+    Created: 17 Oct 2026 9:02:11am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "ASN1Arena.h"
+
+namespace
+{
+///one open container on the decoder's explicit stack
+struct Frame
+{
+    int node = ASN1FlatNode::none;
+    ///the position just past the content, or -1 for an indefinite length
+    juce::int64 end = -1;
+    int lastChild = ASN1FlatNode::none;
+    ///true for a BIT STRING or OCTET STRING that is being tried as encapsulated ASN.1
+    bool encapsulated = false;
+    ///the number of nodes in the arena before this container's children were added
+    int rollbackCount = 0;
+};
+} // namespace
+
+bool ASN1Arena::decode(const void* sourceData, size_t numBytes, size_t offset)
+{
+    reset();
+
+    if( sourceData == nullptr || offset >= numBytes )
+        return false;
+
+    data = static_cast<const juce::uint8*>(sourceData);
+
+    //every node owns at least a tag byte and a length byte, so this is the only allocation needed
+    reserve((numBytes - offset) / 2 + 1);
+
+    Frame stack[maxDepth];
+    int depth = 0;
+    auto pos = static_cast<juce::int64>(offset);
+    DERHeader header;
+
+    /*
+     reads the node at 'pos', links it into the innermost open container
+     and either opens it as a container or skips over its content.
+     */
+    auto decodeNode = [&]() -> bool
+    {
+        if( ! DERHeader::read(data, numBytes, static_cast<size_t>(pos), header) )
+            return false;
+
+        auto parent = depth > 0 ? stack[depth - 1].node : ASN1FlatNode::none;
+        auto previousSibling = depth > 0 ? stack[depth - 1].lastChild : ASN1FlatNode::none;
+        auto index = appendNode(header, pos, parent, previousSibling);
+        if( depth > 0 )
+            stack[depth - 1].lastChild = index;
+
+        auto contentStart = pos + header.header;
+        const auto& tag = header.tag;
+
+        // sometimes BitString and OctetString are used to encapsulate ASN.1
+        auto isBitString = tag.isUniversal() && ! tag.tagConstructed && tag.tagNumber == 0x03;
+        auto isOctetString = tag.isUniversal() && ! tag.tagConstructed && tag.tagNumber == 0x04;
+        auto canEncapsulate = ! header.isIndefinite()
+                              && ((isBitString && header.length > 2 && data[contentStart] == 0)
+                                  || (isOctetString && header.length > 1));
+
+        if( tag.tagConstructed || canEncapsulate )
+        {
+            if( depth == maxDepth )
+                return false;
+
+            Frame frame;
+            frame.node = index;
+            frame.end = header.isIndefinite() ? -1 : contentStart + header.length;
+            frame.encapsulated = ! tag.tagConstructed;
+            frame.rollbackCount = numNodes;
+            stack[depth++] = frame;
+
+            pos = contentStart + (isBitString ? 1 : 0);
+            return true;
+        }
+
+        if( header.isIndefinite() )
+        {
+            // JS: throw "We can't skip over an invalid tag with undefined length at offset " + start;
+            return false;
+        }
+
+        pos = contentStart + header.length;
+        return true;
+    };
+
+    if( ! decodeNode() )
+    {
+        reset();
+        return false;
+    }
+
+    while( depth > 0 )
+    {
+        auto& top = stack[depth - 1];
+        auto ok = true;
+
+        if( top.end >= 0 )
+        {
+            if( pos == top.end )
+            {
+                --depth;
+                continue;
+            }
+
+            ok = pos < top.end && decodeNode();
+
+            if( ok && top.encapsulated && nodes[numNodes - 1].tag.isEOC() )
+            {
+                //JS: throw 'EOC is not supposed to be actual content.';
+                ok = false;
+            }
+        }
+        else
+        {
+            // undefined length: the container ends at the end-of-contents octets
+            if( static_cast<size_t>(pos) + 2 <= numBytes && data[pos] == 0 && data[pos + 1] == 0 )
+            {
+                pos += 2;
+                auto& node = nodes[top.node];
+                node.length = pos - (node.offset + node.header);
+                --depth;
+                continue;
+            }
+
+            ok = decodeNode();
+        }
+
+        if( ! ok )
+        {
+            /*
+             the content didn't decode.
+             if we're inside a BIT STRING or OCTET STRING that was only being tried as encapsulated ASN.1,
+             throw its children away and keep it as a primitive node.
+             */
+            while( depth > 0 && ! stack[depth - 1].encapsulated )
+                --depth;
+
+            if( depth == 0 )
+            {
+                reset();
+                return false;
+            }
+
+            const auto& frame = stack[--depth];
+            numNodes = frame.rollbackCount;
+            auto& node = nodes[frame.node];
+            node.firstChild = ASN1FlatNode::none;
+            node.numChildren = 0;
+            pos = node.offset + node.header + node.length;
+        }
+    }
+
+    return true;
+}
+
+void ASN1Arena::reset() noexcept
+{
+    numNodes = 0;
+    data = nullptr;
+}
+
+void ASN1Arena::reserve(size_t numNodesToAllocate)
+{
+    if( numNodesToAllocate <= capacity )
+        return;
+
+    nodes.realloc(numNodesToAllocate);
+    capacity = numNodesToAllocate;
+}
+
+int ASN1Arena::getChild(int parent, int n) const noexcept
+{
+    auto child = (*this)[parent].firstChild;
+    while( child != ASN1FlatNode::none && n-- > 0 )
+        child = nodes[child].nextSibling;
+
+    return child;
+}
+
+int ASN1Arena::appendNode(const DERHeader& header, juce::int64 offset, int parent, int previousSibling)
+{
+    jassert(static_cast<size_t>(numNodes) < capacity);
+
+    auto index = numNodes++;
+    auto& node = nodes[index];
+    node = ASN1FlatNode();
+    node.tag = header.tag;
+    node.offset = offset;
+    node.header = header.header;
+    node.length = header.length;
+    node.parent = parent;
+
+    if( parent != ASN1FlatNode::none )
+    {
+        if( previousSibling == ASN1FlatNode::none )
+            nodes[parent].firstChild = index;
+        else
+            nodes[previousSibling].nextSibling = index;
+
+        ++nodes[parent].numChildren;
+    }
+
+    return index;
+}
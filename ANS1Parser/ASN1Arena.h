@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    ASN1Arena.h
+    Created: 17 Oct 2026 9:02:11am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ASN1Decoder.h"
+
+/**
+ A node of a flat DER tree.
+ Nodes are linked by index into the ASN1Arena that owns them instead of by pointer.
+ */
+struct ASN1FlatNode
+{
+    static constexpr int none = -1;
+
+    ASN1Tag tag { 0, false, 0 };
+    ///the position of the first tag byte
+    juce::int64 offset = 0;
+    juce::int64 header = 0;
+    ///the number of content bytes.  for indefinite-length nodes this includes the end-of-contents octets
+    juce::int64 length = 0;
+
+    int parent = none;
+    int firstChild = none;
+    int nextSibling = none;
+    int numChildren = 0;
+};
+
+/**
+ Decodes DER into one contiguous array of ASN1FlatNodes without recursion.
+
+ The arena keeps its storage between parses, so once it has grown to fit the largest
+ input it has seen, decoding performs no allocations at all.
+ The arena does not copy the DER: the data passed to decode() must outlive any use of the nodes.
+ e.g.:
+ @code
+ ASN1Arena arena;
+ if( arena.decode(der.getData(), der.getSize()) )
+ {
+     for( auto i = arena.getRoot().firstChild; i != ASN1FlatNode::none; i = arena[i].nextSibling )
+         DBG( arena[i].tag.tagNumber );
+ }
+ @endcode
+ */
+struct ASN1Arena
+{
+    ///containers nested deeper than this are rejected
+    static constexpr int maxDepth = 32;
+
+    ASN1Arena() = default;
+
+    /**
+     Replaces the contents of the arena with the tree starting at 'offset'.
+     BIT STRINGs and OCTET STRINGs are treated as encapsulated ASN.1 when their content decodes cleanly,
+     the same way ASN1Decoder::decode does.
+     Returns false if the data is not valid DER, in which case the arena is left empty.
+     */
+    bool decode(const void* data, size_t numBytes, size_t offset = 0);
+
+    ///removes all nodes but keeps the storage for the next decode()
+    void reset() noexcept;
+
+    ///grows the storage so that it can hold 'numNodesToAllocate' nodes
+    void reserve(size_t numNodesToAllocate);
+
+    int size() const noexcept { return numNodes; }
+    bool isEmpty() const noexcept { return numNodes == 0; }
+
+    const ASN1FlatNode& operator[](int index) const noexcept
+    {
+        jassert(juce::isPositiveAndBelow(index, numNodes));
+        return nodes[index];
+    }
+
+    const ASN1FlatNode& getRoot() const noexcept { return (*this)[0]; }
+
+    ///returns the index of the n'th child of 'parent', or ASN1FlatNode::none
+    int getChild(int parent, int n) const noexcept;
+
+    ///returns a pointer to the first content byte of a node
+    const juce::uint8* getContent(int index) const noexcept
+    {
+        const auto& node = (*this)[index];
+        return data + node.offset + node.header;
+    }
+
+    const juce::uint8* getData() const noexcept { return data; }
+private:
+    juce::HeapBlock<ASN1FlatNode> nodes;
+    size_t capacity = 0;
+    int numNodes = 0;
+    const juce::uint8* data = nullptr;
+
+    int appendNode(const DERHeader& header, juce::int64 offset, int parent, int previousSibling);
+
+    JUCE_DECLARE_NON_COPYABLE(ASN1Arena)
+};
@@ -9,6 +9,34 @@
 */
 
 #include "ASN1Decoder.h"
+#include "PEMInstrumentation.h"
+
+#if PEM_INSTRUMENTATION
+namespace
+{
+void countNodes(const ASN1& node, int depth, juce::int64& numNodes, int& maxDepth)
+{
+    ++numNodes;
+    maxDepth = juce::jmax(maxDepth, depth);
+    
+    for( const auto& child : node.sub )
+        countNodes(*child, depth + 1, numNodes, maxDepth);
+}
+
+///counted after the tree is built, so decodeNode() itself isn't slowed down
+void recordDecode(const ASN1::Ptr& asn1, juce::int64 numBytesScanned)
+{
+    juce::int64 numNodes = 0;
+    int maxDepth = 0;
+    if( asn1 != nullptr )
+        countNodes(*asn1, 1, numNodes, maxDepth);
+    
+    PEMInstrumentation::addToCounter(PEMInstrumentation::Counter::asn1NodesDecoded, numNodes);
+    PEMInstrumentation::addToCounter(PEMInstrumentation::Counter::asn1BytesScanned, numBytesScanned);
+    PEMInstrumentation::recordASN1Depth(maxDepth);
+}
+} // namespace
+#endif
 
 ASN1Tag::ASN1Tag(juce::InputStream* stream)
 {
@@ -32,6 +60,14 @@ ASN1Tag::ASN1Tag(juce::InputStream* stream)
     }
 }
 
+ASN1Tag::ASN1Tag(int tagClass_, bool tagConstructed_, juce::int64 tagNumber_) :
+tagClass(tagClass_),
+tagConstructed(tagConstructed_),
+tagNumber(tagNumber_)
+{
+    
+}
+
 bool ASN1Tag::isEOC() const
 {
     return tagClass == 0x00 && tagNumber == 0x00;
@@ -41,6 +77,65 @@ bool ASN1Tag::isUniversal() const
 {
     return tagClass == 0x00;
 }
+//==============================================================================
+bool DERHeader::read(const juce::uint8* data, size_t numBytes, size_t position, DERHeader& result)
+{
+    auto pos = position;
+    if( pos >= numBytes )
+        return false;
+    
+    auto buf = data[pos++];
+    result.tag = ASN1Tag(buf >> 6, (buf & 0x20) != 0, buf & 0x1f);
+    if( result.tag.tagNumber == 0x1f ) //long tag
+    {
+        juce::int64 n = 0;
+        do
+        {
+            if( pos >= numBytes || pos - position > 8 )
+                return false;
+            
+            buf = data[pos++];
+            n = (n << 7) | (buf & 0x7f);
+        }
+        while( buf & 0x80 );
+        result.tag.tagNumber = n;
+    }
+    result.tagLen = static_cast<juce::int64>(pos - position);
+    
+    if( pos >= numBytes )
+        return false;
+    
+    //same rules as ASN1Decoder::decodeLength
+    juce::uint64 len = data[pos++];
+    if( len == 0x80 )
+    {
+        result.length = -1;
+    }
+    else if( len & 0x80 )
+    {
+        auto numLengthBytes = len & 0x7f;
+        if( numLengthBytes > 6 || pos + numLengthBytes > numBytes )
+            return false;
+        
+        len = 0;
+        for( juce::uint64 i = 0; i < numLengthBytes; ++i )
+            len = (len << 8) | data[pos++];
+        
+        result.length = static_cast<juce::int64>(len);
+    }
+    else
+    {
+        result.length = static_cast<juce::int64>(len);
+    }
+    
+    result.header = static_cast<juce::int64>(pos - position);
+    
+    if( result.length >= 0 && static_cast<juce::uint64>(result.length) > numBytes - pos )
+        return false;
+    
+    return true;
+}
+
 //==============================================================================
 //ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L494
 juce::int64 ASN1Decoder::decodeLength(juce::InputStream& stream)
@@ -71,16 +166,49 @@ juce::int64 ASN1Decoder::decodeLength(juce::InputStream& stream)
     return buf;
 }
 
-//ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L528
 ASN1::Ptr ASN1Decoder::decode(juce::MemoryInputStream& stream, int offset)
 {
-    auto streamStart = std::make_unique<juce::MemoryInputStream>(stream.getData(), stream.getDataSize(), true);
-    streamStart->setPosition(stream.getPosition());
+    juce::ignoreUnused(offset);
+    PEM_INSTRUMENT_STAGE(asn1Decode);
+    
+    DERBuffer::Ptr buffer = new DERBuffer(stream.getData(), stream.getDataSize());
+    juce::MemoryInputStream view(buffer->getData(), buffer->getSize(), false);
+    view.setPosition(stream.getPosition());
+    
+    auto asn1 = decodeNode(buffer, view);
+   #if PEM_INSTRUMENTATION
+    recordDecode(asn1, view.getPosition() - stream.getPosition());
+   #endif
+    stream.setPosition(view.getPosition());
+    
+    return asn1;
+}
+
+ASN1::Ptr ASN1Decoder::decode(DERBuffer::Ptr buffer, juce::int64 offset)
+{
+    jassert(buffer != nullptr);
+    PEM_INSTRUMENT_STAGE(asn1Decode);
+    
+    juce::MemoryInputStream view(buffer->getData(), buffer->getSize(), false);
+    view.setPosition(offset);
+    
+    auto asn1 = decodeNode(buffer, view);
+   #if PEM_INSTRUMENTATION
+    recordDecode(asn1, view.getPosition() - offset);
+   #endif
+    
+    return asn1;
+}
+
+//ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L528
+ASN1::Ptr ASN1Decoder::decodeNode(const DERBuffer::Ptr& buffer, juce::MemoryInputStream& stream)
+{
+    auto nodeStart = stream.getPosition();
     auto tag = ASN1Tag(&stream);
-    auto tagLen = stream.getPosition() - streamStart->getPosition();
+    auto tagLen = stream.getPosition() - nodeStart;
     auto len = decodeLength(stream);
     auto start = stream.getPosition();
-    auto header = start - streamStart->getPosition();
+    auto header = start - nodeStart;
     auto sub = std::vector<ASN1::Ptr>();
     
     auto getSub = [&]()
@@ -97,7 +225,7 @@ ASN1::Ptr ASN1Decoder::decode(juce::MemoryInputStream& stream, int offset)
             
             while( stream.getPosition() < end )
             {
-                sub.push_back(decode(stream));
+                sub.push_back(decodeNode(buffer, stream));
             }
             
             if( stream.getPosition() != end )
@@ -112,7 +240,7 @@ ASN1::Ptr ASN1Decoder::decode(juce::MemoryInputStream& stream, int offset)
             // undefined length
             for (;;)
             {
-                auto s = decode(stream);
+                auto s = decodeNode(buffer, stream);
                 if( s == nullptr )
                 {
                     jassertfalse;
@@ -168,5 +296,5 @@ ASN1::Ptr ASN1Decoder::decode(juce::MemoryInputStream& stream, int offset)
         stream.setPosition(start + std::abs(len));
     }
     
-    return new ASN1(std::move(streamStart), header, len, tag, tagLen, sub);
+    return new ASN1(buffer, nodeStart, header, len, tag, tagLen, std::move(sub));
 }
@@ -63,31 +63,71 @@ struct ASN1Tag
     juce::int64 tagNumber = 0;
     
     ASN1Tag(juce::InputStream* stream = nullptr);
+    ASN1Tag(int tagClass_, bool tagConstructed_, juce::int64 tagNumber_);
     
     bool isEOC() const;
     
     bool isUniversal() const;
 };
 
+/**
+ The tag and length of a single DER node, read straight from memory.
+ Used by the decoders that don't build a tree of ASN1 objects.
+ */
+struct DERHeader
+{
+    ASN1Tag tag { 0, false, 0 };
+    juce::int64 tagLen = 0;
+    ///the number of tag and length bytes
+    juce::int64 header = 0;
+    ///the number of content bytes, or -1 for an indefinite length
+    juce::int64 length = 0;
+    
+    /**
+     Reads the header of the node starting at 'position'.
+     Returns false if the header is malformed or if a definite-length node runs past 'numBytes'.
+     */
+    static bool read(const juce::uint8* data, size_t numBytes, size_t position, DERHeader& result);
+    
+    bool isIndefinite() const { return length < 0; }
+};
+
+/**
+ An immutable, reference-counted block of DER bytes.
+ Every ASN1 node of a decoded tree holds a pointer to the same DERBuffer and
+ refers to its own bytes by offset, so decoding never copies the data per node.
+ */
+struct DERBuffer : juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<DERBuffer>;
+    
+    DERBuffer(const void* data, size_t numBytes) : block(data, numBytes) { }
+    explicit DERBuffer(juce::MemoryBlock&& data) : block(std::move(data)) { }
+    
+    const juce::uint8* getData() const noexcept { return static_cast<const juce::uint8*>(block.getData()); }
+    size_t getSize() const noexcept { return block.getSize(); }
+private:
+    const juce::MemoryBlock block;
+};
+
 //ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L324
 struct ASN1 : juce::ReferenceCountedObject
 {
     using Ptr = juce::ReferenceCountedObjectPtr<ASN1>;
 
     /**
-        The stream to read from.
-     To read the stream, use the 'header' and 'length' members. and read the stream into a juce::MemoryBlock
+        The buffer this node was decoded from.
+     The node occupies the bytes [offset, offset + header + length) of the buffer.
+     To read the node's content, use getContent() and the 'length' member.
      e.g.:
      @code
   
-     ASN1::Ptr sequence = new ASN1(...);
-     juce::MemoryBlock exponentBlock;
-     exponentBlock.setSize(sequence->length);
-     sequence->stream->setPosition(sequence->stream->getPosition() + sequence->header);
-     sequence->stream->read(exponentBlock.getData(), static_cast<int>(sequence->length));
+     ASN1::Ptr sequence = ASN1Decoder::decode(...);
+     juce::MemoryBlock exponentBlock(sequence->getContent(), static_cast<size_t>(sequence->length));
      @endcode
      */
-    std::unique_ptr<juce::MemoryInputStream> stream;
+    DERBuffer::Ptr buffer;
+    juce::int64 offset = 0;
     juce::int64 header = 0;
     juce::int64 length = 0;
     ASN1Tag tag;
@@ -98,34 +138,52 @@ struct ASN1 : juce::ReferenceCountedObject
     
     ASN1() = default;
     
-    ASN1(std::unique_ptr<juce::MemoryInputStream>&& stream_,
+    ASN1(DERBuffer::Ptr buffer_,
+         juce::int64 offset_,
          juce::int64 header_,
          juce::int64 length_,
          ASN1Tag tag_,
          juce::int64 tagLen_,
-         std::vector<Ptr> sub_) :
-    stream(std::move(stream_)),
+         std::vector<Ptr>&& sub_) :
+    buffer(std::move(buffer_)),
+    offset(offset_),
     header(header_),
     length(length_),
     tag(tag_),
     tagLen(tagLen_),
-    sub(sub_)
+    sub(std::move(sub_))
     {
         
     }
+    
+    ///returns a pointer to the first content byte of this node, i.e. just past the tag and length.
+    const juce::uint8* getContent() const noexcept
+    {
+        return buffer->getData() + offset + header;
+    }
 };
 
 struct ASN1Decoder
 {
     /**
     Converts a PEM-formatted public or private key stored in a juce::MemoryInputStream into an ASN1 object.
+    The stream's data is copied once into a DERBuffer that is shared by every node of the returned tree.
     ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L528
      */
     static ASN1::Ptr decode(juce::MemoryInputStream& stream, int offset = 0);
     
+    /**
+    Decodes the node starting at 'offset' in the buffer without copying any data.
+    The returned tree keeps the buffer alive.
+     */
+    static ASN1::Ptr decode(DERBuffer::Ptr buffer, juce::int64 offset = 0);
+    
 private:
     //ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L494
     static juce::int64 decodeLength(juce::InputStream& stream);
     
+    //ported from: https://github.com/lapo-luchini/asn1js/blob/trunk/asn1.js#L528
+    static ASN1::Ptr decodeNode(const DERBuffer::Ptr& buffer, juce::MemoryInputStream& stream);
+    
     ASN1Decoder() = delete;
 };
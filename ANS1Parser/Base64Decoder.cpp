@@ -0,0 +1,317 @@
+/*
+  ==============================================================================
+
+    Base64Decoder.cpp
+    Created: 17 Oct 2026 6:02:37pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "Base64Decoder.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+
+ #if JUCE_GCC || JUCE_CLANG
+  #define BASE64_TARGET(isa) __attribute__((target(isa)))
+ #else
+  #define BASE64_TARGET(isa)
+ #endif
+#endif
+
+namespace
+{
+enum : juce::uint8
+{
+    padding = 64,
+    whitespace = 65,
+    invalid = 66
+};
+
+struct DecodingTable
+{
+    constexpr DecodingTable()
+    {
+        for( auto& value : values )
+            value = invalid;
+
+        for( int i = 0; i < 26; ++i )
+        {
+            values['A' + i] = static_cast<juce::uint8>(i);
+            values['a' + i] = static_cast<juce::uint8>(26 + i);
+        }
+
+        for( int i = 0; i < 10; ++i )
+            values['0' + i] = static_cast<juce::uint8>(52 + i);
+
+        values['+'] = 62;
+        values['/'] = 63;
+        values['='] = padding;
+        values[' '] = values['\t'] = values['\r'] = values['\n'] = whitespace;
+    }
+
+    juce::uint8 values[256] = {};
+};
+
+constexpr DecodingTable decodingTable;
+
+/**
+ Decodes one block of 'blockSize' characters if every one of them is in the base64 alphabet.
+ Returns blockSize if it did, otherwise the number of characters before the first one that isn't,
+ and writes nothing.
+ */
+using BlockDecoder = size_t (*)(const char* text, juce::uint8* dest);
+
+#if JUCE_INTEL
+/*
+ The vectorised lookup is Wojciech Muła and Daniel Lemire's:
+ http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html
+
+ The high and low nibbles of each character index two tables whose entries only
+ share a bit for characters outside the alphabet.  A third table, indexed by the
+ high nibble, holds the offset that turns each character into its 6-bit value;
+ '/' shares its high nibble with '+' and gets its own entry by comparing for it.
+ maddubs/madd then pack four 6-bit values into three bytes per 32-bit lane.
+ */
+BASE64_TARGET("sse4.1")
+size_t decodeBlockSSE41(const char* text, juce::uint8* dest)
+{
+    const auto lutLo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                     0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const auto lutHi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                     0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const auto lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                       0, 0, 0, 0, 0, 0, 0, 0);
+    const auto mask2F = _mm_set1_epi8(0x2F);
+
+    auto str = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text));
+
+    const auto hiNibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask2F);
+    const auto loNibbles = _mm_and_si128(str, mask2F);
+    const auto hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+    const auto lo = _mm_shuffle_epi8(lutLo, loNibbles);
+
+    if( ! _mm_testz_si128(lo, hi) )
+    {
+        auto valid = static_cast<juce::uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())));
+        size_t numValid = 0;
+        while( (valid >> numValid) & 1 )
+            ++numValid;
+
+        return numValid;
+    }
+
+    const auto eq2F = _mm_cmpeq_epi8(str, mask2F);
+    const auto roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+    str = _mm_add_epi8(str, roll);
+
+    const auto mergedPairs = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+    auto packed = _mm_madd_epi16(mergedPairs, _mm_set1_epi32(0x00011000));
+    packed = _mm_shuffle_epi8(packed, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest), packed);
+    auto last = static_cast<juce::uint32>(_mm_extract_epi32(packed, 2));
+    std::memcpy(dest + 8, &last, 4);
+
+    return 16;
+}
+
+BASE64_TARGET("avx2")
+size_t decodeBlockAVX2(const char* text, juce::uint8* dest)
+{
+    const auto lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const auto lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const auto lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                          0, 0, 0, 0, 0, 0, 0, 0,
+                                          0, 16, 19, 4, -65, -65, -71, -71,
+                                          0, 0, 0, 0, 0, 0, 0, 0);
+    const auto mask2F = _mm256_set1_epi8(0x2F);
+
+    auto str = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text));
+
+    const auto hiNibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask2F);
+    const auto loNibbles = _mm256_and_si256(str, mask2F);
+    const auto hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+    const auto lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+
+    if( ! _mm256_testz_si256(lo, hi) )
+    {
+        auto valid = static_cast<juce::uint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())));
+        size_t numValid = 0;
+        while( (valid >> numValid) & 1 )
+            ++numValid;
+
+        return numValid;
+    }
+
+    const auto eq2F = _mm256_cmpeq_epi8(str, mask2F);
+    const auto roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eq2F, hiNibbles));
+    str = _mm256_add_epi8(str, roll);
+
+    const auto mergedPairs = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+    auto packed = _mm256_madd_epi16(mergedPairs, _mm256_set1_epi32(0x00011000));
+    packed = _mm256_shuffle_epi8(packed, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    //gather the two 12-byte halves into the bottom 24 bytes
+    packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm256_castsi256_si128(packed));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(dest + 16), _mm256_extracti128_si256(packed, 1));
+
+    return 32;
+}
+#endif
+} // namespace
+
+//==============================================================================
+Base64Decoder::Implementation Base64Decoder::getBestImplementation()
+{
+   #if JUCE_INTEL
+    static const auto best = juce::SystemStats::hasAVX2()  ? Implementation::avx2
+                           : juce::SystemStats::hasSSE41() ? Implementation::sse41
+                                                            : Implementation::scalar;
+    return best;
+   #else
+    return Implementation::scalar;
+   #endif
+}
+
+bool Base64Decoder::decode(const char* text,
+                           size_t numChars,
+                           juce::uint8* dest,
+                           size_t& numBytesWritten,
+                           Implementation implementation)
+{
+    BlockDecoder decodeBlock = nullptr;
+    size_t blockSize = 0;
+
+   #if JUCE_INTEL
+    if( implementation == Implementation::avx2 )
+    {
+        decodeBlock = decodeBlockAVX2;
+        blockSize = 32;
+    }
+    else if( implementation == Implementation::sse41 )
+    {
+        decodeBlock = decodeBlockSSE41;
+        blockSize = 16;
+    }
+   #else
+    juce::ignoreUnused(implementation);
+   #endif
+
+    auto* out = dest;
+    juce::uint32 accumulator = 0;
+    int numPending = 0;
+    size_t i = 0;
+
+    while( i < numChars )
+    {
+        /*
+         hand whole blocks to the SIMD decoder whenever we're at the start of a quantum.
+         if a block holds whitespace or padding, it tells us how far it got.  the characters
+         up to and including the odd one are then done one at a time, and so is the rest of
+         any quantum they leave unfinished.
+         */
+        auto resumeBlocksAt = numChars;
+        if( decodeBlock != nullptr )
+        {
+            resumeBlocksAt = i;
+            if( numPending == 0 && numChars - i >= blockSize )
+            {
+                auto numValid = decodeBlock(text + i, out);
+                if( numValid == blockSize )
+                {
+                    i += blockSize;
+                    out += blockSize / 4 * 3;
+                    continue;
+                }
+
+                resumeBlocksAt = i + numValid + 1;
+            }
+        }
+
+        for( ; i < numChars; ++i )
+        {
+            auto value = decodingTable.values[static_cast<juce::uint8>(text[i])];
+            if( value < padding )
+            {
+                accumulator = (accumulator << 6) | value;
+                if( ++numPending == 4 )
+                {
+                    out[0] = static_cast<juce::uint8>(accumulator >> 16);
+                    out[1] = static_cast<juce::uint8>(accumulator >> 8);
+                    out[2] = static_cast<juce::uint8>(accumulator);
+                    out += 3;
+                    accumulator = 0;
+                    numPending = 0;
+                }
+            }
+            else if( value == padding )
+            {
+                break;
+            }
+            else if( value != whitespace )
+            {
+                return false;
+            }
+
+            if( numPending == 0 && i + 1 >= resumeBlocksAt )
+            {
+                ++i;
+                break;
+            }
+        }
+
+        if( i < numChars && decodingTable.values[static_cast<juce::uint8>(text[i])] == padding )
+            break;
+    }
+
+    //whatever is left may only be padding and whitespace, and there's at most two of the padding
+    int numPadding = 0;
+    for( ; i < numChars; ++i )
+    {
+        auto value = decodingTable.values[static_cast<juce::uint8>(text[i])];
+        if( value == padding )
+            ++numPadding;
+        else if( value != whitespace )
+            return false;
+    }
+
+    if( numPending == 1 || numPadding > 2 || (numPending == 0 && numPadding > 0) )
+        return false;
+
+    if( numPending == 2 )
+    {
+        out[0] = static_cast<juce::uint8>(accumulator >> 4);
+        out += 1;
+    }
+    else if( numPending == 3 )
+    {
+        out[0] = static_cast<juce::uint8>(accumulator >> 10);
+        out[1] = static_cast<juce::uint8>(accumulator >> 2);
+        out += 2;
+    }
+
+    numBytesWritten = static_cast<size_t>(out - dest);
+    return true;
+}
+
+bool Base64Decoder::decode(const char* text, size_t numChars, juce::MemoryBlock& destination)
+{
+    destination.ensureSize(getMaxDecodedSize(numChars));
+
+    size_t numBytesWritten = 0;
+    if( ! decode(text, numChars, static_cast<juce::uint8*>(destination.getData()), numBytesWritten) )
+        return false;
+
+    destination.setSize(numBytesWritten);
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+  ==============================================================================
+
+    Base64Decoder.h
+    Created: 17 Oct 2026 6:02:37pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Decodes base64 straight into a caller-supplied buffer.
+
+ Whitespace (spaces, tabs, CR and LF) is skipped in the same pass, so a PEM body
+ can be decoded as it is, without joining its lines first.
+ Runs of 32 (AVX2) or 16 (SSE4.1) characters are decoded with SIMD instructions
+ when the CPU has them, everything else one character at a time.
+ Padding is optional, but nothing except whitespace may follow it.
+ */
+struct Base64Decoder
+{
+    enum class Implementation
+    {
+        scalar,
+        sse41,
+        avx2
+    };
+
+    ///the fastest implementation this CPU supports
+    static Implementation getBestImplementation();
+
+    ///the most bytes 'numChars' characters of base64 can decode to
+    static constexpr size_t getMaxDecodedSize(size_t numChars) noexcept { return (numChars + 3) / 4 * 3; }
+
+    /**
+     Decodes 'numChars' characters of base64 into 'dest', which must have room for
+     getMaxDecodedSize(numChars) bytes.
+     Returns false if the text isn't valid base64.  'numBytesWritten' is only set on success.
+     */
+    static bool decode(const char* text,
+                       size_t numChars,
+                       juce::uint8* dest,
+                       size_t& numBytesWritten,
+                       Implementation implementation = getBestImplementation());
+
+    ///decodes into 'destination', reusing the storage it already has
+    static bool decode(const char* text, size_t numChars, juce::MemoryBlock& destination);
+};
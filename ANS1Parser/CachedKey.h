@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    CachedKey.h
+    Created: 18 Oct 2026 10:12:33am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "KeyID.h"
+#include "PEMFormatKey.h"
+
+/**
+ A key that has been loaded and prepared for decrypting.
+ It stays valid for as long as you hold on to it, even after whatever handed it out has let go of it.
+ */
+struct CachedKey : juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<CachedKey>;
+
+    CachedKey(const KeyID& fingerprint_, const KeyID& modulusID_) :
+    fingerprint(fingerprint_),
+    modulusID(modulusID_)
+    {
+
+    }
+
+    const KeyID fingerprint, modulusID;
+    ///loaded before it is handed out, and never modified afterwards
+    PEMFormatKey key;
+};
+
+/**
+ Where a key that is loaded the first time it is asked for is kept.
+
+ The owner keeps its slots, usually as the base of its entries, behind a lock, and calls
+ getOrLoad() to hand them out.  The key is loaded without the lock held, since a private
+ key's checks and precomputation take long enough to stall every other lookup.  Two threads
+ can load the same key at once; the first to finish is kept and the other load is dropped.
+ A load that fails is remembered, so the slot hands out nullptr from then on.
+ */
+struct LazyKeySlot
+{
+    CachedKey::Ptr cached;
+    bool failedToLoad = false;
+
+    /**
+     Returns the slot's key, loading it if it hasn't been tried yet.
+     - getEntry() is called with 'lock' held and returns a pointer to the owner's entry,
+       which derives from LazyKeySlot, or nullptr if there isn't one.  It is called again after
+       a load, in case the owner's entries moved in the meantime.
+     - load(const Entry&) is called without the lock, on a copy of the entry, and returns the
+       loaded CachedKey, or nullptr if the key doesn't load.
+     - used(Entry&, bool justLoaded) is called with the lock held every time a key is handed out.
+     */
+    template <typename GetEntry, typename Load, typename Used>
+    static CachedKey::Ptr getOrLoad(juce::CriticalSection& lock, GetEntry&& getEntry, Load&& load, Used&& used)
+    {
+        using Entry = std::remove_pointer_t<decltype(getEntry())>;
+        static_assert(std::is_base_of<LazyKeySlot, Entry>::value, "the entries must derive from LazyKeySlot");
+
+        Entry unloaded;
+        {
+            const juce::ScopedLock sl(lock);
+
+            auto* entry = getEntry();
+            if( entry == nullptr || entry->failedToLoad )
+                return nullptr;
+
+            if( entry->cached != nullptr )
+            {
+                used(*entry, false);
+                return entry->cached;
+            }
+
+            unloaded = *entry;
+        }
+
+        auto loaded = load(static_cast<const Entry&>(unloaded));
+
+        const juce::ScopedLock sl(lock);
+
+        auto* entry = getEntry();
+        jassert(entry != nullptr);
+
+        if( entry->cached != nullptr )
+        {
+            //another thread loaded it first
+            used(*entry, false);
+            return entry->cached;
+        }
+
+        if( loaded == nullptr )
+        {
+            entry->failedToLoad = true;
+            return nullptr;
+        }
+
+        entry->cached = loaded;
+        used(*entry, true);
+        return loaded;
+    }
+
+    ///the same, for an owner with nothing to do when a key is handed out
+    template <typename GetEntry, typename Load>
+    static CachedKey::Ptr getOrLoad(juce::CriticalSection& lock, GetEntry&& getEntry, Load&& load)
+    {
+        return getOrLoad(lock, std::forward<GetEntry>(getEntry), std::forward<Load>(load), [](auto&, bool) {});
+    }
+};
@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    DERCursor.cpp
+    Created: 17 Oct 2026 10:41:37am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "DERCursor.h"
+
+namespace
+{
+bool isEndOfContents(const juce::uint8* data, size_t limit, size_t pos)
+{
+    return pos + 2 <= limit && data[pos] == 0 && data[pos + 1] == 0;
+}
+} // namespace
+
+DERCursor::DERCursor(const void* data_, size_t numBytes, size_t offset_) :
+DERCursor(static_cast<const juce::uint8*>(data_), numBytes, offset_, false)
+{
+
+}
+
+DERCursor::DERCursor(const juce::uint8* data_, size_t limit_, size_t offset_, bool inIndefinite_) :
+limit(limit_),
+offset(offset_),
+inIndefinite(inIndefinite_)
+{
+    if( data_ != nullptr && DERHeader::read(data_, limit, offset, header) )
+        data = data_;
+}
+
+size_t DERCursor::getEnd() const noexcept
+{
+    if( ! isValid() )
+        return 0;
+
+    auto pos = offset + static_cast<size_t>(header.header);
+    if( ! header.isIndefinite() )
+        return pos + static_cast<size_t>(header.length);
+
+    //walk the nested headers until the matching end-of-contents octets
+    int depth = 1;
+    DERHeader child;
+    while( depth > 0 )
+    {
+        if( isEndOfContents(data, limit, pos) )
+        {
+            pos += 2;
+            --depth;
+            continue;
+        }
+
+        if( ! DERHeader::read(data, limit, pos, child) )
+            return 0;
+
+        pos += static_cast<size_t>(child.header);
+        if( child.isIndefinite() )
+        {
+            if( ! child.tag.tagConstructed )
+                return 0;
+
+            ++depth;
+        }
+        else
+        {
+            pos += static_cast<size_t>(child.length);
+        }
+    }
+
+    return pos;
+}
+
+DERCursor DERCursor::getNextSibling() const
+{
+    auto end = getEnd();
+    if( end == 0 || end >= limit )
+        return {};
+
+    if( inIndefinite && isEndOfContents(data, limit, end) )
+        return {};
+
+    return DERCursor(data, limit, end, inIndefinite);
+}
+
+DERCursor DERCursor::getFirstInRegion(size_t start, size_t end, bool indefinite) const
+{
+    if( start >= end || (indefinite && isEndOfContents(data, end, start)) )
+        return {};
+
+    return DERCursor(data, end, start, indefinite);
+}
+
+DERCursor DERCursor::getChild(int index) const
+{
+    if( ! isValid() || ! header.tag.tagConstructed )
+        return {};
+
+    auto start = offset + static_cast<size_t>(header.header);
+    auto child = header.isIndefinite() ? getFirstInRegion(start, limit, true)
+                                       : getFirstInRegion(start, start + static_cast<size_t>(header.length), false);
+
+    while( child.isValid() && index-- > 0 )
+        child = child.getNextSibling();
+
+    return child;
+}
+
+bool DERCursor::getEncapsulatedRegion(size_t& start, size_t& end) const
+{
+    // sometimes BitString and OctetString are used to encapsulate ASN.1
+    if( ! isValid() || header.tag.tagConstructed || header.isIndefinite() || ! header.tag.isUniversal() )
+        return false;
+
+    start = offset + static_cast<size_t>(header.header);
+    end = start + static_cast<size_t>(header.length);
+
+    if( header.tag.tagNumber == 0x03 )
+    {
+        //BIT STRINGs with unused bits cannot encapsulate.
+        if( start == end || data[start] != 0 )
+            return false;
+
+        ++start;
+        return true;
+    }
+
+    return header.tag.tagNumber == 0x04;
+}
+
+DERCursor DERCursor::getEncapsulated(int index) const
+{
+    size_t start, end;
+    if( ! getEncapsulatedRegion(start, end) )
+        return {};
+
+    auto node = getFirstInRegion(start, end, false);
+    while( node.isValid() && index-- > 0 )
+        node = node.getNextSibling();
+
+    return node;
+}
+
+int DERCursor::countRegion(const DERCursor& first)
+{
+    int count = 0;
+    for( auto node = first; node.isValid(); node = node.getNextSibling() )
+    {
+        ++count;
+
+        //the region must be tiled exactly by well-formed nodes
+        auto end = node.getEnd();
+        if( end == 0 || end > node.limit )
+            return -1;
+
+        if( end < node.limit && ! (node.inIndefinite && isEndOfContents(node.data, node.limit, end)) )
+        {
+            DERHeader next;
+            if( ! DERHeader::read(node.data, node.limit, end, next) )
+                return -1;
+        }
+    }
+
+    return count;
+}
+
+int DERCursor::getNumChildren() const
+{
+    if( ! isValid() || ! header.tag.tagConstructed )
+        return -1;
+
+    auto first = getChild(0);
+    if( ! first.isValid() )
+    {
+        auto start = offset + static_cast<size_t>(header.header);
+        auto isEmpty = header.isIndefinite() ? isEndOfContents(data, limit, start) : header.length == 0;
+        return isEmpty ? 0 : -1;
+    }
+
+    return countRegion(first);
+}
+
+int DERCursor::getNumEncapsulated() const
+{
+    size_t start, end;
+    if( ! getEncapsulatedRegion(start, end) )
+        return -1;
+
+    auto first = getFirstInRegion(start, end, false);
+    if( ! first.isValid() )
+        return start == end ? 0 : -1;
+
+    return countRegion(first);
+}
+
+DERCursor DERCursor::find(std::initializer_list<int> path) const
+{
+    auto node = *this;
+    auto enterEncapsulated = false;
+
+    for( auto step : path )
+    {
+        if( ! node.isValid() )
+            break;
+
+        if( step == encapsulated )
+        {
+            enterEncapsulated = true;
+            continue;
+        }
+
+        node = enterEncapsulated ? node.getEncapsulated(step) : node.getChild(step);
+        enterEncapsulated = false;
+    }
+
+    //a path can't end with 'encapsulated'
+    jassert(! enterEncapsulated);
+    return enterEncapsulated ? DERCursor() : node;
+}
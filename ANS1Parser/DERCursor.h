@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    DERCursor.h
+    Created: 17 Oct 2026 10:41:37am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ASN1Decoder.h"
+
+/**
+ A lazy, read-only view of one node in a block of DER.
+
+ Moving a cursor only decodes the headers of the nodes it passes over.
+ The content of every other node is skipped using its length, so
+ picking a few nodes out of a large structure touches very few bytes.
+
+ The cursor does not own the data: the buffer must outlive it.
+ e.g. the RSAPublicKey inside a SubjectPublicKeyInfo:
+ @code
+ DERCursor spki(der.getData(), der.getSize());
+ auto rsaPublicKey = spki.find({ 1, DERCursor::encapsulated, 0 });
+ auto modulus = rsaPublicKey.getChild(0);
+ @endcode
+ */
+struct DERCursor
+{
+    ///a step for find() that enters the content of a BIT STRING or OCTET STRING
+    static constexpr int encapsulated = -1;
+
+    ///creates an invalid cursor
+    DERCursor() = default;
+
+    ///creates a cursor for the node starting at 'offset'
+    DERCursor(const void* data, size_t numBytes, size_t offset = 0);
+
+    bool isValid() const noexcept { return data != nullptr; }
+
+    const ASN1Tag& getTag() const noexcept { return header.tag; }
+    const DERHeader& getHeader() const noexcept { return header; }
+
+    ///returns true if this is a valid node with the given universal tag number
+    bool isUniversal(juce::int64 tagNumber) const noexcept
+    {
+        return isValid() && header.tag.isUniversal() && header.tag.tagNumber == tagNumber;
+    }
+
+    ///the position of the node's first tag byte within the buffer
+    size_t getOffset() const noexcept { return offset; }
+    const juce::uint8* getContent() const noexcept { return data + offset + static_cast<size_t>(header.header); }
+    ///the number of content bytes, or -1 for an indefinite-length node
+    juce::int64 getContentLength() const noexcept { return header.length; }
+
+    ///the position just past the end of this node, or 0 if the node is malformed
+    size_t getEnd() const noexcept;
+
+    ///returns the node that follows this one in the same container, or an invalid cursor
+    DERCursor getNextSibling() const;
+
+    ///returns the n'th child of a constructed node, or an invalid cursor
+    DERCursor getChild(int index) const;
+
+    /**
+     Returns the n'th node encapsulated in the content of a BIT STRING or OCTET STRING,
+     or an invalid cursor if the content isn't ASN.1.
+     */
+    DERCursor getEncapsulated(int index = 0) const;
+
+    ///counts the children of a constructed node by skipping over them. returns -1 if they are malformed
+    int getNumChildren() const;
+
+    ///counts the nodes encapsulated in a BIT STRING or OCTET STRING. returns -1 if the content isn't ASN.1
+    int getNumEncapsulated() const;
+
+    /**
+     Follows a path of child indices from this node.
+     Use DERCursor::encapsulated as a step to enter a BIT STRING or OCTET STRING,
+     e.g. find({ 2, DERCursor::encapsulated, 0 }) is getChild(2).getEncapsulated(0).
+     */
+    DERCursor find(std::initializer_list<int> path) const;
+private:
+    const juce::uint8* data = nullptr;
+    ///the end of the region this node lives in
+    size_t limit = 0;
+    size_t offset = 0;
+    ///true if the region is the content of an indefinite-length container that ends with end-of-contents octets
+    bool inIndefinite = false;
+    DERHeader header;
+
+    DERCursor(const juce::uint8* data, size_t limit, size_t offset, bool inIndefinite);
+
+    ///returns a cursor for the first node of a region, or an invalid cursor if the region is empty
+    DERCursor getFirstInRegion(size_t start, size_t end, bool indefinite) const;
+
+    bool getEncapsulatedRegion(size_t& start, size_t& end) const;
+
+    static int countRegion(const DERCursor& first);
+};
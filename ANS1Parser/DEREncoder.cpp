@@ -0,0 +1,222 @@
+/*
+  ==============================================================================
+
+    DEREncoder.cpp
+    Created: 17 Oct 2026 8:12:49pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "DEREncoder.h"
+#include "PEMHelpers.h"
+#include "ObjectIdentifier.h"
+
+#include <array>
+
+namespace
+{
+///AlgorithmIdentifier ::= SEQUENCE { rsaEncryption OBJECT IDENTIFIER, NULL }
+constexpr auto makeRSAAlgorithmIdentifier()
+{
+    constexpr auto numOIDBytes = KnownOIDs::rsaEncryption.getNumBytes();
+    std::array<juce::uint8, 2 + 2 + numOIDBytes + 2> bytes {};
+
+    bytes[0] = DEREncoder::sequence;
+    bytes[1] = static_cast<juce::uint8>(bytes.size() - 2);
+    bytes[2] = DEREncoder::objectIdentifier;
+    bytes[3] = static_cast<juce::uint8>(numOIDBytes);
+
+    for( size_t i = 0; i < numOIDBytes; ++i )
+        bytes[4 + i] = KnownOIDs::rsaEncryption.getBytes()[i];
+
+    bytes[4 + numOIDBytes] = DEREncoder::null;
+    bytes[5 + numOIDBytes] = 0x00;
+    return bytes;
+}
+
+constexpr auto rsaAlgorithmIdentifier = makeRSAAlgorithmIdentifier();
+
+///everything inside an RSAPrivateKey's SEQUENCE: the version, then the eight integers
+size_t getRSAPrivateKeyContentLength(const DEREncoder::RSAPrivateKeyParts& key)
+{
+    size_t length = 3;
+    for( auto value : { &key.modulus, &key.publicExponent, &key.privateExponent, &key.prime1,
+                        &key.prime2, &key.exponent1, &key.exponent2, &key.coefficient } )
+    {
+        length += DEREncoder::getIntegerSize(*value);
+    }
+
+    return length;
+}
+} // namespace
+
+size_t DEREncoder::getHeaderSize(size_t contentLength) noexcept
+{
+    if( contentLength < 0x80 )
+        return 2;
+
+    size_t numLengthBytes = 0;
+    for( auto length = contentLength; length != 0; length >>= 8 )
+        ++numLengthBytes;
+
+    return 2 + numLengthBytes;
+}
+
+size_t DEREncoder::writeHeader(juce::uint8* dest, juce::uint8 tag, size_t contentLength) noexcept
+{
+    dest[0] = tag;
+
+    if( contentLength < 0x80 )
+    {
+        dest[1] = static_cast<juce::uint8>(contentLength);
+        return 2;
+    }
+
+    auto numLengthBytes = getHeaderSize(contentLength) - 2;
+    dest[1] = static_cast<juce::uint8>(0x80 | numLengthBytes);
+    for( size_t i = 0; i < numLengthBytes; ++i )
+        dest[2 + i] = static_cast<juce::uint8>(contentLength >> (8 * (numLengthBytes - 1 - i)));
+
+    return 2 + numLengthBytes;
+}
+
+size_t DEREncoder::getIntegerSize(const juce::BigInteger& value)
+{
+    auto contentLength = PEMHelpers::getNumDERIntegerBytes(value);
+    return getHeaderSize(contentLength) + contentLength;
+}
+
+size_t DEREncoder::writeInteger(juce::uint8* dest, const juce::BigInteger& value)
+{
+    auto contentLength = PEMHelpers::getNumDERIntegerBytes(value);
+    auto headerSize = writeHeader(dest, integer, contentLength);
+    PEMHelpers::writeDERIntegerBytes(value, dest + headerSize);
+
+    return headerSize + contentLength;
+}
+
+size_t DEREncoder::getRSAPublicKeySize(const juce::BigInteger& modulus, const juce::BigInteger& exponent)
+{
+    auto contentLength = getIntegerSize(modulus) + getIntegerSize(exponent);
+    return getHeaderSize(contentLength) + contentLength;
+}
+
+size_t DEREncoder::writeRSAPublicKey(juce::uint8* dest, const juce::BigInteger& modulus, const juce::BigInteger& exponent)
+{
+    //RSAPublicKey ::= SEQUENCE { modulus INTEGER, publicExponent INTEGER }
+    auto start = dest;
+
+    dest += writeHeader(dest, sequence, getIntegerSize(modulus) + getIntegerSize(exponent));
+    dest += writeInteger(dest, modulus);
+    dest += writeInteger(dest, exponent);
+
+    return static_cast<size_t>(dest - start);
+}
+
+size_t DEREncoder::getRSASubjectPublicKeyInfoSize(const juce::BigInteger& modulus, const juce::BigInteger& exponent)
+{
+    auto bitStringLength = 1 + getRSAPublicKeySize(modulus, exponent);
+    auto contentLength = rsaAlgorithmIdentifier.size() + getHeaderSize(bitStringLength) + bitStringLength;
+    return getHeaderSize(contentLength) + contentLength;
+}
+
+size_t DEREncoder::writeRSASubjectPublicKeyInfo(juce::uint8* dest, const juce::BigInteger& modulus, const juce::BigInteger& exponent)
+{
+    /*
+     SEQUENCE
+        SEQUENCE
+            OBJECT IDENTIFIER 1.2.840.113549.1.1.1 (rsaEncryption)
+            NULL
+        BIT STRING (no unused bits)
+            SEQUENCE
+                INTEGER modulus
+                INTEGER exponent
+     */
+    auto start = dest;
+    auto bitStringLength = 1 + getRSAPublicKeySize(modulus, exponent);
+    auto contentLength = rsaAlgorithmIdentifier.size() + getHeaderSize(bitStringLength) + bitStringLength;
+
+    dest += writeHeader(dest, sequence, contentLength);
+    std::memcpy(dest, rsaAlgorithmIdentifier.data(), rsaAlgorithmIdentifier.size());
+    dest += rsaAlgorithmIdentifier.size();
+
+    dest += writeHeader(dest, bitString, bitStringLength);
+    *dest++ = 0; // unused bits
+    dest += writeRSAPublicKey(dest, modulus, exponent);
+
+    return static_cast<size_t>(dest - start);
+}
+
+size_t DEREncoder::getRSAPrivateKeySize(const RSAPrivateKeyParts& key)
+{
+    auto contentLength = getRSAPrivateKeyContentLength(key);
+    return getHeaderSize(contentLength) + contentLength;
+}
+
+size_t DEREncoder::writeRSAPrivateKey(juce::uint8* dest, const RSAPrivateKeyParts& key)
+{
+    /*
+     RSAPrivateKey ::= SEQUENCE { version INTEGER (0), modulus, publicExponent, privateExponent,
+                                  prime1, prime2, exponent1, exponent2, coefficient }
+     */
+    auto start = dest;
+
+    dest += writeHeader(dest, sequence, getRSAPrivateKeyContentLength(key));
+    dest += writeHeader(dest, integer, 1);
+    *dest++ = 0; // version
+
+    for( auto value : { &key.modulus, &key.publicExponent, &key.privateExponent, &key.prime1,
+                        &key.prime2, &key.exponent1, &key.exponent2, &key.coefficient } )
+    {
+        dest += writeInteger(dest, *value);
+    }
+
+    return static_cast<size_t>(dest - start);
+}
+
+size_t DEREncoder::getPKCS8PrivateKeySize(const RSAPrivateKeyParts& key)
+{
+    auto octetStringLength = getRSAPrivateKeySize(key);
+    auto contentLength = 3 + rsaAlgorithmIdentifier.size() + getHeaderSize(octetStringLength) + octetStringLength;
+    return getHeaderSize(contentLength) + contentLength;
+}
+
+size_t DEREncoder::writePKCS8PrivateKey(juce::uint8* dest, const RSAPrivateKeyParts& key)
+{
+    /*
+     SEQUENCE
+        INTEGER 0 (version)
+        SEQUENCE
+            OBJECT IDENTIFIER 1.2.840.113549.1.1.1 (rsaEncryption)
+            NULL
+        OCTET STRING
+            RSAPrivateKey
+     */
+    auto start = dest;
+    auto octetStringLength = getRSAPrivateKeySize(key);
+    auto contentLength = 3 + rsaAlgorithmIdentifier.size() + getHeaderSize(octetStringLength) + octetStringLength;
+
+    dest += writeHeader(dest, sequence, contentLength);
+    dest += writeHeader(dest, integer, 1);
+    *dest++ = 0; // version
+
+    std::memcpy(dest, rsaAlgorithmIdentifier.data(), rsaAlgorithmIdentifier.size());
+    dest += rsaAlgorithmIdentifier.size();
+
+    dest += writeHeader(dest, octetString, octetStringLength);
+    dest += writeRSAPrivateKey(dest, key);
+
+    return static_cast<size_t>(dest - start);
+}
+
+juce::MemoryBlock DEREncoder::encodeRSASubjectPublicKeyInfo(const juce::BigInteger& modulus,
+                                                            const juce::BigInteger& exponent)
+{
+    juce::MemoryBlock result(getRSASubjectPublicKeyInfoSize(modulus, exponent));
+    auto numWritten = writeRSASubjectPublicKeyInfo(static_cast<juce::uint8*>(result.getData()), modulus, exponent);
+
+    jassert(numWritten == result.getSize());
+    juce::ignoreUnused(numWritten);
+    return result;
+}
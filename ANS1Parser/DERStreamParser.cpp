@@ -0,0 +1,433 @@
+/*
+  ==============================================================================
+
+    DERStreamParser.cpp
+    Created: 18 Oct 2026 1:27:03am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "DERStreamParser.h"
+#include "PEMInstrumentation.h"
+
+namespace
+{
+///a tag byte, up to 8 more for the tag number, a length byte and up to 8 more for the length
+constexpr int maxHeaderBytes = 18;
+} // namespace
+
+/**
+ Reads from the stream, keeping count of the position, and copies everything it reads or
+ skips into the capture buffer while a capture is in progress.
+ */
+struct DERStreamParser::Reader
+{
+    explicit Reader(juce::InputStream& stream_) : stream(stream_) { }
+
+    bool read(void* destination, size_t numBytes)
+    {
+        if( ! readFromStream(destination, numBytes) )
+            return false;
+
+        if( capture == nullptr )
+            return true;
+
+        auto* kept = makeRoomToCapture(numBytes);
+        if( kept == nullptr )
+            return false;
+
+        std::memcpy(kept, destination, numBytes);
+        return true;
+    }
+
+    bool skip(juce::int64 numBytes)
+    {
+        if( numBytes <= 0 )
+            return numBytes == 0;
+
+        //a capture needs the bytes, so read them straight into it
+        if( capture != nullptr )
+        {
+            auto* kept = makeRoomToCapture(static_cast<size_t>(numBytes));
+            return kept != nullptr && readFromStream(kept, static_cast<size_t>(numBytes));
+        }
+
+        auto target = stream.getPosition() + numBytes;
+        auto totalLength = stream.getTotalLength();
+        if( totalLength >= 0 && target > totalLength )
+            return false;
+
+        //streams that can't seek read their way forward instead
+        if( ! stream.setPosition(target) )
+            stream.skipNextBytes(numBytes);
+
+        if( stream.getPosition() != target )
+            return false;
+
+        position += numBytes;
+        return true;
+    }
+
+    /**
+     Reads a header with the same rules as DERHeader::read(), except that lengths may have up to 8 bytes.
+     'headerBytes', if not nullptr, gets a copy of the bytes, with room for maxHeaderBytes.
+     */
+    bool readHeader(Node& node, juce::uint8* headerBytes)
+    {
+        node.offset = position;
+        int numHeaderBytes = 0;
+        juce::uint8 byte = 0;
+
+        auto readHeaderByte = [&]()
+        {
+            if( ! read(&byte, 1) )
+                return false;
+
+            if( headerBytes != nullptr )
+                headerBytes[numHeaderBytes] = byte;
+
+            ++numHeaderBytes;
+            return true;
+        };
+
+        if( ! readHeaderByte() )
+            return false;
+
+        node.tag = ASN1Tag(byte >> 6, (byte & 0x20) != 0, byte & 0x1f);
+        if( node.tag.tagNumber == 0x1f ) //long tag
+        {
+            juce::int64 n = 0;
+            do
+            {
+                if( numHeaderBytes > 8 || ! readHeaderByte() )
+                    return false;
+
+                n = (n << 7) | (byte & 0x7f);
+            }
+            while( byte & 0x80 );
+            node.tag.tagNumber = n;
+        }
+
+        if( ! readHeaderByte() )
+            return false;
+
+        if( byte == 0x80 )
+        {
+            node.length = -1;
+        }
+        else if( byte & 0x80 )
+        {
+            auto numLengthBytes = byte & 0x7f;
+            if( numLengthBytes > 8 )
+                return false;
+
+            juce::uint64 length = 0;
+            for( int i = 0; i < numLengthBytes; ++i )
+            {
+                if( ! readHeaderByte() )
+                    return false;
+
+                length = (length << 8) | byte;
+            }
+
+            if( length > static_cast<juce::uint64>(std::numeric_limits<juce::int64>::max()) )
+                return false;
+
+            node.length = static_cast<juce::int64>(length);
+        }
+        else
+        {
+            node.length = byte;
+        }
+
+        node.header = position - node.offset;
+        return true;
+    }
+
+    ///starts copying into 'buffer', beginning with the 'numBytes' header bytes already read
+    void startCapture(juce::MemoryBlock& buffer, size_t maxBytes, const juce::uint8* headerBytes, size_t numBytes)
+    {
+        capture = &buffer;
+        maxCaptureBytes = maxBytes;
+        numCaptured = 0;
+        captureOverflowed = false;
+
+        if( auto* kept = makeRoomToCapture(numBytes) )
+            std::memcpy(kept, headerBytes, numBytes);
+    }
+
+    ///returns the number of bytes captured, or 0 if the capture grew too big
+    size_t stopCapture()
+    {
+        capture = nullptr;
+        return captureOverflowed ? 0 : numCaptured;
+    }
+
+    juce::InputStream& stream;
+    ///the number of bytes read or skipped since the parse started
+    juce::int64 position = 0;
+    juce::int64 numBytesRead = 0;
+    juce::int64 numNodes = 0;
+private:
+    juce::MemoryBlock* capture = nullptr;
+    size_t maxCaptureBytes = 0;
+    size_t numCaptured = 0;
+    bool captureOverflowed = false;
+
+    bool readFromStream(void* destination, size_t numBytes)
+    {
+        auto* bytes = static_cast<char*>(destination);
+        for( size_t done = 0; done < numBytes; )
+        {
+            auto numToRead = static_cast<int>(juce::jmin(numBytes - done, static_cast<size_t>(std::numeric_limits<int>::max())));
+            auto numRead = stream.read(bytes + done, numToRead);
+            if( numRead <= 0 )
+                return false;
+
+            done += static_cast<size_t>(numRead);
+        }
+
+        position += static_cast<juce::int64>(numBytes);
+        numBytesRead += static_cast<juce::int64>(numBytes);
+        return true;
+    }
+
+    ///returns where the next 'numBytes' captured bytes go, or nullptr if they would go over the limit
+    juce::uint8* makeRoomToCapture(size_t numBytes)
+    {
+        if( captureOverflowed || numBytes > maxCaptureBytes - numCaptured )
+        {
+            captureOverflowed = true;
+            return nullptr;
+        }
+
+        if( capture->getSize() < numCaptured + numBytes )
+            capture->ensureSize(juce::jmin(maxCaptureBytes, juce::jmax(numCaptured + numBytes, capture->getSize() * 2)));
+
+        auto* kept = static_cast<juce::uint8*>(capture->getData()) + numCaptured;
+        numCaptured += numBytes;
+        return kept;
+    }
+};
+
+/**
+ The content of a primitive node, as the listener sees it.
+ It can only move forwards, since the bytes before its position have already gone.
+ */
+struct DERStreamParser::ContentStream : juce::InputStream
+{
+    ContentStream(Reader& reader_, juce::int64 length_) :
+    reader(reader_),
+    length(length_)
+    {
+
+    }
+
+    juce::int64 getTotalLength() override { return length; }
+    bool isExhausted() override { return position >= length; }
+    juce::int64 getPosition() override { return position; }
+
+    int read(void* destination, int maxBytesToRead) override
+    {
+        auto numBytes = static_cast<int>(juce::jmin(static_cast<juce::int64>(maxBytesToRead), length - position));
+        if( numBytes <= 0 || failed )
+            return 0;
+
+        if( ! reader.read(destination, static_cast<size_t>(numBytes)) )
+        {
+            failed = true;
+            return 0;
+        }
+
+        position += numBytes;
+        return numBytes;
+    }
+
+    bool setPosition(juce::int64 newPosition) override
+    {
+        if( newPosition < position || newPosition > length || failed )
+            return false;
+
+        if( ! reader.skip(newPosition - position) )
+        {
+            failed = true;
+            return false;
+        }
+
+        position = newPosition;
+        return true;
+    }
+
+    Reader& reader;
+    const juce::int64 length;
+    juce::int64 position = 0;
+    ///true if the input ended before the content did
+    bool failed = false;
+};
+
+//==============================================================================
+DERStreamParser::DERStreamParser() :
+DERStreamParser(Options())
+{
+
+}
+
+DERStreamParser::DERStreamParser(Options options_) :
+options(options_)
+{
+
+}
+
+bool DERStreamParser::parse(juce::InputStream& stream, Listener& listener)
+{
+    Reader reader(stream);
+    auto outcome = Outcome::carryOn;
+
+    for( int index = 0; outcome == Outcome::carryOn && ! stream.isExhausted(); ++index )
+        outcome = parseNode(reader, listener, 0, index, -1);
+
+    PEM_INSTRUMENT_COUNT(asn1NodesDecoded, reader.numNodes);
+    PEM_INSTRUMENT_COUNT(asn1BytesScanned, reader.numBytesRead);
+
+    //an end-of-contents at the top level has no container to end
+    return outcome == Outcome::carryOn || outcome == Outcome::stopped;
+}
+
+DERStreamParser::Outcome DERStreamParser::parseNode(Reader& reader,
+                                                    Listener& listener,
+                                                    int depth,
+                                                    int index,
+                                                    juce::int64 containerEnd)
+{
+    Node node;
+    node.depth = depth;
+    node.index = index;
+
+    juce::uint8 headerBytes[maxHeaderBytes];
+    if( ! reader.readHeader(node, headerBytes) )
+        return Outcome::failed;
+
+    if( node.tag.isEOC() )
+        return ! node.tag.tagConstructed && node.length == 0 ? Outcome::endOfContents : Outcome::failed;
+
+    ++reader.numNodes;
+
+    const auto contentStart = reader.position;
+    if( ! node.isIndefinite() && containerEnd >= 0 && node.length > containerEnd - contentStart )
+        return Outcome::failed;
+
+    if( node.tag.tagConstructed )
+    {
+        switch( listener.start(node) )
+        {
+            case Action::stop:      return Outcome::stopped;
+            case Action::capture:   return capture(reader, listener, node, headerBytes);
+            case Action::skip:      return skipContent(reader, node, depth) ? Outcome::carryOn : Outcome::failed;
+            case Action::enter:     break;
+        }
+
+        if( depth >= options.maxDepth )
+            return Outcome::failed;
+
+        auto outcome = parseChildren(reader, listener, depth + 1, node.isIndefinite() ? -1 : contentStart + node.length);
+        if( outcome != Outcome::carryOn )
+            return outcome;
+
+        return listener.end(node) == Action::stop ? Outcome::stopped : Outcome::carryOn;
+    }
+
+    //only constructed nodes can have an indefinite length
+    if( node.isIndefinite() )
+        return Outcome::failed;
+
+    ContentStream content(reader, node.length);
+    auto action = listener.primitive(node, content);
+
+    if( content.failed )
+        return Outcome::failed;
+
+    if( action == Action::stop )
+        return Outcome::stopped;
+
+    if( content.position == 0 )
+    {
+        if( action == Action::capture )
+            return capture(reader, listener, node, headerBytes);
+
+        if( action == Action::enter && (node.isUniversal(0x03) || node.isUniversal(0x04)) )
+        {
+            if( depth >= options.maxDepth )
+                return Outcome::failed;
+
+            //a BIT STRING that encapsulates DER has no unused bits
+            juce::uint8 numUnusedBits = 0;
+            if( node.isUniversal(0x03) && (node.length == 0 || ! reader.read(&numUnusedBits, 1) || numUnusedBits != 0) )
+                return Outcome::failed;
+
+            auto outcome = parseChildren(reader, listener, depth + 1, contentStart + node.length);
+            if( outcome != Outcome::carryOn )
+                return outcome;
+
+            return listener.end(node) == Action::stop ? Outcome::stopped : Outcome::carryOn;
+        }
+    }
+
+    return reader.skip(content.length - content.position) ? Outcome::carryOn : Outcome::failed;
+}
+
+DERStreamParser::Outcome DERStreamParser::parseChildren(Reader& reader, Listener& listener, int depth, juce::int64 end)
+{
+    for( int index = 0; ; ++index )
+    {
+        if( end >= 0 && reader.position >= end )
+            return reader.position == end ? Outcome::carryOn : Outcome::failed;
+
+        auto outcome = parseNode(reader, listener, depth, index, end);
+
+        //only an indefinite-length container ends with end-of-contents octets
+        if( outcome == Outcome::endOfContents )
+            return end < 0 ? Outcome::carryOn : Outcome::failed;
+
+        if( outcome != Outcome::carryOn )
+            return outcome;
+    }
+}
+
+DERStreamParser::Outcome DERStreamParser::capture(Reader& reader, Listener& listener, const Node& node, const juce::uint8* headerBytes)
+{
+    if( ! node.isIndefinite() && static_cast<juce::uint64>(node.header + node.length) > options.maxCaptureBytes )
+        return Outcome::failed;
+
+    reader.startCapture(captureBuffer, options.maxCaptureBytes, headerBytes, static_cast<size_t>(node.header));
+    auto skipped = skipContent(reader, node, node.depth);
+    auto numBytes = reader.stopCapture();
+
+    if( ! skipped || numBytes == 0 )
+        return Outcome::failed;
+
+    return listener.captured(node, captureBuffer.getData(), numBytes) == Action::stop ? Outcome::stopped : Outcome::carryOn;
+}
+
+bool DERStreamParser::skipContent(Reader& reader, const Node& node, int depth)
+{
+    if( ! node.isIndefinite() )
+        return reader.skip(node.length);
+
+    //walk the nested headers until the matching end-of-contents octets
+    for (;;)
+    {
+        Node child;
+        if( ! reader.readHeader(child, nullptr) )
+            return false;
+
+        if( child.tag.isEOC() )
+            return ! child.tag.tagConstructed && child.length == 0;
+
+        if( depth >= options.maxDepth || (child.isIndefinite() && ! child.tag.tagConstructed) )
+            return false;
+
+        if( ! skipContent(reader, child, depth + 1) )
+            return false;
+    }
+}
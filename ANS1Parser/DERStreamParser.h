@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    DERStreamParser.h
+    Created: 18 Oct 2026 1:27:03am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ASN1Decoder.h"
+
+/**
+ Reads DER (and BER's indefinite lengths) from any juce::InputStream and reports each node to a
+ Listener as it goes, without building a tree or holding the input in memory.
+
+ Only the headers of the open containers are kept, so the memory used depends on how deeply the
+ nodes are nested, not on how big the input is.  The listener decides what happens to each node:
+ go into it, skip it, or capture its whole encoding.  A node that is skipped isn't read at all
+ if the stream can seek, so picking a few keys out of a large bundle of certificates only reads
+ the parts it needs.  Lengths of up to 63 bits are accepted.
+
+ Consecutive top-level nodes are parsed until the stream is exhausted.
+ e.g. the SubjectPublicKeyInfo of each certificate in a file of DER certificates:
+ @code
+ struct KeyFinder : DERStreamParser::Listener
+ {
+     Action start(const DERStreamParser::Node& node) override
+     {
+         //Certificate, then its TBSCertificate
+         if( node.depth == 0 )
+             return Action::enter;
+
+         if( node.depth == 1 )
+         {
+             hasVersion = false;
+             return node.index == 0 ? Action::enter : Action::skip;
+         }
+
+         //the version is an explicit [0] that v1 certificates leave out, so it moves subjectPublicKeyInfo along one
+         if( node.index == 0 && node.tag.tagClass == 2 && node.tag.tagNumber == 0 )
+             hasVersion = true;
+
+         return node.depth == 2 && node.index == (hasVersion ? 6 : 5) ? Action::capture : Action::skip;
+     }
+
+     Action captured(const DERStreamParser::Node&, const void* der, size_t numBytes) override
+     {
+         auto key = std::make_unique<PEMFormatKey>();
+         if( key->loadFromDER(der, numBytes) )
+             keys.add(key.release());
+
+         return Action::skip;
+     }
+
+     juce::OwnedArray<PEMFormatKey> keys;
+     bool hasVersion = false;
+ };
+
+ juce::FileInputStream stream(bundleFile);
+ KeyFinder finder;
+ DERStreamParser().parse(stream, finder);
+ @endcode
+ */
+struct DERStreamParser
+{
+    struct Options
+    {
+        ///the most containers a node can be inside before the input is rejected
+        int maxDepth = 64;
+        ///the largest encoding Action::capture will read into memory
+        size_t maxCaptureBytes = 1 << 20;
+    };
+
+    ///one node, as it is reported to the Listener
+    struct Node
+    {
+        ASN1Tag tag { 0, false, 0 };
+        ///the number of containers the node is inside. top-level nodes are at depth 0
+        int depth = 0;
+        ///the node's position among the other children of its container
+        int index = 0;
+        ///the position of the node's first tag byte, counted from where parse() started
+        juce::int64 offset = 0;
+        ///the number of tag and length bytes
+        juce::int64 header = 0;
+        ///the number of content bytes, or -1 for an indefinite length
+        juce::int64 length = 0;
+
+        bool isIndefinite() const noexcept { return length < 0; }
+
+        ///returns true if the node has the given universal tag number
+        bool isUniversal(juce::int64 tagNumber) const noexcept { return tag.isUniversal() && tag.tagNumber == tagNumber; }
+    };
+
+    enum class Action
+    {
+        enter,      /**< go into the node: the children of a constructed node, or the DER encapsulated in a BIT STRING or OCTET STRING */
+        skip,       /**< pass over the rest of the node without reading it */
+        capture,    /**< read the node's whole encoding, header included, and hand it to Listener::captured() */
+        stop        /**< stop parsing.  parse() returns true */
+    };
+
+    struct Listener
+    {
+        using Action = DERStreamParser::Action;
+
+        virtual ~Listener() = default;
+
+        /**
+         A constructed node starts.
+         If it is entered, its children are reported and then end() is called for it.
+         */
+        virtual Action start(const Node& node) { juce::ignoreUnused(node); return Action::enter; }
+
+        ///a node that was entered has ended. return Action::stop to stop parsing, anything else carries on
+        virtual Action end(const Node& node) { juce::ignoreUnused(node); return Action::skip; }
+
+        /**
+         A primitive node.  'content' reads its content bytes, and whatever isn't read of them is skipped.
+         Entering a BIT STRING or OCTET STRING parses its content as DER: the nodes in it are reported as
+         its children, and then end() is called for it.  Entering or capturing only works if none of the
+         content has been read; otherwise, and for any other primitive node, they skip it.
+         */
+        virtual Action primitive(const Node& node, juce::InputStream& content) { juce::ignoreUnused(node, content); return Action::skip; }
+
+        /**
+         The encoding of a node that was captured.  The bytes are only valid during the call.
+         Return Action::stop to stop parsing, anything else carries on.
+         */
+        virtual Action captured(const Node& node, const void* encoding, size_t numBytes) { juce::ignoreUnused(node, encoding, numBytes); return Action::skip; }
+    };
+
+    DERStreamParser();
+    explicit DERStreamParser(Options options);
+
+    /**
+     Parses the stream from its current position, reporting each node to 'listener'.
+     Returns false if the input is malformed or ends in the middle of a node, if it is nested deeper
+     than Options::maxDepth, or if a capture is larger than Options::maxCaptureBytes.
+     The listener has been told about everything before the point where that was found.
+     Parsers can't be shared between threads, but each can parse any number of streams in turn.
+     */
+    bool parse(juce::InputStream& stream, Listener& listener);
+
+    const Options& getOptions() const noexcept { return options; }
+private:
+    struct Reader;
+    struct ContentStream;
+
+    enum class Outcome
+    {
+        carryOn,
+        endOfContents,
+        stopped,
+        failed
+    };
+
+    const Options options;
+    ///reused by every capture, so repeated captures don't allocate
+    juce::MemoryBlock captureBuffer;
+
+    Outcome parseNode(Reader& reader, Listener& listener, int depth, int index, juce::int64 containerEnd);
+    Outcome parseChildren(Reader& reader, Listener& listener, int depth, juce::int64 end);
+    Outcome capture(Reader& reader, Listener& listener, const Node& node, const juce::uint8* headerBytes);
+    bool skipContent(Reader& reader, const Node& node, int depth);
+
+    JUCE_DECLARE_NON_COPYABLE(DERStreamParser)
+};
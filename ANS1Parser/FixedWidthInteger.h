@@ -0,0 +1,505 @@
+/*
+  ==============================================================================
+
+    FixedWidthInteger.h
+    Created: 17 Oct 2026 4:41:10pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Montgomery.h"
+
+/**
+ An unsigned integer with a width fixed at compile time, stored on the stack.
+
+ Unlike juce::BigInteger nothing in here allocates, and every loop runs over a
+ constant number of limbs, so the compiler can unroll them for the standard key sizes.
+ Limbs are 32-bit, least significant first, like the rest of the Montgomery engine.
+ */
+template <int numBits_>
+struct FixedWidthInteger
+{
+    static_assert(numBits_ > 0 && numBits_ % 32 == 0, "the width must be a whole number of limbs");
+
+    static constexpr int numBits = numBits_;
+    static constexpr int numLimbs = numBits_ / 32;
+
+    juce::uint32 limbs[numLimbs] = {};
+
+    //==============================================================================
+    ///returns false if 'value' is negative or doesn't fit
+    bool fromBigInteger(const juce::BigInteger& value) noexcept
+    {
+        if( value.isNegative() || value.getHighestBit() >= numBits )
+            return false;
+
+        for( int i = 0; i < numLimbs; ++i )
+            limbs[i] = value.getBitRangeAsInt(i * 32, 32);
+
+        return true;
+    }
+
+    juce::BigInteger toBigInteger() const
+    {
+        return MontgomeryArithmetic::toBigInteger(limbs, numLimbs);
+    }
+
+    ///returns false if the value doesn't fit
+    bool fromBigEndianBytes(const void* data, size_t numBytes) noexcept
+    {
+        return MontgomeryArithmetic::fromBigEndianBytes(limbs, numLimbs, data, numBytes);
+    }
+
+    ///returns false if the value doesn't fit in 'numBytes' bytes
+    bool toBigEndianBytes(void* data, size_t numBytes) const noexcept
+    {
+        return MontgomeryArithmetic::toBigEndianBytes(data, numBytes, limbs, numLimbs);
+    }
+
+    //==============================================================================
+    bool isZero() const noexcept
+    {
+        juce::uint32 bits = 0;
+        for( int i = 0; i < numLimbs; ++i )
+            bits |= limbs[i];
+
+        return bits == 0;
+    }
+
+    bool isOne() const noexcept
+    {
+        juce::uint32 bits = limbs[0] ^ 1;
+        for( int i = 1; i < numLimbs; ++i )
+            bits |= limbs[i];
+
+        return bits == 0;
+    }
+
+    bool operator[](int bit) const noexcept
+    {
+        return ((limbs[bit / 32] >> (bit % 32)) & 1) != 0;
+    }
+
+    int getNumSignificantBits() const noexcept
+    {
+        return MontgomeryArithmetic::getNumSignificantBits(limbs, numLimbs);
+    }
+
+    int compare(const FixedWidthInteger& other) const noexcept
+    {
+        for( int i = numLimbs; --i >= 0; )
+        {
+            if( limbs[i] != other.limbs[i] )
+                return limbs[i] < other.limbs[i] ? -1 : 1;
+        }
+
+        return 0;
+    }
+
+    bool operator==(const FixedWidthInteger& other) const noexcept { return compare(other) == 0; }
+    bool operator!=(const FixedWidthInteger& other) const noexcept { return compare(other) != 0; }
+    bool operator<(const FixedWidthInteger& other) const noexcept { return compare(other) < 0; }
+    bool operator>=(const FixedWidthInteger& other) const noexcept { return compare(other) >= 0; }
+
+    //==============================================================================
+    ///this += other, returns the carry
+    juce::uint32 add(const FixedWidthInteger& other) noexcept
+    {
+        juce::uint64 carry = 0;
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            auto x = static_cast<juce::uint64>(limbs[i]) + other.limbs[i] + carry;
+            limbs[i] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+
+        return static_cast<juce::uint32>(carry);
+    }
+
+    ///this -= other, returns the borrow
+    juce::uint32 subtract(const FixedWidthInteger& other) noexcept
+    {
+        juce::uint64 borrow = 0;
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            auto x = static_cast<juce::uint64>(limbs[i]) - other.limbs[i] - borrow;
+            limbs[i] = static_cast<juce::uint32>(x);
+            borrow = (x >> 32) & 1;
+        }
+
+        return static_cast<juce::uint32>(borrow);
+    }
+
+    ///this -= a single limb, returns the borrow
+    juce::uint32 subtract(juce::uint32 value) noexcept
+    {
+        juce::uint64 borrow = value;
+        for( int i = 0; i < numLimbs && borrow != 0; ++i )
+        {
+            auto x = static_cast<juce::uint64>(limbs[i]) - borrow;
+            limbs[i] = static_cast<juce::uint32>(x);
+            borrow = (x >> 32) & 1;
+        }
+
+        return static_cast<juce::uint32>(borrow);
+    }
+
+    ///this <<= 1, returns the bit shifted out of the top
+    juce::uint32 shiftLeftByOne(juce::uint32 bitIn = 0) noexcept
+    {
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            auto bitOut = limbs[i] >> 31;
+            limbs[i] = (limbs[i] << 1) | bitIn;
+            bitIn = bitOut;
+        }
+
+        return bitIn;
+    }
+
+    ///copies a narrower or wider value into this one.  returns false if it doesn't fit
+    template <int otherNumBits>
+    bool assign(const FixedWidthInteger<otherNumBits>& other) noexcept
+    {
+        constexpr auto numOtherLimbs = FixedWidthInteger<otherNumBits>::numLimbs;
+        constexpr auto numCommonLimbs = numLimbs < numOtherLimbs ? numLimbs : numOtherLimbs;
+
+        for( int i = numCommonLimbs; i < numOtherLimbs; ++i )
+        {
+            if( other.limbs[i] != 0 )
+                return false;
+        }
+
+        for( int i = 0; i < numLimbs; ++i )
+            limbs[i] = i < numCommonLimbs ? other.limbs[i] : 0;
+
+        return true;
+    }
+};
+
+//==============================================================================
+/**
+ Arithmetic between fixed-width integers of possibly different widths.
+ */
+struct FixedWidthArithmetic
+{
+    ///returns a * b at full width
+    template <int numBitsA, int numBitsB>
+    static FixedWidthInteger<numBitsA + numBitsB> multiply(const FixedWidthInteger<numBitsA>& a,
+                                                           const FixedWidthInteger<numBitsB>& b) noexcept
+    {
+        constexpr auto numALimbs = FixedWidthInteger<numBitsA>::numLimbs;
+        constexpr auto numBLimbs = FixedWidthInteger<numBitsB>::numLimbs;
+
+        FixedWidthInteger<numBitsA + numBitsB> result;
+        for( int i = 0; i < numBLimbs; ++i )
+        {
+            juce::uint64 carry = 0;
+            const juce::uint64 bi = b.limbs[i];
+            for( int j = 0; j < numALimbs; ++j )
+            {
+                auto x = a.limbs[j] * bi + result.limbs[i + j] + carry;
+                result.limbs[i + j] = static_cast<juce::uint32>(x);
+                carry = x >> 32;
+            }
+
+            result.limbs[i + numALimbs] = static_cast<juce::uint32>(carry);
+        }
+
+        return result;
+    }
+
+    /**
+     returns a mod m, by binary long division.
+     This is meant for checks done once per key, not for anything per-message.
+     'm' must not be zero.
+     */
+    template <int numBitsA, int numBitsM>
+    static FixedWidthInteger<numBitsM> modulo(const FixedWidthInteger<numBitsA>& a,
+                                              const FixedWidthInteger<numBitsM>& m) noexcept
+    {
+        jassert(! m.isZero());
+
+        FixedWidthInteger<numBitsM> remainder;
+        for( int bit = a.getNumSignificantBits(); --bit >= 0; )
+        {
+            /*
+             the remainder is below m before the shift, so after it it's below 2m
+             and one subtraction brings it back.  if a bit falls out of the top,
+             the remainder is certainly bigger than m and the subtraction wraps back into range.
+             */
+            auto overflow = remainder.shiftLeftByOne(a[bit] ? 1 : 0);
+            if( overflow != 0 || remainder >= m )
+                remainder.subtract(m);
+        }
+
+        return remainder;
+    }
+};
+
+//==============================================================================
+/**
+ The Montgomery engine specialised for one width.
+
+ It works like MontgomeryArithmetic, but every number lives on the stack
+ and every loop has a limb count known at compile time.
+ */
+template <int numBits>
+struct FixedWidthMontgomery
+{
+    using Integer = FixedWidthInteger<numBits>;
+    using DoubleInteger = FixedWidthInteger<numBits * 2>;
+    static constexpr int numLimbs = Integer::numLimbs;
+    ///WindowedExponent never picks a window wider than 6 bits
+    static constexpr int maxTableSize = 32;
+
+    FixedWidthMontgomery() = default;
+
+    ///'modulus' must have exactly numLimbs limbs
+    explicit FixedWidthMontgomery(const MontgomeryModulus& modulus) :
+    inverse(modulus.getInverse())
+    {
+        jassert(modulus.getNumLimbs() == numLimbs);
+
+        std::copy(modulus.getLimbs(), modulus.getLimbs() + numLimbs, limbs.limbs);
+        std::copy(modulus.getRSquared(), modulus.getRSquared() + numLimbs, rSquared.limbs);
+        std::copy(modulus.getRCubed(), modulus.getRCubed() + numLimbs, rCubed.limbs);
+    }
+
+    const Integer& getModulus() const noexcept { return limbs; }
+    const Integer& getRSquared() const noexcept { return rSquared; }
+    const Integer& getRCubed() const noexcept { return rCubed; }
+    ///-n^-1 mod 2^32
+    juce::uint32 getInverse() const noexcept { return inverse; }
+
+    ///result = a * b * R^-1 mod n.  'result' may alias 'a' or 'b'
+    void multiply(Integer& result, const Integer& a, const Integer& b) const noexcept
+    {
+        juce::uint32 t[numLimbs + 2] = {};
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            juce::uint64 carry = 0;
+            const juce::uint64 bi = b.limbs[i];
+            for( int j = 0; j < numLimbs; ++j )
+            {
+                auto x = a.limbs[j] * bi + t[j] + carry;
+                t[j] = static_cast<juce::uint32>(x);
+                carry = x >> 32;
+            }
+
+            auto x = t[numLimbs] + carry;
+            t[numLimbs] = static_cast<juce::uint32>(x);
+            t[numLimbs + 1] = static_cast<juce::uint32>(x >> 32);
+
+            const juce::uint64 m = static_cast<juce::uint32>(t[0] * inverse);
+            carry = (m * limbs.limbs[0] + t[0]) >> 32;
+            for( int j = 1; j < numLimbs; ++j )
+            {
+                x = m * limbs.limbs[j] + t[j] + carry;
+                t[j - 1] = static_cast<juce::uint32>(x);
+                carry = x >> 32;
+            }
+
+            x = t[numLimbs] + carry;
+            t[numLimbs - 1] = static_cast<juce::uint32>(x);
+            t[numLimbs] = t[numLimbs + 1] + static_cast<juce::uint32>(x >> 32);
+        }
+
+        subtractModulusIfNeeded(result, t);
+    }
+
+    /**
+     result = a * a * R^-1 mod n.  'result' may alias 'a'.
+     Each product of two different limbs is worked out once and doubled, so this
+     takes about three quarters of the work of multiply(result, a, a).
+     */
+    void square(Integer& result, const Integer& a) const noexcept
+    {
+        DoubleInteger wide;
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            juce::uint64 carry = 0;
+            const juce::uint64 ai = a.limbs[i];
+            for( int j = i + 1; j < numLimbs; ++j )
+            {
+                auto x = ai * a.limbs[j] + wide.limbs[i + j] + carry;
+                wide.limbs[i + j] = static_cast<juce::uint32>(x);
+                carry = x >> 32;
+            }
+
+            wide.limbs[i + numLimbs] = static_cast<juce::uint32>(carry);
+        }
+
+        juce::uint32 shiftedOut = 0;
+        for( auto& limb : wide.limbs )
+        {
+            auto next = limb >> 31;
+            limb = (limb << 1) | shiftedOut;
+            shiftedOut = next;
+        }
+
+        juce::uint64 carry = 0;
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            auto product = static_cast<juce::uint64>(a.limbs[i]) * a.limbs[i];
+
+            auto x = wide.limbs[2 * i] + (product & 0xffffffff) + carry;
+            wide.limbs[2 * i] = static_cast<juce::uint32>(x);
+
+            x = wide.limbs[2 * i + 1] + (product >> 32) + (x >> 32);
+            wide.limbs[2 * i + 1] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+
+        reduce(result, wide);
+    }
+
+    ///result = t * R^-1 mod n, for t below n * R
+    void reduce(Integer& result, const DoubleInteger& input) const noexcept
+    {
+        juce::uint32 t[numLimbs * 2 + 1];
+        std::copy(input.limbs, input.limbs + numLimbs * 2, t);
+        t[numLimbs * 2] = 0;
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            const juce::uint64 m = static_cast<juce::uint32>(t[i] * inverse);
+            juce::uint64 carry = 0;
+            for( int j = 0; j < numLimbs; ++j )
+            {
+                auto x = m * limbs.limbs[j] + t[i + j] + carry;
+                t[i + j] = static_cast<juce::uint32>(x);
+                carry = x >> 32;
+            }
+
+            for( int k = i + numLimbs; carry != 0 && k <= numLimbs * 2; ++k )
+            {
+                auto x = t[k] + carry;
+                t[k] = static_cast<juce::uint32>(x);
+                carry = x >> 32;
+            }
+        }
+
+        subtractModulusIfNeeded(result, t + numLimbs);
+    }
+
+    void toMontgomery(Integer& result, const Integer& a) const noexcept
+    {
+        multiply(result, a, rSquared);
+    }
+
+    void fromMontgomery(Integer& result, const Integer& a) const noexcept
+    {
+        DoubleInteger wide;
+        std::copy(a.limbs, a.limbs + numLimbs, wide.limbs);
+        reduce(result, wide);
+    }
+
+    ///result = base^exponent, with 'base' and 'result' in Montgomery form
+    void exponentiate(Integer& result, const Integer& base, const WindowedExponent& exponent) const noexcept
+    {
+        const auto& steps = exponent.getSteps();
+        jassert(! steps.empty());
+        exponentiate(result, base, steps.data(), steps.size(), exponent.getTableSize());
+    }
+
+    /**
+     result = value^exponent mod n for a small odd exponent such as 65537, with 'value' and 'result' in normal form.
+
+     This is square-and-multiply with no table: for 65537 it is one conversion into Montgomery form
+     and 16 squarings, then a multiply by 'value' itself instead of by its Montgomery form,
+     which takes the result back out of Montgomery form at the same time.
+     'result' may alias 'value'.
+     */
+    void exponentiateSmall(Integer& result, const Integer& value, juce::uint32 exponent) const noexcept
+    {
+        jassert(exponent > 1 && (exponent & 1) != 0);
+
+        const auto original = value;
+        Integer base;
+        toMontgomery(base, original);
+
+        //(value * R)^(exponent >> 1) in Montgomery form, from the top bit down
+        auto half = exponent >> 1;
+        auto bit = 31;
+        while( bit > 0 && ((half >> bit) & 1) == 0 )
+            --bit;
+
+        result = base;
+        while( --bit >= 0 )
+        {
+            square(result, result);
+            if( ((half >> bit) & 1) != 0 )
+                multiply(result, result, base);
+        }
+
+        square(result, result);
+        multiply(result, result, original);
+    }
+
+    ///the same, for the steps of a WindowedExponent stored somewhere else, e.g. in a KeySnapshot
+    void exponentiate(Integer& result,
+                      const Integer& base,
+                      const WindowedExponent::Step* steps,
+                      size_t numSteps,
+                      int tableSize) const noexcept
+    {
+        jassert(numSteps > 0 && tableSize > 0 && tableSize <= maxTableSize);
+
+        //table[k] = base^(2k + 1)
+        Integer table[maxTableSize];
+        table[0] = base;
+        if( tableSize > 1 )
+        {
+            Integer square;
+            multiply(square, base, base);
+            for( int k = 1; k < tableSize; ++k )
+                multiply(table[k], table[k - 1], square);
+        }
+
+        result = table[steps[0].digit >> 1];
+
+        for( size_t i = 1; i < numSteps; ++i )
+        {
+            const auto& step = steps[i];
+            for( int k = 0; k < step.numSquarings; ++k )
+                multiply(result, result, result);
+
+            if( step.digit != 0 )
+                multiply(result, result, table[step.digit >> 1]);
+        }
+    }
+private:
+    Integer limbs, rSquared, rCubed;
+    juce::uint32 inverse = 0;
+
+    ///'t' has numLimbs + 1 limbs and is below 2n
+    void subtractModulusIfNeeded(Integer& result, const juce::uint32* t) const noexcept
+    {
+        bool needsSubtracting = t[numLimbs] != 0;
+        if( ! needsSubtracting )
+            needsSubtracting = MontgomeryArithmetic::compare(t, limbs.limbs, numLimbs) >= 0;
+
+        if( needsSubtracting )
+        {
+            juce::uint64 borrow = 0;
+            for( int i = 0; i < numLimbs; ++i )
+            {
+                auto x = static_cast<juce::uint64>(t[i]) - limbs.limbs[i] - borrow;
+                result.limbs[i] = static_cast<juce::uint32>(x);
+                borrow = (x >> 32) & 1;
+            }
+        }
+        else
+        {
+            std::copy(t, t + numLimbs, result.limbs);
+        }
+    }
+};
@@ -0,0 +1,806 @@
+/*
+  ==============================================================================
+
+    FixedWidthKey.cpp
+    Created: 17 Oct 2026 4:41:10pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "FixedWidthKey.h"
+#include "FixedWidthInteger.h"
+#include "MultiLaneMontgomery.h"
+
+namespace
+{
+enum class PreparedKind : juce::uint32
+{
+    plain = 1,
+    crt = 2,
+    smallExponent = 3
+};
+
+/**
+ The start of a key's prepared data.
+ It is followed by the key's State, then the steps of each of its exponents in turn.
+ */
+struct PreparedHeader
+{
+    PreparedKind kind;
+    juce::uint32 numBits;
+    juce::uint32 numSteps[2];
+    juce::int32 tableSize[2];
+};
+
+/**
+ The block of prepared data a key works from.
+ A key either owns it, or points into memory that 'owner' keeps alive.
+ */
+struct PreparedData
+{
+    juce::HeapBlock<char> storage;
+    juce::ReferenceCountedObjectPtr<juce::ReferenceCountedObject> owner;
+    const char* data = nullptr;
+    size_t size = 0;
+
+    const PreparedHeader& getHeader() const noexcept { return *reinterpret_cast<const PreparedHeader*>(data); }
+
+    template <typename State>
+    const State& getState() const noexcept { return *reinterpret_cast<const State*>(data + sizeof(PreparedHeader)); }
+
+    template <typename State>
+    const WindowedExponent::Step* getSteps(int exponentIndex) const noexcept
+    {
+        auto steps = reinterpret_cast<const WindowedExponent::Step*>(data + sizeof(PreparedHeader) + sizeof(State));
+        return exponentIndex == 0 ? steps : steps + getHeader().numSteps[0];
+    }
+
+    template <typename State>
+    static size_t getSize(const juce::uint32* numSteps, int numExponents) noexcept
+    {
+        auto size = sizeof(PreparedHeader) + sizeof(State);
+        for( int i = 0; i < numExponents; ++i )
+            size += numSteps[i] * sizeof(WindowedExponent::Step);
+
+        return size;
+    }
+};
+
+static_assert(sizeof(WindowedExponent::Step) == 4, "the steps are stored as they are laid out in memory");
+
+/**
+ The parts of FixedWidthKey that are the same for every kind of key:
+ moving values in and out of FixedWidthIntegers, and holding on to the prepared data.
+ 'KeyType' provides applyToInteger(), and applyToIntegers() and getLaneScratchSize() for applyBatch().
+ */
+template <typename KeyType, int numBits_>
+struct FixedWidthKeyBase : FixedWidthKey
+{
+    using Integer = FixedWidthInteger<numBits_>;
+
+    explicit FixedWidthKeyBase(PreparedData&& prepared_) :
+    prepared(std::move(prepared_))
+    {
+
+    }
+
+    int getNumBits() const noexcept override { return numBits_; }
+
+    const void* getPreparedData() const noexcept override { return prepared.data; }
+    size_t getPreparedDataSize() const noexcept override { return prepared.size; }
+
+    bool apply(juce::BigInteger& value) const override
+    {
+        Integer integer;
+        if( ! integer.fromBigInteger(value) || integer.isZero() || ! static_cast<const KeyType&>(*this).applyToInteger(integer) )
+            return false;
+
+        value = integer.toBigInteger();
+        return true;
+    }
+
+    bool apply(const void* input, size_t numBytes, juce::MemoryBlock& result) const override
+    {
+        Integer integer;
+        if( ! integer.fromBigEndianBytes(input, numBytes) || integer.isZero() || ! static_cast<const KeyType&>(*this).applyToInteger(integer) )
+            return false;
+
+        auto numResultBytes = static_cast<size_t>(integer.getNumSignificantBits() + 7) / 8;
+        result.setSize(numResultBytes);
+        integer.toBigEndianBytes(result.getData(), numResultBytes);
+        return true;
+    }
+
+    bool apply(const void* input, size_t numBytes, void* result, size_t numResultBytes) const noexcept override
+    {
+        Integer integer;
+        return integer.fromBigEndianBytes(input, numBytes)
+            && ! integer.isZero()
+            && static_cast<const KeyType&>(*this).applyToInteger(integer)
+            && integer.toBigEndianBytes(result, numResultBytes);
+    }
+
+    size_t getBatchScratchSize() const noexcept override
+    {
+        return static_cast<const KeyType&>(*this).getLaneScratchSize(MultiLaneMontgomery::getBestImplementation());
+    }
+
+    int applyBatch(const void* const* inputs,
+                   const size_t* numInputBytes,
+                   void* const* results,
+                   size_t numResultBytes,
+                   bool* succeeded,
+                   size_t numInputs,
+                   void* scratch) const noexcept override
+    {
+        const auto implementation = MultiLaneMontgomery::getBestImplementation();
+        const auto numLanes = static_cast<size_t>(MultiLaneMontgomery::getNumLanes(implementation));
+
+        int numSucceeded = 0;
+        Integer integers[MultiLaneMontgomery::maxNumLanes];
+        bool isValid[MultiLaneMontgomery::maxNumLanes];
+
+        for( size_t first = 0; first < numInputs; first += numLanes )
+        {
+            const auto numValues = juce::jmin(numLanes, numInputs - first);
+            for( size_t i = 0; i < numValues; ++i )
+            {
+                isValid[i] = integers[i].fromBigEndianBytes(inputs[first + i], numInputBytes[first + i]) && ! integers[i].isZero();
+                if( ! isValid[i] )
+                    integers[i] = {};
+            }
+
+            //a lone value is quicker on its own than in a set of lanes that are otherwise idle
+            if( numValues == 1 )
+                isValid[0] = isValid[0] && static_cast<const KeyType&>(*this).applyToInteger(integers[0]);
+            else
+                static_cast<const KeyType&>(*this).applyToIntegers(integers, isValid, static_cast<int>(numValues), scratch, implementation);
+
+            for( size_t i = 0; i < numValues; ++i )
+            {
+                succeeded[first + i] = isValid[i] && integers[i].toBigEndianBytes(results[first + i], numResultBytes);
+                if( succeeded[first + i] )
+                    ++numSucceeded;
+            }
+        }
+
+        return numSucceeded;
+    }
+
+    const PreparedData prepared;
+};
+
+///value^exponent mod modulus, with one full-width exponentiation
+template <int numBits>
+struct PlainKey : FixedWidthKeyBase<PlainKey<numBits>, numBits>
+{
+    using Integer = FixedWidthInteger<numBits>;
+
+    struct State
+    {
+        FixedWidthMontgomery<numBits> modulus;
+    };
+
+    static constexpr PreparedKind kind = PreparedKind::plain;
+    static constexpr int numExponents = 1;
+
+    static bool isValidState(const State& state) noexcept { return (state.modulus.getModulus().limbs[0] & 1) != 0; }
+
+    explicit PlainKey(PreparedData&& prepared_) :
+    FixedWidthKeyBase<PlainKey<numBits>, numBits>(std::move(prepared_)),
+    state(this->prepared.template getState<State>()),
+    steps(this->prepared.template getSteps<State>(0)),
+    numSteps(this->prepared.getHeader().numSteps[0]),
+    tableSize(this->prepared.getHeader().tableSize[0])
+    {
+
+    }
+
+    juce::BigInteger getModulus() const override { return state.modulus.getModulus().toBigInteger(); }
+
+    bool applyToInteger(Integer& value) const noexcept
+    {
+        if( value >= state.modulus.getModulus() )
+            return false;
+
+        Integer base;
+        state.modulus.toMontgomery(base, value);
+        state.modulus.exponentiate(value, base, steps, numSteps, tableSize);
+        state.modulus.fromMontgomery(value, value);
+        return true;
+    }
+
+    size_t getLaneScratchSize(MultiLaneMontgomery::Implementation implementation) const noexcept
+    {
+        return MultiLaneMontgomery::getNumScratchBytes(Integer::numLimbs, tableSize, implementation);
+    }
+
+    ///applyToInteger() on each value, side by side in SIMD lanes.  clears isValid[i] for values that aren't below the modulus
+    void applyToIntegers(Integer* values, bool* isValid, int numValues, void* scratch,
+                         MultiLaneMontgomery::Implementation implementation) const noexcept
+    {
+        juce::uint32* lanes[MultiLaneMontgomery::maxNumLanes];
+        for( int i = 0; i < numValues; ++i )
+        {
+            if( values[i] >= state.modulus.getModulus() )
+            {
+                isValid[i] = false;
+                values[i] = {};
+            }
+
+            lanes[i] = values[i].limbs;
+        }
+
+        MultiLaneMontgomery::exponentiate(lanes, numValues,
+                                          state.modulus.getModulus().limbs, state.modulus.getRSquared().limbs,
+                                          state.modulus.getInverse(), Integer::numLimbs,
+                                          steps, numSteps, tableSize, scratch, implementation);
+    }
+
+    const State& state;
+    const WindowedExponent::Step* const steps;
+    const size_t numSteps;
+    const int tableSize;
+};
+
+///a private key that does two half-width exponentiations and recombines them
+template <int numBits>
+struct CRTKey : FixedWidthKeyBase<CRTKey<numBits>, numBits>
+{
+    using Integer = FixedWidthInteger<numBits>;
+    using HalfInteger = FixedWidthInteger<numBits / 2>;
+
+    struct State
+    {
+        Integer modulus;
+        FixedWidthMontgomery<numBits / 2> prime1, prime2;
+        HalfInteger coefficient;
+    };
+
+    static constexpr PreparedKind kind = PreparedKind::crt;
+    static constexpr int numExponents = 2;
+
+    static bool isValidState(const State& state) noexcept
+    {
+        return (state.prime1.getModulus().limbs[0] & 1) != 0 && (state.prime2.getModulus().limbs[0] & 1) != 0;
+    }
+
+    explicit CRTKey(PreparedData&& prepared_) :
+    FixedWidthKeyBase<CRTKey<numBits>, numBits>(std::move(prepared_)),
+    state(this->prepared.template getState<State>()),
+    steps1(this->prepared.template getSteps<State>(0)),
+    steps2(this->prepared.template getSteps<State>(1)),
+    numSteps1(this->prepared.getHeader().numSteps[0]),
+    numSteps2(this->prepared.getHeader().numSteps[1]),
+    tableSize1(this->prepared.getHeader().tableSize[0]),
+    tableSize2(this->prepared.getHeader().tableSize[1])
+    {
+
+    }
+
+    juce::BigInteger getModulus() const override { return state.modulus.toBigInteger(); }
+
+    bool applyToInteger(Integer& value) const noexcept
+    {
+        const auto& prime1 = state.prime1;
+        const auto& prime2 = state.prime2;
+
+        if( value >= state.modulus )
+            return false;
+
+        /*
+         value < n < p * R, so reducing it gives value * R^-1 mod p,
+         and a Montgomery multiply by R^3 turns that into value * R mod p.
+         */
+        HalfInteger reduced, base, m1, m2;
+        prime1.reduce(reduced, value);
+        prime1.multiply(base, reduced, prime1.getRCubed());
+        prime1.exponentiate(m1, base, steps1, numSteps1, tableSize1); // m1 = c^dP mod p, Montgomery form
+
+        prime2.reduce(reduced, value);
+        prime2.multiply(base, reduced, prime2.getRCubed());
+        prime2.exponentiate(m2, base, steps2, numSteps2, tableSize2);
+        prime2.fromMontgomery(m2, m2); // m2 = c^dQ mod q
+
+        recombine(value, m1, m2);
+        return true;
+    }
+
+    size_t getLaneScratchSize(MultiLaneMontgomery::Implementation implementation) const noexcept
+    {
+        return MultiLaneMontgomery::getNumScratchBytes(HalfInteger::numLimbs, juce::jmax(tableSize1, tableSize2), implementation);
+    }
+
+    ///applyToInteger() on each value, with each prime's exponentiations side by side in SIMD lanes
+    void applyToIntegers(Integer* values, bool* isValid, int numValues, void* scratch,
+                         MultiLaneMontgomery::Implementation implementation) const noexcept
+    {
+        const auto& prime1 = state.prime1;
+        const auto& prime2 = state.prime2;
+
+        //the lanes work in normal form: reducing gives value * R^-1, and a Montgomery multiply by R^2 takes that to value
+        HalfInteger m1[MultiLaneMontgomery::maxNumLanes], m2[MultiLaneMontgomery::maxNumLanes];
+        juce::uint32* lanes1[MultiLaneMontgomery::maxNumLanes];
+        juce::uint32* lanes2[MultiLaneMontgomery::maxNumLanes];
+
+        for( int i = 0; i < numValues; ++i )
+        {
+            if( values[i] >= state.modulus )
+            {
+                isValid[i] = false;
+                values[i] = {};
+            }
+
+            prime1.reduce(m1[i], values[i]);
+            prime1.multiply(m1[i], m1[i], prime1.getRSquared());
+            prime2.reduce(m2[i], values[i]);
+            prime2.multiply(m2[i], m2[i], prime2.getRSquared());
+
+            lanes1[i] = m1[i].limbs;
+            lanes2[i] = m2[i].limbs;
+        }
+
+        MultiLaneMontgomery::exponentiate(lanes1, numValues,
+                                          prime1.getModulus().limbs, prime1.getRSquared().limbs, prime1.getInverse(),
+                                          HalfInteger::numLimbs, steps1, numSteps1, tableSize1, scratch, implementation);
+        MultiLaneMontgomery::exponentiate(lanes2, numValues,
+                                          prime2.getModulus().limbs, prime2.getRSquared().limbs, prime2.getInverse(),
+                                          HalfInteger::numLimbs, steps2, numSteps2, tableSize2, scratch, implementation);
+
+        for( int i = 0; i < numValues; ++i )
+        {
+            prime1.toMontgomery(m1[i], m1[i]);
+            recombine(values[i], m1[i], m2[i]);
+        }
+    }
+
+    ///value = m2 + q * (qInv * (m1 - m2) mod p), with m1 in p's Montgomery form and m2 in normal form
+    void recombine(Integer& value, HalfInteger& m1, const HalfInteger& m2) const noexcept
+    {
+        const auto& prime1 = state.prime1;
+        const auto& prime2 = state.prime2;
+
+        //h = qInv * (m1 - m2) mod p.  m2 is moved into p's Montgomery form first, and the multiply by qInv moves the difference back out
+        HalfInteger h;
+        prime1.toMontgomery(h, m2);
+        if( m1.subtract(h) != 0 )
+            m1.add(prime1.getModulus());
+
+        prime1.multiply(h, m1, state.coefficient);
+
+        //m = m2 + h * q
+        value = FixedWidthArithmetic::multiply(h, prime2.getModulus());
+        Integer wideM2;
+        wideM2.assign(m2);
+        value.add(wideM2);
+    }
+
+    const State& state;
+    const WindowedExponent::Step* const steps1;
+    const WindowedExponent::Step* const steps2;
+    const size_t numSteps1, numSteps2;
+    const int tableSize1, tableSize2;
+};
+
+/**
+ value^exponent mod modulus for an odd exponent that fits in 32 bits, which is what nearly every public key has.
+ There's nothing to recode: see FixedWidthMontgomery::exponentiateSmall().
+ */
+template <int numBits>
+struct SmallExponentKey : FixedWidthKeyBase<SmallExponentKey<numBits>, numBits>
+{
+    using Integer = FixedWidthInteger<numBits>;
+
+    struct State
+    {
+        FixedWidthMontgomery<numBits> modulus;
+        juce::uint32 exponent;
+    };
+
+    static constexpr PreparedKind kind = PreparedKind::smallExponent;
+    static constexpr int numExponents = 0;
+
+    static bool isValidState(const State& state) noexcept
+    {
+        return (state.modulus.getModulus().limbs[0] & 1) != 0 && state.exponent > 1 && (state.exponent & 1) != 0;
+    }
+
+    ///returns true if keys with this exponent can be a SmallExponentKey
+    static bool canUseExponent(const juce::BigInteger& exponent) noexcept
+    {
+        return ! exponent.isNegative() && exponent.getHighestBit() >= 1 && exponent.getHighestBit() < 32 && exponent[0];
+    }
+
+    explicit SmallExponentKey(PreparedData&& prepared_) :
+    FixedWidthKeyBase<SmallExponentKey<numBits>, numBits>(std::move(prepared_)),
+    state(this->prepared.template getState<State>())
+    {
+
+    }
+
+    juce::BigInteger getModulus() const override { return state.modulus.getModulus().toBigInteger(); }
+
+    bool applyToInteger(Integer& value) const noexcept
+    {
+        if( value >= state.modulus.getModulus() )
+            return false;
+
+        state.modulus.exponentiateSmall(value, value, state.exponent);
+        return true;
+    }
+
+    size_t getLaneScratchSize(MultiLaneMontgomery::Implementation) const noexcept { return 0; }
+
+    ///a handful of squarings each is too little work to be worth interleaving, so these run one after the other
+    void applyToIntegers(Integer* values, bool* isValid, int numValues, void*, MultiLaneMontgomery::Implementation) const noexcept
+    {
+        for( int i = 0; i < numValues; ++i )
+            isValid[i] = isValid[i] && applyToInteger(values[i]);
+    }
+
+    const State& state;
+};
+
+//==============================================================================
+///lays out the state and exponents of a new key in a block that the key owns
+template <typename KeyType>
+FixedWidthKey::Ptr createPreparedKey(const typename KeyType::State& state,
+                                     std::initializer_list<const WindowedExponent*> exponents)
+{
+    using State = typename KeyType::State;
+    static_assert(std::is_trivially_copyable<State>::value && std::is_standard_layout<State>::value,
+                  "the state is stored as it is laid out in memory");
+    jassert(static_cast<int>(exponents.size()) == KeyType::numExponents);
+
+    PreparedHeader header = {};
+    header.kind = KeyType::kind;
+    header.numBits = static_cast<juce::uint32>(KeyType::Integer::numBits);
+
+    int index = 0;
+    for( auto* exponent : exponents )
+    {
+        header.numSteps[index] = static_cast<juce::uint32>(exponent->getSteps().size());
+        header.tableSize[index] = exponent->getTableSize();
+        ++index;
+    }
+
+    PreparedData prepared;
+    prepared.size = PreparedData::getSize<State>(header.numSteps, KeyType::numExponents);
+    prepared.storage.allocate(prepared.size, true);
+
+    auto dest = prepared.storage.get();
+    std::memcpy(dest, &header, sizeof(header));
+    std::memcpy(dest + sizeof(header), &state, sizeof(state));
+
+    dest += sizeof(header) + sizeof(state);
+    for( auto* exponent : exponents )
+    {
+        const auto& steps = exponent->getSteps();
+        std::memcpy(dest, steps.data(), steps.size() * sizeof(WindowedExponent::Step));
+        dest += steps.size() * sizeof(WindowedExponent::Step);
+    }
+
+    prepared.data = prepared.storage.get();
+    return new KeyType(std::move(prepared));
+}
+
+/**
+ makes a key that works on prepared data somewhere else.
+ the arithmetic isn't redone, but everything the key indexes with is bounds-checked,
+ so a damaged block can't make it read outside its own memory.
+ */
+template <typename KeyType>
+FixedWidthKey::Ptr createKeyFromPreparedData(const char* data,
+                                             size_t numBytes,
+                                             juce::ReferenceCountedObject* owner)
+{
+    using State = typename KeyType::State;
+    using Step = WindowedExponent::Step;
+
+    const auto& header = *reinterpret_cast<const PreparedHeader*>(data);
+    for( int i = 0; i < 2; ++i )
+    {
+        if( i >= KeyType::numExponents )
+        {
+            if( header.numSteps[i] != 0 )
+                return nullptr;
+
+            continue;
+        }
+
+        auto tableSize = header.tableSize[i];
+        if( header.numSteps[i] == 0 || header.numSteps[i] > numBytes / sizeof(Step)
+            || tableSize < 1 || tableSize > FixedWidthMontgomery<KeyType::Integer::numBits>::maxTableSize )
+        {
+            return nullptr;
+        }
+    }
+
+    if( numBytes != PreparedData::getSize<State>(header.numSteps, KeyType::numExponents) )
+        return nullptr;
+
+    PreparedData prepared;
+    prepared.owner = owner;
+    prepared.data = data;
+    prepared.size = numBytes;
+
+    if( ! KeyType::isValidState(prepared.getState<State>()) )
+        return nullptr;
+
+    for( int i = 0; i < KeyType::numExponents; ++i )
+    {
+        auto steps = prepared.getSteps<State>(i);
+        for( juce::uint32 j = 0; j < header.numSteps[i]; ++j )
+        {
+            //every digit is odd, and indexes the table of odd powers
+            auto digit = steps[j].digit;
+            if( (digit == 0 && j == 0) || (digit != 0 && (digit % 2 == 0 || digit / 2 >= header.tableSize[i])) )
+                return nullptr;
+        }
+    }
+
+    return new KeyType(std::move(prepared));
+}
+
+template <int numBits>
+FixedWidthKey::Ptr createKeyFromPreparedData(const char* data, size_t numBytes, juce::ReferenceCountedObject* owner)
+{
+    switch( reinterpret_cast<const PreparedHeader*>(data)->kind )
+    {
+        case PreparedKind::plain: return createKeyFromPreparedData<PlainKey<numBits>>(data, numBytes, owner);
+        case PreparedKind::crt: return createKeyFromPreparedData<CRTKey<numBits>>(data, numBytes, owner);
+        case PreparedKind::smallExponent: return createKeyFromPreparedData<SmallExponentKey<numBits>>(data, numBytes, owner);
+        default: return nullptr;
+    }
+}
+
+template <int numBits>
+FixedWidthKey::Ptr createPlainKey(const juce::BigInteger& modulus, const juce::BigInteger& exponent)
+{
+    if( SmallExponentKey<numBits>::canUseExponent(exponent) )
+    {
+        MontgomeryModulus montgomeryModulus(modulus);
+        if( ! montgomeryModulus.isValid() || montgomeryModulus.getNumLimbs() != numBits / 32 )
+            return nullptr;
+
+        typename SmallExponentKey<numBits>::State state;
+        state.modulus = FixedWidthMontgomery<numBits>(montgomeryModulus);
+        state.exponent = static_cast<juce::uint32>(exponent.getBitRangeAsInt(0, 32));
+
+        return createPreparedKey<SmallExponentKey<numBits>>(state, {});
+    }
+
+    MontgomeryModulus montgomeryModulus(modulus);
+    WindowedExponent windowedExponent(exponent);
+    if( ! montgomeryModulus.isValid() || montgomeryModulus.getNumLimbs() != numBits / 32 || ! windowedExponent.isValid() )
+        return nullptr;
+
+    typename PlainKey<numBits>::State state;
+    state.modulus = FixedWidthMontgomery<numBits>(montgomeryModulus);
+
+    return createPreparedKey<PlainKey<numBits>>(state, { &windowedExponent });
+}
+
+template <int numBits>
+FixedWidthKey::Ptr createCRTKey(const juce::BigInteger& modulus,
+                                const juce::BigInteger& privateExponent,
+                                const juce::BigInteger& prime1,
+                                const juce::BigInteger& prime2,
+                                const juce::BigInteger& exponent1,
+                                const juce::BigInteger& exponent2,
+                                const juce::BigInteger& coefficient)
+{
+    constexpr auto numHalfLimbs = numBits / 64;
+
+    typename CRTKey<numBits>::State state;
+    WindowedExponent windowedExponent1(exponent1), windowedExponent2(exponent2);
+    auto canUseCRT = prime1[0] && prime2[0]
+                     && state.coefficient.fromBigInteger(coefficient)
+                     && coefficient < prime1
+                     && windowedExponent1.isValid()
+                     && windowedExponent2.isValid()
+                     && state.modulus.fromBigInteger(modulus);
+
+    if( canUseCRT )
+    {
+        MontgomeryModulus montgomery1(prime1), montgomery2(prime2);
+        if( montgomery1.getNumLimbs() == numHalfLimbs && montgomery2.getNumLimbs() == numHalfLimbs )
+        {
+            state.prime1 = FixedWidthMontgomery<numBits / 2>(montgomery1);
+            state.prime2 = FixedWidthMontgomery<numBits / 2>(montgomery2);
+            return createPreparedKey<CRTKey<numBits>>(state, { &windowedExponent1, &windowedExponent2 });
+        }
+    }
+
+    return createPlainKey<numBits>(modulus, privateExponent);
+}
+
+template <int numBits>
+FixedWidthKey::CheckResult checkPrivateKeyWithWidth(const juce::BigInteger& modulus,
+                                                    const juce::BigInteger& publicExponent,
+                                                    const juce::BigInteger& privateExponent,
+                                                    const juce::BigInteger& prime1,
+                                                    const juce::BigInteger& prime2,
+                                                    const juce::BigInteger& exponent1,
+                                                    const juce::BigInteger& exponent2,
+                                                    const juce::BigInteger& coefficient,
+                                                    WorkStealingThreadPool* pool)
+{
+    using CheckResult = FixedWidthKey::CheckResult;
+    using Integer = FixedWidthInteger<numBits>;
+    using HalfInteger = FixedWidthInteger<numBits / 2>;
+
+    Integer n, e, d;
+    HalfInteger p, q, dP, dQ, qInv;
+    if( ! n.fromBigInteger(modulus) || ! e.fromBigInteger(publicExponent) || ! d.fromBigInteger(privateExponent)
+        || ! p.fromBigInteger(prime1) || ! q.fromBigInteger(prime2)
+        || ! dP.fromBigInteger(exponent1) || ! dQ.fromBigInteger(exponent2) || ! qInv.fromBigInteger(coefficient) )
+    {
+        return CheckResult::unsupportedSize;
+    }
+
+    if( FixedWidthArithmetic::multiply(p, q) != n )
+    {
+        DBG( "failed math check: n == p * q" );
+        return CheckResult::failed;
+    }
+
+    auto pMinus1 = p, qMinus1 = q;
+    if( pMinus1.subtract(1u) != 0 || pMinus1.isZero() || qMinus1.subtract(1u) != 0 || qMinus1.isZero() )
+    {
+        DBG( "failed math check: p > 1 && q > 1" );
+        return CheckResult::failed;
+    }
+
+    //the two primes and the coefficient are checked independently of each other
+    auto checkPrime = [&](size_t index)
+    {
+        switch( index )
+        {
+            case 0:
+            {
+                if( FixedWidthArithmetic::modulo(d, pMinus1) != dP )
+                {
+                    DBG( "computed value [d mod (p - 1)] does not match extracted value!" );
+                    return false;
+                }
+
+                //with dP == d mod (p - 1), e * dP == 1 mod (p - 1) is the same as e^-1 mod (p - 1) == d mod (p - 1)
+                auto eModP = FixedWidthArithmetic::modulo(e, pMinus1);
+                if( ! FixedWidthArithmetic::modulo(FixedWidthArithmetic::multiply(eModP, dP), pMinus1).isOne() )
+                {
+                    DBG( "failed math check: e^-1 mod (p - 1) == d mod (p - 1)" );
+                    return false;
+                }
+
+                return true;
+            }
+            case 1:
+            {
+                if( FixedWidthArithmetic::modulo(d, qMinus1) != dQ )
+                {
+                    DBG( "computed value [d mod (q - 1)] does not match extracted value!" );
+                    return false;
+                }
+
+                auto eModQ = FixedWidthArithmetic::modulo(e, qMinus1);
+                if( ! FixedWidthArithmetic::modulo(FixedWidthArithmetic::multiply(eModQ, dQ), qMinus1).isOne() )
+                {
+                    DBG( "failed math check: e^-1 mod (q - 1) == d mod (q - 1)" );
+                    return false;
+                }
+
+                return true;
+            }
+            default:
+            {
+                auto qModP = FixedWidthArithmetic::modulo(q, p);
+                if( ! (qInv < p) || ! FixedWidthArithmetic::modulo(FixedWidthArithmetic::multiply(qModP, qInv), p).isOne() )
+                {
+                    DBG( "computed value [q^-1 mod p] does not match extracted value!" );
+                    return false;
+                }
+
+                return true;
+            }
+        }
+    };
+
+    if( ! WorkStealingThreadPool::allOf(pool, 3, checkPrime) )
+        return CheckResult::failed;
+
+    return CheckResult::passed;
+}
+} // namespace
+
+//==============================================================================
+int FixedWidthKey::getNumBitsForModulus(const juce::BigInteger& modulus)
+{
+    if( modulus.isNegative() || modulus.isZero() )
+        return 0;
+
+    auto numLimbs = modulus.getHighestBit() / 32 + 1;
+    for( auto numBits : { 1024, 2048, 3072, 4096 } )
+    {
+        if( numLimbs == numBits / 32 )
+            return numBits;
+    }
+
+    return 0;
+}
+
+FixedWidthKey::Ptr FixedWidthKey::create(const juce::BigInteger& modulus, const juce::BigInteger& exponent)
+{
+    switch( getNumBitsForModulus(modulus) )
+    {
+        case 1024: return createPlainKey<1024>(modulus, exponent);
+        case 2048: return createPlainKey<2048>(modulus, exponent);
+        case 3072: return createPlainKey<3072>(modulus, exponent);
+        case 4096: return createPlainKey<4096>(modulus, exponent);
+        default: return nullptr;
+    }
+}
+
+FixedWidthKey::Ptr FixedWidthKey::create(const juce::BigInteger& modulus,
+                                         const juce::BigInteger& privateExponent,
+                                         const juce::BigInteger& prime1,
+                                         const juce::BigInteger& prime2,
+                                         const juce::BigInteger& exponent1,
+                                         const juce::BigInteger& exponent2,
+                                         const juce::BigInteger& coefficient)
+{
+    switch( getNumBitsForModulus(modulus) )
+    {
+        case 1024: return createCRTKey<1024>(modulus, privateExponent, prime1, prime2, exponent1, exponent2, coefficient);
+        case 2048: return createCRTKey<2048>(modulus, privateExponent, prime1, prime2, exponent1, exponent2, coefficient);
+        case 3072: return createCRTKey<3072>(modulus, privateExponent, prime1, prime2, exponent1, exponent2, coefficient);
+        case 4096: return createCRTKey<4096>(modulus, privateExponent, prime1, prime2, exponent1, exponent2, coefficient);
+        default: return nullptr;
+    }
+}
+
+FixedWidthKey::Ptr FixedWidthKey::createFromPreparedData(const void* data, size_t numBytes, juce::ReferenceCountedObject* owner)
+{
+    auto bytes = static_cast<const char*>(data);
+    if( numBytes < sizeof(PreparedHeader) || reinterpret_cast<std::uintptr_t>(bytes) % alignof(PreparedHeader) != 0 )
+    {
+        jassertfalse;
+        return nullptr;
+    }
+
+    Ptr key;
+    switch( reinterpret_cast<const PreparedHeader*>(bytes)->numBits )
+    {
+        case 1024: key = createKeyFromPreparedData<1024>(bytes, numBytes, owner); break;
+        case 2048: key = createKeyFromPreparedData<2048>(bytes, numBytes, owner); break;
+        case 3072: key = createKeyFromPreparedData<3072>(bytes, numBytes, owner); break;
+        case 4096: key = createKeyFromPreparedData<4096>(bytes, numBytes, owner); break;
+        default: break;
+    }
+
+    if( key == nullptr )
+        DBG( "the prepared key data is damaged!" );
+
+    return key;
+}
+
+FixedWidthKey::CheckResult FixedWidthKey::checkPrivateKey(const juce::BigInteger& modulus,
+                                                          const juce::BigInteger& publicExponent,
+                                                          const juce::BigInteger& privateExponent,
+                                                          const juce::BigInteger& prime1,
+                                                          const juce::BigInteger& prime2,
+                                                          const juce::BigInteger& exponent1,
+                                                          const juce::BigInteger& exponent2,
+                                                          const juce::BigInteger& coefficient,
+                                                          WorkStealingThreadPool* pool)
+{
+    switch( getNumBitsForModulus(modulus) )
+    {
+        case 1024: return checkPrivateKeyWithWidth<1024>(modulus, publicExponent, privateExponent, prime1, prime2, exponent1, exponent2, coefficient, pool);
+        case 2048: return checkPrivateKeyWithWidth<2048>(modulus, publicExponent, privateExponent, prime1, prime2, exponent1, exponent2, coefficient, pool);
+        case 3072: return checkPrivateKeyWithWidth<3072>(modulus, publicExponent, privateExponent, prime1, prime2, exponent1, exponent2, coefficient, pool);
+        case 4096: return checkPrivateKeyWithWidth<4096>(modulus, publicExponent, privateExponent, prime1, prime2, exponent1, exponent2, coefficient, pool);
+        default: return CheckResult::unsupportedSize;
+    }
+}
@@ -0,0 +1,140 @@
+/*
+  ==============================================================================
+
+    FixedWidthKey.h
+    Created: 17 Oct 2026 4:41:10pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "WorkStealingThreadPool.h"
+
+/**
+ An RSA key prepared for one of the standard key sizes (1024, 2048, 3072 or 4096 bits).
+
+ The key is stored in FixedWidthIntegers picked when the key is loaded, so applying it
+ works entirely on the stack: no heap allocations, and every limb loop has a length
+ known at compile time.  Keys of any other size get a nullptr from create() and should
+ use MontgomeryKeyContext instead.
+
+ A FixedWidthKey is never modified after it has been created, so it can be shared between
+ threads.  All of its state lives in one block of plain data (see getPreparedData()), which is
+ what lets a KeySnapshot map keys straight from a file.
+ */
+struct FixedWidthKey : juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<FixedWidthKey>;
+
+    enum class CheckResult
+    {
+        unsupportedSize,
+        passed,
+        failed
+    };
+
+    ~FixedWidthKey() override = default;
+
+    ///returns the width used for keys with this modulus, or 0 if it isn't one of the standard sizes
+    static int getNumBitsForModulus(const juce::BigInteger& modulus);
+
+    /**
+     a key that computes value^exponent mod modulus.
+     an odd exponent that fits in 32 bits, like a public key's 65537, is applied with
+     plain square-and-multiply instead of a windowed exponent.
+     */
+    static Ptr create(const juce::BigInteger& modulus, const juce::BigInteger& exponent);
+
+    /**
+     a private key that uses the Chinese Remainder Theorem.
+     falls back to the private exponent if the primes aren't both half the width of the modulus.
+     */
+    static Ptr create(const juce::BigInteger& modulus,
+                      const juce::BigInteger& privateExponent,
+                      const juce::BigInteger& prime1,
+                      const juce::BigInteger& prime2,
+                      const juce::BigInteger& exponent1,
+                      const juce::BigInteger& exponent2,
+                      const juce::BigInteger& coefficient);
+
+    /**
+     Checks that the parts of a private key agree with each other:
+
+     n == p * q
+     d mod (p - 1) == exponent1, d mod (q - 1) == exponent2
+     e * exponent1 == 1 mod (p - 1), e * exponent2 == 1 mod (q - 1)
+     q * coefficient == 1 mod p
+
+     Together the middle two lines are the same as e * d == 1 mod lcm(p - 1, q - 1).
+     The checks for p, for q and for the coefficient don't depend on each other; if 'pool'
+     isn't nullptr they run on it at the same time (see WorkStealingThreadPool::allOf()).
+     Returns unsupportedSize if the key isn't one of the standard sizes or its primes aren't half its width.
+     */
+    static CheckResult checkPrivateKey(const juce::BigInteger& modulus,
+                                       const juce::BigInteger& publicExponent,
+                                       const juce::BigInteger& privateExponent,
+                                       const juce::BigInteger& prime1,
+                                       const juce::BigInteger& prime2,
+                                       const juce::BigInteger& exponent1,
+                                       const juce::BigInteger& exponent2,
+                                       const juce::BigInteger& coefficient,
+                                       WorkStealingThreadPool* pool = nullptr);
+
+    /**
+     Creates a key that works straight from prepared data written by getPreparedData(),
+     without copying it or redoing any of the arithmetic that went into it.
+     'data' must be 4-byte aligned and stay valid for as long as 'owner' does; the key keeps 'owner' alive.
+     Returns nullptr if the data is truncated or malformed.
+     */
+    static Ptr createFromPreparedData(const void* data, size_t numBytes, juce::ReferenceCountedObject* owner);
+
+    virtual int getNumBits() const noexcept = 0;
+
+    virtual juce::BigInteger getModulus() const = 0;
+
+    /**
+     Everything the key works from, as one block of plain data: native-endian limbs, the Montgomery
+     constants and the recoded exponents, with no pointers.  It can be written out and mapped back
+     in with createFromPreparedData() on a machine with the same byte order.
+     */
+    virtual const void* getPreparedData() const noexcept = 0;
+    virtual size_t getPreparedDataSize() const noexcept = 0;
+
+    ///applies the key to 'value' in place.  returns false if the value is zero or isn't below the modulus
+    virtual bool apply(juce::BigInteger& value) const = 0;
+
+    /**
+     applies the key to big-endian input bytes and writes the minimal big-endian result into 'result'.
+     'result' may hold the input itself.  returns false, leaving 'result' alone, if the input is zero or isn't below the modulus.
+     */
+    virtual bool apply(const void* input, size_t numBytes, juce::MemoryBlock& result) const = 0;
+
+    /**
+     applies the key to big-endian input bytes and writes the result into exactly 'numResultBytes' big-endian bytes,
+     padded with leading zeros.  nothing is allocated.  returns false if the input is zero, isn't below the modulus
+     or the result doesn't fit.
+     */
+    virtual bool apply(const void* input, size_t numBytes, void* result, size_t numResultBytes) const noexcept = 0;
+
+    ///the bytes of scratch applyBatch() needs
+    virtual size_t getBatchScratchSize() const noexcept = 0;
+
+    /**
+     Applies the key to 'numInputs' independent inputs, like the apply() above on each of them: results[i] gets
+     exactly 'numResultBytes' big-endian bytes, and succeeded[i] says whether inputs[i] was non-zero and below the modulus.
+     Where the CPU has AVX2 or AVX-512, the exponentiations run several at a time side by side in SIMD lanes
+     (see MultiLaneMontgomery), which is several times the throughput of applying them one by one.
+     'scratch' must have room for getBatchScratchSize() bytes.  Returns the number of inputs that succeeded.
+     */
+    virtual int applyBatch(const void* const* inputs,
+                           const size_t* numInputBytes,
+                           void* const* results,
+                           size_t numResultBytes,
+                           bool* succeeded,
+                           size_t numInputs,
+                           void* scratch) const noexcept = 0;
+};
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    KeyID.cpp
+    Created: 18 Oct 2026 6:02:17am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "KeyID.h"
+
+KeyID KeyID::fromSHA256(const juce::SHA256& sha)
+{
+    KeyID keyID;
+    auto digest = sha.getRawData();
+    jassert(digest.getSize() == sizeof(keyID.bytes));
+    std::memcpy(keyID.bytes, digest.getData(), sizeof(keyID.bytes));
+
+    return keyID;
+}
+
+bool KeyID::fromHexString(juce::StringRef hex, KeyID& result)
+{
+    auto text = hex.text;
+    KeyID keyID;
+
+    for( size_t i = 0; i < sizeof(keyID.bytes) * 2; ++i )
+    {
+        auto digit = juce::CharacterFunctions::getHexDigitValue(text.getAndAdvance());
+        if( digit < 0 )
+            return false;
+
+        keyID.bytes[i / 2] = static_cast<juce::uint8>((keyID.bytes[i / 2] << 4) | digit);
+    }
+
+    if( ! text.isEmpty() )
+        return false;
+
+    result = keyID;
+    return true;
+}
+
+juce::String KeyID::toHexString() const
+{
+    return juce::String::toHexString(bytes, static_cast<int>(sizeof(bytes)), 0);
+}
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    KeyID.h
+    Created: 18 Oct 2026 6:02:17am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+///a SHA-256 digest that identifies a key, a certificate's subject, or the DER some checks were run on
+struct KeyID
+{
+    juce::uint8 bytes[32] = {};
+
+    static KeyID fromSHA256(const juce::SHA256& sha);
+    ///reads 64 hex digits.  returns false if that's not what the string holds
+    static bool fromHexString(juce::StringRef hex, KeyID& result);
+    juce::String toHexString() const;
+
+    bool operator==(const KeyID& other) const noexcept { return std::memcmp(bytes, other.bytes, sizeof(bytes)) == 0; }
+    bool operator!=(const KeyID& other) const noexcept { return ! operator==(other); }
+
+    ///the digest is already uniformly distributed, so its first bytes make a good hash
+    struct Hash
+    {
+        size_t operator()(const KeyID& keyID) const noexcept
+        {
+            size_t hash;
+            std::memcpy(&hash, keyID.bytes, sizeof(hash));
+            return hash;
+        }
+    };
+};
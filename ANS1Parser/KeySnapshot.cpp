@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    KeySnapshot.cpp
+    Created: 17 Oct 2026 9:03:37pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "KeySnapshot.h"
+
+namespace
+{
+///keeps a snapshot mapped for as long as any of its keys are alive
+struct SharedMapping : juce::ReferenceCountedObject
+{
+    explicit SharedMapping(const juce::File& file) :
+    mapping(file, juce::MemoryMappedFile::readOnly)
+    {
+
+    }
+
+    juce::MemoryMappedFile mapping;
+};
+} // namespace
+
+constexpr char KeySnapshot::magic[8];
+
+bool KeySnapshot::write(const std::vector<PEMFormatKey>& keys, juce::MemoryBlock& result)
+{
+    /*
+     measure everything first, so the snapshot is built in one allocation
+     */
+    std::vector<FixedWidthKey::Ptr> preparedKeys;
+    preparedKeys.reserve(keys.size());
+
+    auto tableEnd = sizeof(FileHeader) + keys.size() * sizeof(KeyEntry);
+    auto fileSize = align(tableEnd);
+
+    for( const auto& key : keys )
+    {
+        auto preparedKey = key.getPreparedKey();
+        if( preparedKey == nullptr )
+        {
+            DBG( "only keys of the standard sizes can go in a snapshot!" );
+            jassertfalse;
+            return false;
+        }
+
+        fileSize = align(fileSize + preparedKey->getPreparedDataSize());
+        preparedKeys.push_back(preparedKey);
+    }
+
+    result.setSize(fileSize, true);
+    auto dest = static_cast<char*>(result.getData());
+
+    FileHeader header = {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = currentVersion;
+    header.byteOrderMark = byteOrderMark;
+    header.numKeys = static_cast<juce::uint32>(keys.size());
+    header.headerSize = sizeof(FileHeader);
+    header.fileSize = fileSize;
+
+    auto entries = reinterpret_cast<KeyEntry*>(dest + sizeof(FileHeader));
+    auto offset = align(tableEnd);
+
+    for( size_t i = 0; i < preparedKeys.size(); ++i )
+    {
+        auto size = preparedKeys[i]->getPreparedDataSize();
+        entries[i].offset = offset;
+        entries[i].size = size;
+
+        std::memcpy(dest + offset, preparedKeys[i]->getPreparedData(), size);
+        offset = align(offset + size);
+    }
+
+    jassert(offset == fileSize);
+
+    auto checksum = juce::SHA256(dest + sizeof(FileHeader), fileSize - sizeof(FileHeader)).getRawData();
+    std::memcpy(header.checksum, checksum.getData(), sizeof(header.checksum));
+    std::memcpy(dest, &header, sizeof(header));
+
+    return true;
+}
+
+bool KeySnapshot::writeToFile(const std::vector<PEMFormatKey>& keys, const juce::File& file)
+{
+    juce::MemoryBlock snapshot;
+    if( ! write(keys, snapshot) )
+        return false;
+
+    //replaceWithData() writes a temporary file and renames it over the old one
+    return file.replaceWithData(snapshot.getData(), snapshot.getSize());
+}
+
+std::vector<PEMFormatKey> KeySnapshot::loadFile(const juce::File& file, bool verifyChecksum)
+{
+    juce::ReferenceCountedObjectPtr<SharedMapping> shared = new SharedMapping(file);
+
+    auto data = static_cast<const char*>(shared->mapping.getData());
+    auto fileSize = shared->mapping.getSize();
+    if( data == nullptr || fileSize < sizeof(FileHeader) )
+    {
+        DBG( "couldn't map the snapshot " + file.getFullPathName() );
+        return {};
+    }
+
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if( std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.headerSize != sizeof(FileHeader) )
+    {
+        DBG( "not a key snapshot!" );
+        return {};
+    }
+
+    if( header.version != currentVersion )
+    {
+        DBG( "unsupported snapshot version " + juce::String(header.version) );
+        return {};
+    }
+
+    if( header.byteOrderMark != byteOrderMark )
+    {
+        DBG( "the snapshot was written on a machine with the other byte order!" );
+        return {};
+    }
+
+    if( header.fileSize != fileSize || header.numKeys > (fileSize - sizeof(FileHeader)) / sizeof(KeyEntry) )
+    {
+        DBG( "the snapshot is truncated!" );
+        return {};
+    }
+
+    if( verifyChecksum )
+    {
+        auto checksum = juce::SHA256(data + sizeof(FileHeader), fileSize - sizeof(FileHeader)).getRawData();
+        if( checksum.getSize() != sizeof(header.checksum) || std::memcmp(checksum.getData(), header.checksum, sizeof(header.checksum)) != 0 )
+        {
+            DBG( "the snapshot's checksum doesn't match!" );
+            return {};
+        }
+    }
+
+    std::vector<PEMFormatKey> keys(header.numKeys);
+
+    for( juce::uint32 i = 0; i < header.numKeys; ++i )
+    {
+        KeyEntry entry;
+        std::memcpy(&entry, data + sizeof(FileHeader) + i * sizeof(KeyEntry), sizeof(entry));
+
+        if( entry.offset % alignment != 0 || entry.offset > fileSize || entry.size > fileSize - entry.offset )
+        {
+            DBG( "the snapshot's key table is damaged!" );
+            return {};
+        }
+
+        auto preparedKey = FixedWidthKey::createFromPreparedData(data + entry.offset, static_cast<size_t>(entry.size), shared.get());
+        if( preparedKey == nullptr )
+            return {};
+
+        keys[i].loadFromPreparedKey(preparedKey);
+    }
+
+    return keys;
+}
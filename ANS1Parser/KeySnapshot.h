@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    KeySnapshot.h
+    Created: 17 Oct 2026 9:03:37pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PEMFormatKey.h"
+
+/**
+ A binary file of keys that have already been loaded, checked and prepared.
+
+ Loading a private key from PEM checks its components against each other and computes
+ its Montgomery constants, which adds up for a large keyring.  A snapshot stores each
+ key's prepared data (see FixedWidthKey::getPreparedData()) as it is laid out in memory,
+ so loading one is a memory-map and a bounds check per key.  The keys work straight out
+ of the mapping, which means every process that loads the same snapshot shares its pages.
+
+ The layout is:
+ - a FileHeader
+ - a KeyEntry for each key
+ - each key's prepared data, 8-byte aligned
+ The header holds a SHA-256 of everything after it.  Snapshots are in the byte order of
+ the machine that wrote them, and are refused by a machine with the other byte order.
+ Only keys of the standard sizes (1024, 2048, 3072 and 4096 bits) can be stored.
+ e.g.:
+ @code
+ //once, when the keys change
+ KeySnapshot::writeToFile(PEMBundleLoader::loadFile(bundleFile), snapshotFile);
+
+ //in every worker process
+ auto keys = KeySnapshot::loadFile(snapshotFile);
+ @endcode
+ */
+struct KeySnapshot
+{
+    static constexpr juce::uint32 currentVersion = 1;
+
+    /**
+     Writes the keys as a snapshot.
+     Returns false, writing nothing, if any of them isn't one of the standard sizes.
+     */
+    static bool write(const std::vector<PEMFormatKey>& keys, juce::MemoryBlock& result);
+
+    ///writes the snapshot to a temporary file and moves it over 'file', so processes that have the old one mapped aren't disturbed
+    static bool writeToFile(const std::vector<PEMFormatKey>& keys, const juce::File& file);
+
+    /**
+     Maps a snapshot and returns its keys, in the order they were written.
+     The mapping stays open until the last of the keys is destroyed.
+     Skipping the checksum means the pages of the file aren't touched until each key is first used,
+     but only the bounds of each key's data are checked then.
+     Returns an empty vector if the file isn't a snapshot this version can read.
+     */
+    static std::vector<PEMFormatKey> loadFile(const juce::File& file, bool verifyChecksum = true);
+private:
+    struct FileHeader
+    {
+        char magic[8];
+        juce::uint32 version;
+        ///0x01020304 as the writer stores it, to catch a snapshot from a machine with the other byte order
+        juce::uint32 byteOrderMark;
+        juce::uint32 numKeys;
+        juce::uint32 headerSize;
+        juce::uint64 fileSize;
+        ///SHA-256 of everything after the header
+        juce::uint8 checksum[32];
+    };
+
+    struct KeyEntry
+    {
+        juce::uint64 offset;
+        juce::uint64 size;
+    };
+
+    static constexpr char magic[8] = { 'R', 'S', 'A', 'S', 'N', 'A', 'P', 0 };
+    static constexpr juce::uint32 byteOrderMark = 0x01020304;
+    static constexpr size_t alignment = 8;
+
+    static size_t align(size_t offset) noexcept { return (offset + alignment - 1) & ~(alignment - 1); }
+};
@@ -0,0 +1,559 @@
+/*
+  ==============================================================================
+
+    Montgomery.cpp
+    Created: 17 Oct 2026 3:07:24pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "Montgomery.h"
+
+MontgomeryModulus::MontgomeryModulus(const juce::BigInteger& modulus)
+{
+    if( modulus.isNegative() || ! modulus[0] || modulus.getHighestBit() < 1 )
+    {
+        /*
+         Montgomery multiplication needs an odd modulus.
+         a key can be loaded without its checks, so this is left invalid rather than asserting,
+         and the key falls back to BigInteger arithmetic.
+         */
+        return;
+    }
+
+    numBits = modulus.getHighestBit() + 1;
+    numLimbs = (numBits + 31) / 32;
+
+    limbs.resize(static_cast<size_t>(numLimbs));
+    MontgomeryArithmetic::fromBigInteger(limbs.data(), numLimbs, modulus);
+
+    /*
+     n * n == 1 mod 8, so n is its own inverse to 3 bits.
+     each Newton step x = x * (2 - n * x) doubles the number of correct bits.
+     */
+    auto x = limbs[0];
+    for( int i = 0; i < 4; ++i )
+        x *= 2 - limbs[0] * x;
+
+    inverse = 0 - x;
+
+    juce::BigInteger r;
+    r.setBit(64 * numLimbs);
+    r %= modulus;
+    rSquared.resize(static_cast<size_t>(numLimbs));
+    MontgomeryArithmetic::fromBigInteger(rSquared.data(), numLimbs, r);
+
+    r.clear();
+    r.setBit(96 * numLimbs);
+    r %= modulus;
+    rCubed.resize(static_cast<size_t>(numLimbs));
+    MontgomeryArithmetic::fromBigInteger(rCubed.data(), numLimbs, r);
+}
+
+//==============================================================================
+WindowedExponent::WindowedExponent(const juce::BigInteger& exponent)
+{
+    auto topBit = exponent.getHighestBit();
+    if( topBit < 0 || exponent.isNegative() )
+    {
+        //a zero or negative exponent is left invalid, like a modulus Montgomery multiplication can't use
+        return;
+    }
+
+    windowBits = chooseWindowBits(topBit + 1);
+
+    /*
+     scan from the top bit down.
+     every window starts and ends with a set bit, so its value is odd and
+     the table only needs the odd powers of the base.
+     */
+    int numSquarings = 0;
+    for( int i = topBit; i >= 0; )
+    {
+        if( ! exponent[i] )
+        {
+            ++numSquarings;
+            --i;
+            continue;
+        }
+
+        auto j = juce::jmax(i - windowBits + 1, 0);
+        while( ! exponent[j] )
+            ++j;
+
+        int digit = 0;
+        for( int k = i; k >= j; --k )
+            digit = (digit << 1) | (exponent[k] ? 1 : 0);
+
+        numSquarings += i - j + 1;
+        jassert(numSquarings <= 0xffff);
+
+        Step step;
+        //the first window just loads the accumulator, so nothing needs squaring yet
+        step.numSquarings = static_cast<juce::uint16>(steps.empty() ? 0 : numSquarings);
+        step.digit = static_cast<juce::uint16>(digit);
+        steps.push_back(step);
+
+        numSquarings = 0;
+        i = j - 1;
+    }
+
+    if( numSquarings > 0 )
+    {
+        Step step;
+        step.numSquarings = static_cast<juce::uint16>(numSquarings);
+        steps.push_back(step);
+    }
+}
+
+int WindowedExponent::chooseWindowBits(int numExponentBits) noexcept
+{
+    if( numExponentBits > 671 ) return maxWindowBits;
+    if( numExponentBits > 239 ) return 5;
+    if( numExponentBits > 79 )  return 4;
+    if( numExponentBits > 23 )  return 3;
+    return 1;
+}
+
+//==============================================================================
+size_t MontgomeryArithmetic::getNumExponentiationLimbs(const MontgomeryModulus& modulus,
+                                                       const WindowedExponent& exponent) noexcept
+{
+    auto numLimbs = static_cast<size_t>(modulus.getNumLimbs());
+    return static_cast<size_t>(exponent.getTableSize()) * numLimbs + numLimbs + getNumScratchLimbs(modulus.getNumLimbs());
+}
+
+void MontgomeryArithmetic::multiply(juce::uint32* result,
+                                    const juce::uint32* a,
+                                    const juce::uint32* b,
+                                    const MontgomeryModulus& modulus,
+                                    juce::uint32* t) noexcept
+{
+    //Coarsely Integrated Operand Scanning: multiply and reduce one limb of 'b' at a time
+    const auto s = modulus.getNumLimbs();
+    const auto* n = modulus.getLimbs();
+    const auto inverse = modulus.getInverse();
+
+    std::fill(t, t + s + 2, 0u);
+
+    for( int i = 0; i < s; ++i )
+    {
+        juce::uint64 carry = 0;
+        const juce::uint64 bi = b[i];
+        for( int j = 0; j < s; ++j )
+        {
+            auto x = a[j] * bi + t[j] + carry;
+            t[j] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+
+        auto x = t[s] + carry;
+        t[s] = static_cast<juce::uint32>(x);
+        t[s + 1] = static_cast<juce::uint32>(x >> 32);
+
+        const juce::uint64 m = static_cast<juce::uint32>(t[0] * inverse);
+        carry = (m * n[0] + t[0]) >> 32;
+        for( int j = 1; j < s; ++j )
+        {
+            x = m * n[j] + t[j] + carry;
+            t[j - 1] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+
+        x = t[s] + carry;
+        t[s - 1] = static_cast<juce::uint32>(x);
+        t[s] = t[s + 1] + static_cast<juce::uint32>(x >> 32);
+    }
+
+    //t < 2n, so one subtraction is enough
+    if( t[s] != 0 || compare(t, n, s) >= 0 )
+        subtract(result, t, n, s);
+    else
+        std::copy(t, t + s, result);
+}
+
+void MontgomeryArithmetic::reduce(juce::uint32* result,
+                                  const juce::uint32* input,
+                                  int numTLimbs,
+                                  const MontgomeryModulus& modulus,
+                                  juce::uint32* t) noexcept
+{
+    const auto s = modulus.getNumLimbs();
+    const auto* n = modulus.getLimbs();
+    const auto inverse = modulus.getInverse();
+    jassert(numTLimbs <= 2 * s);
+
+    std::copy(input, input + numTLimbs, t);
+    std::fill(t + numTLimbs, t + 2 * s + 1, 0u);
+
+    for( int i = 0; i < s; ++i )
+    {
+        const juce::uint64 m = static_cast<juce::uint32>(t[i] * inverse);
+        juce::uint64 carry = 0;
+        for( int j = 0; j < s; ++j )
+        {
+            auto x = m * n[j] + t[i + j] + carry;
+            t[i + j] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+
+        for( int k = i + s; carry != 0 && k <= 2 * s; ++k )
+        {
+            auto x = t[k] + carry;
+            t[k] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+    }
+
+    auto* high = t + s;
+    if( high[s] != 0 || compare(high, n, s) >= 0 )
+        subtract(result, high, n, s);
+    else
+        std::copy(high, high + s, result);
+}
+
+void MontgomeryArithmetic::exponentiate(juce::uint32* result,
+                                        const juce::uint32* base,
+                                        const MontgomeryModulus& modulus,
+                                        const WindowedExponent& exponent,
+                                        juce::uint32* scratch) noexcept
+{
+    const auto s = static_cast<size_t>(modulus.getNumLimbs());
+    const auto tableSize = static_cast<size_t>(exponent.getTableSize());
+
+    auto* table = scratch;
+    auto* square = table + tableSize * s;
+    auto* t = square + s;
+
+    const auto& steps = exponent.getSteps();
+    if( steps.empty() )
+    {
+        //x^0 == 1, which is R mod n in Montgomery form
+        reduce(result, modulus.getRSquared(), modulus.getNumLimbs(), modulus, t);
+        return;
+    }
+
+    //table[k] = base^(2k + 1)
+    std::copy(base, base + s, table);
+    if( tableSize > 1 )
+    {
+        multiply(square, base, base, modulus, t);
+        for( size_t k = 1; k < tableSize; ++k )
+            multiply(table + k * s, table + (k - 1) * s, square, modulus, t);
+    }
+
+    const auto* first = table + (steps.front().digit >> 1) * s;
+    std::copy(first, first + s, result);
+
+    for( size_t i = 1; i < steps.size(); ++i )
+    {
+        const auto& step = steps[i];
+        for( int k = 0; k < step.numSquarings; ++k )
+            multiply(result, result, result, modulus, t);
+
+        if( step.digit != 0 )
+            multiply(result, result, table + (step.digit >> 1) * s, modulus, t);
+    }
+}
+
+void MontgomeryArithmetic::toMontgomery(juce::uint32* result,
+                                        const juce::uint32* a,
+                                        const MontgomeryModulus& modulus,
+                                        juce::uint32* scratch) noexcept
+{
+    multiply(result, a, modulus.getRSquared(), modulus, scratch);
+}
+
+void MontgomeryArithmetic::fromMontgomery(juce::uint32* result,
+                                          const juce::uint32* a,
+                                          const MontgomeryModulus& modulus,
+                                          juce::uint32* scratch) noexcept
+{
+    reduce(result, a, modulus.getNumLimbs(), modulus, scratch);
+}
+
+//==============================================================================
+int MontgomeryArithmetic::compare(const juce::uint32* a, const juce::uint32* b, int numLimbs) noexcept
+{
+    for( int i = numLimbs; --i >= 0; )
+    {
+        if( a[i] != b[i] )
+            return a[i] < b[i] ? -1 : 1;
+    }
+
+    return 0;
+}
+
+juce::uint32 MontgomeryArithmetic::subtract(juce::uint32* result,
+                                            const juce::uint32* a,
+                                            const juce::uint32* b,
+                                            int numLimbs) noexcept
+{
+    juce::uint64 borrow = 0;
+    for( int i = 0; i < numLimbs; ++i )
+    {
+        auto x = static_cast<juce::uint64>(a[i]) - b[i] - borrow;
+        result[i] = static_cast<juce::uint32>(x);
+        borrow = (x >> 32) & 1;
+    }
+
+    return static_cast<juce::uint32>(borrow);
+}
+
+juce::uint32 MontgomeryArithmetic::add(juce::uint32* result,
+                                       const juce::uint32* a,
+                                       const juce::uint32* b,
+                                       int numLimbs) noexcept
+{
+    juce::uint64 carry = 0;
+    for( int i = 0; i < numLimbs; ++i )
+    {
+        auto x = static_cast<juce::uint64>(a[i]) + b[i] + carry;
+        result[i] = static_cast<juce::uint32>(x);
+        carry = x >> 32;
+    }
+
+    return static_cast<juce::uint32>(carry);
+}
+
+void MontgomeryArithmetic::multiplyFull(juce::uint32* result,
+                                        const juce::uint32* a, int numALimbs,
+                                        const juce::uint32* b, int numBLimbs) noexcept
+{
+    std::fill(result, result + numALimbs + numBLimbs, 0u);
+
+    for( int i = 0; i < numBLimbs; ++i )
+    {
+        juce::uint64 carry = 0;
+        const juce::uint64 bi = b[i];
+        for( int j = 0; j < numALimbs; ++j )
+        {
+            auto x = a[j] * bi + result[i + j] + carry;
+            result[i + j] = static_cast<juce::uint32>(x);
+            carry = x >> 32;
+        }
+
+        result[i + numALimbs] = static_cast<juce::uint32>(carry);
+    }
+}
+
+//==============================================================================
+void MontgomeryArithmetic::fromBigInteger(juce::uint32* limbs, int numLimbs, const juce::BigInteger& value)
+{
+    jassert(! value.isNegative() && value.getHighestBit() < numLimbs * 32);
+
+    for( int i = 0; i < numLimbs; ++i )
+        limbs[i] = value.getBitRangeAsInt(i * 32, 32);
+}
+
+juce::BigInteger MontgomeryArithmetic::toBigInteger(const juce::uint32* limbs, int numLimbs)
+{
+    //most significant limb first, so the BigInteger only allocates once
+    juce::BigInteger result;
+    for( int i = numLimbs; --i >= 0; )
+    {
+        if( limbs[i] != 0 )
+            result.setBitRangeAsInt(i * 32, 32, limbs[i]);
+    }
+
+    return result;
+}
+
+int MontgomeryArithmetic::getNumSignificantBits(const juce::uint32* limbs, int numLimbs) noexcept
+{
+    for( int i = numLimbs; --i >= 0; )
+    {
+        if( auto limb = limbs[i] )
+        {
+            int numBits = 0;
+            while( limb != 0 )
+            {
+                ++numBits;
+                limb >>= 1;
+            }
+
+            return i * 32 + numBits;
+        }
+    }
+
+    return 0;
+}
+
+bool MontgomeryArithmetic::fromBigEndianBytes(juce::uint32* limbs,
+                                              int numLimbs,
+                                              const void* data,
+                                              size_t numBytes) noexcept
+{
+    auto bytes = static_cast<const juce::uint8*>(data);
+    while( numBytes > 0 && *bytes == 0 )
+    {
+        ++bytes;
+        --numBytes;
+    }
+
+    if( numBytes > static_cast<size_t>(numLimbs) * 4 )
+        return false;
+
+    std::fill(limbs, limbs + numLimbs, 0u);
+    for( size_t i = 0; i < numBytes; ++i )
+        limbs[i / 4] |= static_cast<juce::uint32>(bytes[numBytes - 1 - i]) << ((i % 4) * 8);
+
+    return true;
+}
+
+bool MontgomeryArithmetic::toBigEndianBytes(void* data,
+                                            size_t numBytes,
+                                            const juce::uint32* limbs,
+                                            int numLimbs) noexcept
+{
+    if( static_cast<size_t>(getNumSignificantBits(limbs, numLimbs)) > numBytes * 8 )
+        return false;
+
+    auto bytes = static_cast<juce::uint8*>(data);
+    for( size_t i = 0; i < numBytes; ++i )
+    {
+        auto limbIndex = i / 4;
+        bytes[numBytes - 1 - i] = limbIndex < static_cast<size_t>(numLimbs)
+                                      ? static_cast<juce::uint8>(limbs[limbIndex] >> ((i % 4) * 8))
+                                      : 0;
+    }
+
+    return true;
+}
+
+//==============================================================================
+MontgomeryKeyContext::MontgomeryKeyContext(const juce::BigInteger& modulus_, const juce::BigInteger& exponent_) :
+modulus(modulus_),
+exponent(exponent_)
+{
+    if( ! exponent.isValid() )
+    {
+        modulus = {};
+        return;
+    }
+
+    numScratchLimbs = static_cast<size_t>(modulus.getNumLimbs())
+                      + MontgomeryArithmetic::getNumExponentiationLimbs(modulus, exponent);
+}
+
+MontgomeryKeyContext::MontgomeryKeyContext(const juce::BigInteger& modulus_,
+                                           const juce::BigInteger& privateExponent,
+                                           const juce::BigInteger& prime1,
+                                           const juce::BigInteger& prime2,
+                                           const juce::BigInteger& exponent1,
+                                           const juce::BigInteger& exponent2,
+                                           const juce::BigInteger& coefficient) :
+modulus(modulus_)
+{
+    /*
+     the CRT path reduces the full-size input straight into each prime's Montgomery form,
+     which only works when both primes have the same number of limbs and the modulus is
+     no wider than the two of them together.  a key loaded without validation can have a
+     modulus that isn't p * q at all, and recombining would then give the wrong answer.
+     anything else uses the private exponent with the full modulus.
+     */
+    auto canUseCRT = modulus.isValid()
+                     && prime1[0] && prime2[0]
+                     && (prime1.getHighestBit() / 32) == (prime2.getHighestBit() / 32)
+                     && coefficient < prime1
+                     && prime1 * prime2 == modulus_;
+
+    if( canUseCRT )
+    {
+        crtModulus1 = MontgomeryModulus(prime1);
+        crtModulus2 = MontgomeryModulus(prime2);
+        crtExponent1 = WindowedExponent(exponent1);
+        crtExponent2 = WindowedExponent(exponent2);
+
+        auto numPrimeLimbs = crtModulus1.getNumLimbs();
+        crtCoefficient.resize(static_cast<size_t>(numPrimeLimbs));
+        MontgomeryArithmetic::fromBigInteger(crtCoefficient.data(), numPrimeLimbs, coefficient);
+
+        canUseCRT = crtModulus1.isValid() && crtModulus2.isValid() && crtExponent1.isValid() && crtExponent2.isValid()
+                    && modulus.getNumLimbs() <= 2 * numPrimeLimbs;
+    }
+
+    if( canUseCRT )
+    {
+        auto numPrimeLimbs = static_cast<size_t>(crtModulus1.getNumLimbs());
+        numScratchLimbs = numPrimeLimbs * 6
+                          + juce::jmax(MontgomeryArithmetic::getNumExponentiationLimbs(crtModulus1, crtExponent1),
+                                       MontgomeryArithmetic::getNumExponentiationLimbs(crtModulus2, crtExponent2));
+        return;
+    }
+
+    crtModulus1 = crtModulus2 = {};
+    crtExponent1 = crtExponent2 = {};
+    crtCoefficient.clear();
+
+    *this = MontgomeryKeyContext(modulus_, privateExponent);
+}
+
+bool MontgomeryKeyContext::apply(juce::uint32* value, juce::uint32* scratch) const noexcept
+{
+    if( ! isValid() || MontgomeryArithmetic::compare(value, modulus.getLimbs(), modulus.getNumLimbs()) >= 0 )
+        return false;
+
+    if( usesCRT() )
+        applyCRT(value, scratch);
+    else
+        applyDirect(value, scratch);
+
+    return true;
+}
+
+void MontgomeryKeyContext::applyDirect(juce::uint32* value, juce::uint32* scratch) const noexcept
+{
+    auto* base = scratch;
+    auto* rest = base + modulus.getNumLimbs();
+
+    MontgomeryArithmetic::toMontgomery(base, value, modulus, rest);
+    MontgomeryArithmetic::exponentiate(value, base, modulus, exponent, rest);
+    MontgomeryArithmetic::fromMontgomery(value, value, modulus, rest);
+}
+
+void MontgomeryKeyContext::applyCRT(juce::uint32* value, juce::uint32* scratch) const noexcept
+{
+    const auto numLimbs = modulus.getNumLimbs();
+    const auto s = crtModulus1.getNumLimbs();
+
+    auto* base = scratch;
+    auto* m1 = base + s;
+    auto* m2 = m1 + s;
+    auto* h = m2 + s;
+    auto* product = h + s; //2s limbs
+    auto* rest = product + 2 * s;
+
+    /*
+     c < n < p * R, so reducing c gives c * R^-1 mod p,
+     and a Montgomery multiply by R^3 turns that into c * R mod p.
+     */
+    MontgomeryArithmetic::reduce(h, value, numLimbs, crtModulus1, rest);
+    MontgomeryArithmetic::multiply(base, h, crtModulus1.getRCubed(), crtModulus1, rest);
+    MontgomeryArithmetic::exponentiate(m1, base, crtModulus1, crtExponent1, rest); // m1 = c^dP mod p, Montgomery form
+
+    MontgomeryArithmetic::reduce(h, value, numLimbs, crtModulus2, rest);
+    MontgomeryArithmetic::multiply(base, h, crtModulus2.getRCubed(), crtModulus2, rest);
+    MontgomeryArithmetic::exponentiate(m2, base, crtModulus2, crtExponent2, rest);
+    MontgomeryArithmetic::fromMontgomery(m2, m2, crtModulus2, rest); // m2 = c^dQ mod q
+
+    //h = qInv * (m1 - m2) mod p.  m2 is moved into p's Montgomery form first, and the multiply by qInv moves the difference back out
+    MontgomeryArithmetic::toMontgomery(h, m2, crtModulus1, rest);
+    if( MontgomeryArithmetic::subtract(h, m1, h, s) != 0 )
+        MontgomeryArithmetic::add(h, h, crtModulus1.getLimbs(), s);
+
+    MontgomeryArithmetic::multiply(h, h, crtCoefficient.data(), crtModulus1, rest);
+
+    //m = m2 + h * q
+    MontgomeryArithmetic::multiplyFull(product, h, s, crtModulus2.getLimbs(), s);
+    auto carry = MontgomeryArithmetic::add(product, product, m2, s);
+    for( int i = s; carry != 0 && i < 2 * s; ++i )
+    {
+        product[i] += carry;
+        carry = product[i] == 0 ? 1 : 0;
+    }
+
+    jassert(MontgomeryArithmetic::getNumSignificantBits(product, 2 * s) <= numLimbs * 32);
+    std::copy(product, product + numLimbs, value);
+}
@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    Montgomery.h
+    Created: 17 Oct 2026 3:07:24pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ All the numbers in here are arrays of 32-bit limbs, least significant limb first.
+ A number "in Montgomery form" is x * R mod n, where R = 2^(32 * numLimbs).
+ */
+
+/**
+ An odd modulus together with the constants Montgomery multiplication needs,
+ computed once when the modulus is created.
+ */
+struct MontgomeryModulus
+{
+    MontgomeryModulus() = default;
+
+    ///'modulus' must be odd and greater than 1.  any other leaves it invalid
+    explicit MontgomeryModulus(const juce::BigInteger& modulus);
+
+    bool isValid() const noexcept { return numLimbs > 0; }
+
+    int getNumLimbs() const noexcept { return numLimbs; }
+    int getNumBits() const noexcept { return numBits; }
+
+    const juce::uint32* getLimbs() const noexcept { return limbs.data(); }
+    ///-n^-1 mod 2^32
+    juce::uint32 getInverse() const noexcept { return inverse; }
+    ///R^2 mod n, used to move numbers into Montgomery form
+    const juce::uint32* getRSquared() const noexcept { return rSquared.data(); }
+    ///R^3 mod n, used to move a reduced double-width number into Montgomery form
+    const juce::uint32* getRCubed() const noexcept { return rCubed.data(); }
+private:
+    int numLimbs = 0;
+    int numBits = 0;
+    juce::uint32 inverse = 0;
+    std::vector<juce::uint32> limbs, rSquared, rCubed;
+};
+
+/**
+ An exponent recoded for sliding-window exponentiation.
+ Recoding a fixed exponent (like a private key's d) once means the bit scanning
+ is not repeated for every exponentiation.
+ */
+struct WindowedExponent
+{
+    struct Step
+    {
+        ///the number of squarings to do first
+        juce::uint16 numSquarings = 0;
+        ///an odd power of the base to multiply by afterwards, or 0 for none
+        juce::uint16 digit = 0;
+    };
+
+    WindowedExponent() = default;
+
+    ///'exponent' must be positive.  any other leaves it invalid
+    explicit WindowedExponent(const juce::BigInteger& exponent);
+
+    bool isValid() const noexcept { return ! steps.empty(); }
+
+    ///the widest window chooseWindowBits() picks, and the size of its table
+    static constexpr int maxWindowBits = 6;
+    static constexpr int maxTableSize = 1 << (maxWindowBits - 1);
+
+    int getWindowBits() const noexcept { return windowBits; }
+    ///the number of odd powers of the base the exponentiation needs: base^1, base^3 ... base^(2^windowBits - 1)
+    int getTableSize() const noexcept { return 1 << (windowBits - 1); }
+    const std::vector<Step>& getSteps() const noexcept { return steps; }
+
+    ///picks the window size that needs the fewest multiplications for an exponent of this size
+    static int chooseWindowBits(int numExponentBits) noexcept;
+private:
+    int windowBits = 1;
+    std::vector<Step> steps;
+};
+
+/**
+ The arithmetic behind the Montgomery engine.
+ None of these functions allocate: the scratch space they need is passed in.
+ */
+struct MontgomeryArithmetic
+{
+    ///the number of scratch limbs multiply() and reduce() need for a modulus of this size
+    static constexpr size_t getNumScratchLimbs(int numLimbs) noexcept { return static_cast<size_t>(numLimbs) * 2 + 2; }
+
+    ///the number of scratch limbs exponentiate() needs
+    static size_t getNumExponentiationLimbs(const MontgomeryModulus& modulus, const WindowedExponent& exponent) noexcept;
+
+    /**
+     result = a * b * R^-1 mod n.
+     'a' may be any number below R, 'b' must be below n.  'result' may alias 'a' or 'b'.
+     */
+    static void multiply(juce::uint32* result,
+                         const juce::uint32* a,
+                         const juce::uint32* b,
+                         const MontgomeryModulus& modulus,
+                         juce::uint32* scratch) noexcept;
+
+    /**
+     result = t * R^-1 mod n, for a number t of up to 2 * numLimbs limbs that is below n * R.
+     */
+    static void reduce(juce::uint32* result,
+                       const juce::uint32* t,
+                       int numTLimbs,
+                       const MontgomeryModulus& modulus,
+                       juce::uint32* scratch) noexcept;
+
+    ///result = base^exponent, with 'base' and 'result' in Montgomery form
+    static void exponentiate(juce::uint32* result,
+                             const juce::uint32* base,
+                             const MontgomeryModulus& modulus,
+                             const WindowedExponent& exponent,
+                             juce::uint32* scratch) noexcept;
+
+    static void toMontgomery(juce::uint32* result, const juce::uint32* a, const MontgomeryModulus& modulus, juce::uint32* scratch) noexcept;
+    static void fromMontgomery(juce::uint32* result, const juce::uint32* a, const MontgomeryModulus& modulus, juce::uint32* scratch) noexcept;
+
+    //==============================================================================
+    static int compare(const juce::uint32* a, const juce::uint32* b, int numLimbs) noexcept;
+    ///result = a - b, returns the borrow
+    static juce::uint32 subtract(juce::uint32* result, const juce::uint32* a, const juce::uint32* b, int numLimbs) noexcept;
+    ///result = a + b, returns the carry
+    static juce::uint32 add(juce::uint32* result, const juce::uint32* a, const juce::uint32* b, int numLimbs) noexcept;
+    ///result (numALimbs + numBLimbs limbs) = a * b
+    static void multiplyFull(juce::uint32* result,
+                             const juce::uint32* a, int numALimbs,
+                             const juce::uint32* b, int numBLimbs) noexcept;
+
+    //==============================================================================
+    static void fromBigInteger(juce::uint32* limbs, int numLimbs, const juce::BigInteger& value);
+    static juce::BigInteger toBigInteger(const juce::uint32* limbs, int numLimbs);
+
+    ///returns the position of the highest set bit plus one, or 0 for zero
+    static int getNumSignificantBits(const juce::uint32* limbs, int numLimbs) noexcept;
+
+    ///returns false if the value doesn't fit in 'numLimbs' limbs
+    static bool fromBigEndianBytes(juce::uint32* limbs, int numLimbs, const void* bytes, size_t numBytes) noexcept;
+    ///returns false if the value doesn't fit in 'numBytes' bytes
+    static bool toBigEndianBytes(void* bytes, size_t numBytes, const juce::uint32* limbs, int numLimbs) noexcept;
+};
+
+/**
+ Everything needed to apply one RSA key with Montgomery arithmetic, prepared once at load time.
+
+ A private key with CRT components does two half-size exponentiations and recombines them,
+ anything else does one exponentiation with the full modulus.
+ The context is never modified after it has been created, so one context can be used
+ from any number of threads as long as each call gets its own scratch space.
+ */
+struct MontgomeryKeyContext
+{
+    MontgomeryKeyContext() = default;
+
+    ///a key that computes value^exponent mod modulus
+    MontgomeryKeyContext(const juce::BigInteger& modulus, const juce::BigInteger& exponent);
+
+    ///a private key that uses the Chinese Remainder Theorem
+    MontgomeryKeyContext(const juce::BigInteger& modulus,
+                         const juce::BigInteger& privateExponent,
+                         const juce::BigInteger& prime1,
+                         const juce::BigInteger& prime2,
+                         const juce::BigInteger& exponent1,
+                         const juce::BigInteger& exponent2,
+                         const juce::BigInteger& coefficient);
+
+    bool isValid() const noexcept { return modulus.isValid(); }
+    bool usesCRT() const noexcept { return crtModulus1.isValid(); }
+
+    int getNumLimbs() const noexcept { return modulus.getNumLimbs(); }
+    ///the number of bytes needed to hold a value below the modulus
+    size_t getNumBytes() const noexcept { return static_cast<size_t>(modulus.getNumBits() + 7) / 8; }
+
+    ///the number of scratch limbs apply() needs
+    size_t getNumScratchLimbs() const noexcept { return numScratchLimbs; }
+
+    /**
+     The most scratch apply() can need for a modulus of this many limbs, whatever the exponent:
+     the direct path with the widest window.  The CRT path works on primes of half the size, so needs less.
+     */
+    static constexpr size_t getMaxNumScratchLimbs(int numModulusLimbs) noexcept
+    {
+        return static_cast<size_t>(numModulusLimbs) * (WindowedExponent::maxTableSize + 2)
+               + MontgomeryArithmetic::getNumScratchLimbs(numModulusLimbs);
+    }
+
+    /**
+     Replaces 'value' (getNumLimbs() limbs) with the result of applying the key to it.
+     Returns false if the value isn't below the modulus.
+     */
+    bool apply(juce::uint32* value, juce::uint32* scratch) const noexcept;
+private:
+    MontgomeryModulus modulus;
+    WindowedExponent exponent;
+
+    MontgomeryModulus crtModulus1, crtModulus2; // p, q
+    WindowedExponent crtExponent1, crtExponent2; // d mod (p - 1), d mod (q - 1)
+    std::vector<juce::uint32> crtCoefficient; // q^-1 mod p
+
+    size_t numScratchLimbs = 0;
+
+    void applyDirect(juce::uint32* value, juce::uint32* scratch) const noexcept;
+    void applyCRT(juce::uint32* value, juce::uint32* scratch) const noexcept;
+};
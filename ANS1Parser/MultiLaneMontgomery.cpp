@@ -0,0 +1,596 @@
+/*
+  ==============================================================================
+
+    MultiLaneMontgomery.cpp
+    Created: 18 Oct 2026 12:41:15am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "MultiLaneMontgomery.h"
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+
+ #if JUCE_GCC || JUCE_CLANG
+  #define LANES_TARGET(isa) __attribute__((target(isa)))
+ #else
+  #define LANES_TARGET(isa)
+ #endif
+#endif
+
+namespace
+{
+using Word = juce::uint64;
+
+/*
+ A kernel does one Montgomery multiplication on every lane at once.
+ Numbers are interleaved: limb k of lane l is at [k * numLanes + l], and each limb has
+ 'limbBits' bits in a 64-bit word.  Every kernel has
+
+     static constexpr int numLanes, limbBits;
+     static void multiply(Word* result, const Word* a, const Word* b,
+                          const Word* modulus, Word inverse, int numLimbs, Word* t) noexcept;
+
+ where 'modulus' is the plain (not interleaved) limbs of the modulus, 'inverse' is
+ -modulus^-1 mod 2^limbBits and 't' has room for (numLimbs + 2) * numLanes words.
+ a and b are below the modulus and so is the result.  'result' may alias 'a' or 'b'.
+ */
+
+///32-bit limbs, one lane: the same steps as the vector kernels, for CPUs without them
+struct ScalarKernel
+{
+    static constexpr int numLanes = 1;
+    static constexpr int limbBits = 32;
+
+    static void multiply(Word* result, const Word* a, const Word* b, const Word* modulus, Word inverse, int numLimbs, Word* t) noexcept
+    {
+        const Word mask = 0xffffffff;
+        std::fill(t, t + numLimbs + 2, Word());
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            Word carry = 0;
+            const auto bi = b[i];
+            for( int j = 0; j < numLimbs; ++j )
+            {
+                auto x = a[j] * bi + t[j] + carry;
+                t[j] = x & mask;
+                carry = x >> 32;
+            }
+
+            auto x = t[numLimbs] + carry;
+            t[numLimbs] = x & mask;
+            t[numLimbs + 1] = x >> 32;
+
+            const auto m = (t[0] * inverse) & mask;
+            carry = (m * modulus[0] + t[0]) >> 32;
+            for( int j = 1; j < numLimbs; ++j )
+            {
+                x = m * modulus[j] + t[j] + carry;
+                t[j - 1] = x & mask;
+                carry = x >> 32;
+            }
+
+            x = t[numLimbs] + carry;
+            t[numLimbs - 1] = x & mask;
+            t[numLimbs] = t[numLimbs + 1] + (x >> 32);
+        }
+
+        //t - n borrows out of the top limb exactly when t < n, in which case t is kept
+        Word borrow = 0;
+        for( int j = 0; j < numLimbs; ++j )
+            borrow = (t[j] - modulus[j] - borrow) >> 63;
+
+        const auto keep = ((t[numLimbs] - borrow) >> 63) != 0;
+
+        borrow = 0;
+        for( int j = 0; j < numLimbs; ++j )
+        {
+            const auto d = t[j] - modulus[j] - borrow;
+            borrow = d >> 63;
+            result[j] = keep ? t[j] : (d & mask);
+        }
+    }
+};
+
+#if JUCE_INTEL
+/*
+ The 32-bit kernels keep each limb in the low half of a 64-bit element, where the unsigned
+ 32 x 32 -> 64-bit multiply (vpmuludq) reads it.  A product plus a limb plus a carry still
+ fits in 64 bits, so every step is multiply, add, add, then mask and shift to split off the carry.
+
+ The last subtraction is done in every lane, and each lane keeps whichever of t and t - n
+ is right for it, so the lanes never branch apart.
+ */
+struct AVX2Kernel
+{
+    static constexpr int numLanes = 4;
+    static constexpr int limbBits = 32;
+
+    LANES_TARGET("avx2")
+    static __m256i load(const Word* p) noexcept { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+
+    LANES_TARGET("avx2")
+    static void store(Word* p, __m256i value) noexcept { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), value); }
+
+    LANES_TARGET("avx2")
+    static __m256i broadcast(Word value) noexcept { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+
+    LANES_TARGET("avx2")
+    static void multiply(Word* result, const Word* a, const Word* b, const Word* modulus, Word inverse, int numLimbs, Word* t) noexcept
+    {
+        const auto mask = broadcast(0xffffffff);
+        const auto inv = broadcast(inverse);
+        const auto zero = _mm256_setzero_si256();
+
+        for( int j = 0; j < numLimbs + 2; ++j )
+            store(t + j * numLanes, zero);
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            const auto bi = load(b + i * numLanes);
+            auto carry = zero;
+            for( int j = 0; j < numLimbs; ++j )
+            {
+                auto x = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(load(a + j * numLanes), bi),
+                                                           load(t + j * numLanes)),
+                                          carry);
+                store(t + j * numLanes, _mm256_and_si256(x, mask));
+                carry = _mm256_srli_epi64(x, 32);
+            }
+
+            auto x = _mm256_add_epi64(load(t + numLimbs * numLanes), carry);
+            store(t + numLimbs * numLanes, _mm256_and_si256(x, mask));
+            store(t + (numLimbs + 1) * numLanes, _mm256_srli_epi64(x, 32));
+
+            const auto m = _mm256_and_si256(_mm256_mul_epu32(load(t), inv), mask);
+            x = _mm256_add_epi64(_mm256_mul_epu32(m, broadcast(modulus[0])), load(t));
+            carry = _mm256_srli_epi64(x, 32);
+            for( int j = 1; j < numLimbs; ++j )
+            {
+                x = _mm256_add_epi64(_mm256_add_epi64(_mm256_mul_epu32(m, broadcast(modulus[j])),
+                                                      load(t + j * numLanes)),
+                                     carry);
+                store(t + (j - 1) * numLanes, _mm256_and_si256(x, mask));
+                carry = _mm256_srli_epi64(x, 32);
+            }
+
+            x = _mm256_add_epi64(load(t + numLimbs * numLanes), carry);
+            store(t + (numLimbs - 1) * numLanes, _mm256_and_si256(x, mask));
+            store(t + numLimbs * numLanes, _mm256_add_epi64(load(t + (numLimbs + 1) * numLanes), _mm256_srli_epi64(x, 32)));
+        }
+
+        //the lanes where t - n borrows out of the top limb are the ones where t < n, which keep t
+        auto borrow = zero;
+        for( int j = 0; j < numLimbs; ++j )
+            borrow = _mm256_srli_epi64(_mm256_sub_epi64(_mm256_sub_epi64(load(t + j * numLanes), broadcast(modulus[j])), borrow), 63);
+
+        const auto top = _mm256_sub_epi64(load(t + numLimbs * numLanes), borrow);
+        const auto keep = _mm256_sub_epi64(zero, _mm256_srli_epi64(top, 63));
+
+        borrow = zero;
+        for( int j = 0; j < numLimbs; ++j )
+        {
+            const auto tj = load(t + j * numLanes);
+            const auto d = _mm256_sub_epi64(_mm256_sub_epi64(tj, broadcast(modulus[j])), borrow);
+            borrow = _mm256_srli_epi64(d, 63);
+            store(result + j * numLanes, _mm256_or_si256(_mm256_and_si256(keep, tj),
+                                                         _mm256_andnot_si256(keep, _mm256_and_si256(d, mask))));
+        }
+    }
+};
+
+///the AVX2 kernel with twice as many lanes
+struct AVX512Kernel
+{
+    static constexpr int numLanes = 8;
+    static constexpr int limbBits = 32;
+
+    LANES_TARGET("avx512f")
+    static __m512i load(const Word* p) noexcept { return _mm512_loadu_si512(p); }
+
+    LANES_TARGET("avx512f")
+    static void store(Word* p, __m512i value) noexcept { _mm512_storeu_si512(p, value); }
+
+    LANES_TARGET("avx512f")
+    static __m512i broadcast(Word value) noexcept { return _mm512_set1_epi64(static_cast<long long>(value)); }
+
+    LANES_TARGET("avx512f")
+    static void multiply(Word* result, const Word* a, const Word* b, const Word* modulus, Word inverse, int numLimbs, Word* t) noexcept
+    {
+        const auto mask = broadcast(0xffffffff);
+        const auto inv = broadcast(inverse);
+        const auto zero = _mm512_setzero_si512();
+
+        for( int j = 0; j < numLimbs + 2; ++j )
+            store(t + j * numLanes, zero);
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            const auto bi = load(b + i * numLanes);
+            auto carry = zero;
+            for( int j = 0; j < numLimbs; ++j )
+            {
+                auto x = _mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(load(a + j * numLanes), bi),
+                                                           load(t + j * numLanes)),
+                                          carry);
+                store(t + j * numLanes, _mm512_and_si512(x, mask));
+                carry = _mm512_srli_epi64(x, 32);
+            }
+
+            auto x = _mm512_add_epi64(load(t + numLimbs * numLanes), carry);
+            store(t + numLimbs * numLanes, _mm512_and_si512(x, mask));
+            store(t + (numLimbs + 1) * numLanes, _mm512_srli_epi64(x, 32));
+
+            const auto m = _mm512_and_si512(_mm512_mul_epu32(load(t), inv), mask);
+            x = _mm512_add_epi64(_mm512_mul_epu32(m, broadcast(modulus[0])), load(t));
+            carry = _mm512_srli_epi64(x, 32);
+            for( int j = 1; j < numLimbs; ++j )
+            {
+                x = _mm512_add_epi64(_mm512_add_epi64(_mm512_mul_epu32(m, broadcast(modulus[j])),
+                                                      load(t + j * numLanes)),
+                                     carry);
+                store(t + (j - 1) * numLanes, _mm512_and_si512(x, mask));
+                carry = _mm512_srli_epi64(x, 32);
+            }
+
+            x = _mm512_add_epi64(load(t + numLimbs * numLanes), carry);
+            store(t + (numLimbs - 1) * numLanes, _mm512_and_si512(x, mask));
+            store(t + numLimbs * numLanes, _mm512_add_epi64(load(t + (numLimbs + 1) * numLanes), _mm512_srli_epi64(x, 32)));
+        }
+
+        auto borrow = zero;
+        for( int j = 0; j < numLimbs; ++j )
+            borrow = _mm512_srli_epi64(_mm512_sub_epi64(_mm512_sub_epi64(load(t + j * numLanes), broadcast(modulus[j])), borrow), 63);
+
+        const auto top = _mm512_sub_epi64(load(t + numLimbs * numLanes), borrow);
+        const auto keep = _mm512_sub_epi64(zero, _mm512_srli_epi64(top, 63));
+
+        borrow = zero;
+        for( int j = 0; j < numLimbs; ++j )
+        {
+            const auto tj = load(t + j * numLanes);
+            const auto d = _mm512_sub_epi64(_mm512_sub_epi64(tj, broadcast(modulus[j])), borrow);
+            borrow = _mm512_srli_epi64(d, 63);
+            store(result + j * numLanes, _mm512_or_si512(_mm512_and_si512(keep, tj),
+                                                         _mm512_andnot_si512(keep, _mm512_and_si512(d, mask))));
+        }
+    }
+};
+
+/*
+ 52-bit limbs, multiplied with vpmadd52luq/vpmadd52huq, which add the low or the high
+ 52 bits of a 52 x 52-bit product to a 64-bit accumulator.
+ The accumulators are left unnormalised while the rows go by: each row adds less than 2^54
+ to a limb and a limb lives for at most numLimbs rows, which leaves room to spare in 64 bits.
+ The multiply and the reduction share one pass over the limbs, and the carries are only
+ propagated once, at the end.
+ */
+struct AVX512IFMAKernel
+{
+    static constexpr int numLanes = 8;
+    static constexpr int limbBits = 52;
+
+    LANES_TARGET("avx512f,avx512ifma")
+    static __m512i load(const Word* p) noexcept { return _mm512_loadu_si512(p); }
+
+    LANES_TARGET("avx512f,avx512ifma")
+    static void store(Word* p, __m512i value) noexcept { _mm512_storeu_si512(p, value); }
+
+    LANES_TARGET("avx512f,avx512ifma")
+    static __m512i broadcast(Word value) noexcept { return _mm512_set1_epi64(static_cast<long long>(value)); }
+
+    LANES_TARGET("avx512f,avx512ifma")
+    static void multiply(Word* result, const Word* a, const Word* b, const Word* modulus, Word inverse, int numLimbs, Word* t) noexcept
+    {
+        const auto mask = broadcast((Word(1) << 52) - 1);
+        const auto k0 = broadcast(inverse);
+        const auto zero = _mm512_setzero_si512();
+
+        for( int j = 0; j < numLimbs; ++j )
+            store(t + j * numLanes, zero);
+
+        for( int i = 0; i < numLimbs; ++i )
+        {
+            const auto bi = load(b + i * numLanes);
+            const auto a0 = load(a);
+            const auto n0 = broadcast(modulus[0]);
+
+            //t + a * b[i] + m * n is a multiple of 2^52, so limb 0 only leaves a carry, and everything moves down a limb
+            auto t0 = _mm512_madd52lo_epu64(load(t), a0, bi);
+            const auto m = _mm512_madd52lo_epu64(zero, t0, k0);
+            t0 = _mm512_madd52lo_epu64(t0, m, n0);
+
+            auto high = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(_mm512_srli_epi64(t0, 52), a0, bi), m, n0);
+            for( int j = 1; j < numLimbs; ++j )
+            {
+                const auto aj = load(a + j * numLanes);
+                const auto nj = broadcast(modulus[j]);
+
+                auto x = _mm512_add_epi64(load(t + j * numLanes), high);
+                x = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(x, aj, bi), m, nj);
+                high = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(zero, aj, bi), m, nj);
+                store(t + (j - 1) * numLanes, x);
+            }
+
+            store(t + (numLimbs - 1) * numLanes, high);
+        }
+
+        auto carry = zero;
+        for( int j = 0; j < numLimbs; ++j )
+        {
+            const auto x = _mm512_add_epi64(load(t + j * numLanes), carry);
+            store(t + j * numLanes, _mm512_and_si512(x, mask));
+            carry = _mm512_srli_epi64(x, 52);
+        }
+
+        auto borrow = zero;
+        for( int j = 0; j < numLimbs; ++j )
+            borrow = _mm512_srli_epi64(_mm512_sub_epi64(_mm512_sub_epi64(load(t + j * numLanes), broadcast(modulus[j])), borrow), 63);
+
+        const auto top = _mm512_sub_epi64(carry, borrow);
+        const auto keep = _mm512_sub_epi64(zero, _mm512_srli_epi64(top, 63));
+
+        borrow = zero;
+        for( int j = 0; j < numLimbs; ++j )
+        {
+            const auto tj = load(t + j * numLanes);
+            const auto d = _mm512_sub_epi64(_mm512_sub_epi64(tj, broadcast(modulus[j])), borrow);
+            borrow = _mm512_srli_epi64(d, 63);
+            store(result + j * numLanes, _mm512_or_si512(_mm512_and_si512(keep, tj),
+                                                         _mm512_andnot_si512(keep, _mm512_and_si512(d, mask))));
+        }
+    }
+};
+#endif
+
+//==============================================================================
+int getLimbBits(MultiLaneMontgomery::Implementation implementation) noexcept
+{
+    return implementation == MultiLaneMontgomery::Implementation::avx512ifma ? 52 : 32;
+}
+
+int getNumKernelLimbs(int numLimbs, int limbBits) noexcept
+{
+    return (numLimbs * 32 + limbBits - 1) / limbBits;
+}
+
+Word getBitMask(int numBits) noexcept
+{
+    return numBits >= 64 ? ~Word() : (Word(1) << numBits) - 1;
+}
+
+///splits 32-bit limbs into 'numDestLimbs' limbs of 'destBits' bits, 'stride' words apart
+void fromLimbs32(const juce::uint32* source, int numLimbs, Word* dest, int numDestLimbs, int stride, int destBits) noexcept
+{
+    for( int k = 0; k < numDestLimbs; ++k )
+    {
+        Word limb = 0;
+        for( int bit = 0; bit < destBits; )
+        {
+            auto sourceBit = k * destBits + bit;
+            auto index = sourceBit / 32;
+            if( index >= numLimbs )
+                break;
+
+            auto shift = sourceBit % 32;
+            auto numTaken = juce::jmin(32 - shift, destBits - bit);
+            limb |= ((static_cast<Word>(source[index]) >> shift) & getBitMask(numTaken)) << bit;
+            bit += numTaken;
+        }
+
+        dest[k * stride] = limb;
+    }
+}
+
+///the reverse of fromLimbs32().  the value must fit in 'numLimbs' 32-bit limbs
+void toLimbs32(const Word* source, int numSourceLimbs, int stride, int sourceBits, juce::uint32* dest, int numLimbs) noexcept
+{
+    std::fill(dest, dest + numLimbs, 0u);
+
+    for( int k = 0; k < numSourceLimbs; ++k )
+    {
+        auto limb = source[k * stride];
+        for( int bit = 0; bit < sourceBits; )
+        {
+            auto destBit = k * sourceBits + bit;
+            auto index = destBit / 32;
+            if( index >= numLimbs )
+                break;
+
+            auto shift = destBit % 32;
+            auto numTaken = juce::jmin(32 - shift, sourceBits - bit);
+            dest[index] |= static_cast<juce::uint32>((limb >> bit) & getBitMask(numTaken)) << shift;
+            bit += numTaken;
+        }
+    }
+}
+
+///-modulus^-1 mod 2^limbBits, by Newton's iteration, which doubles the number of correct bits each time
+Word computeInverse(const juce::uint32* modulus, int numLimbs, int limbBits) noexcept
+{
+    const Word n0 = modulus[0] | (numLimbs > 1 ? static_cast<Word>(modulus[1]) << 32 : 0);
+    auto inverse = n0; // correct to 3 bits for any odd n0
+    for( int i = 0; i < 5; ++i )
+        inverse *= 2 - n0 * inverse;
+
+    return (0 - inverse) & getBitMask(limbBits);
+}
+
+///value = 2 * value mod modulus, for a value below the modulus
+void doubleModulo(juce::uint32* value, const juce::uint32* modulus, int numLimbs) noexcept
+{
+    juce::uint32 shiftedOut = 0;
+    for( int i = 0; i < numLimbs; ++i )
+    {
+        auto next = value[i] >> 31;
+        value[i] = (value[i] << 1) | shiftedOut;
+        shiftedOut = next;
+    }
+
+    if( shiftedOut != 0 || MontgomeryArithmetic::compare(value, modulus, numLimbs) >= 0 )
+        MontgomeryArithmetic::subtract(value, value, modulus, numLimbs);
+}
+
+size_t getNumScratchWords(int numLimbs, int tableSize, int numLanes, int limbBits) noexcept
+{
+    auto numKernelLimbs = static_cast<size_t>(getNumKernelLimbs(numLimbs, limbBits));
+    auto laneSize = numKernelLimbs * static_cast<size_t>(numLanes);
+
+    return numKernelLimbs                                       // the modulus
+           + static_cast<size_t>(numLimbs)                      // R^2 while it's being worked out
+           + (numKernelLimbs + 2) * static_cast<size_t>(numLanes) // the kernel's t
+           + laneSize * (3 + static_cast<size_t>(tableSize));   // R^2 and 1 in every lane, the result and the table
+}
+
+template <typename Kernel>
+void exponentiateLanes(juce::uint32* const* values,
+                       int numValues,
+                       const juce::uint32* modulus,
+                       const juce::uint32* rSquared,
+                       juce::uint32 inverse,
+                       int numLimbs,
+                       const WindowedExponent::Step* steps,
+                       size_t numSteps,
+                       int tableSize,
+                       void* scratch) noexcept
+{
+    constexpr auto numLanes = Kernel::numLanes;
+    constexpr auto limbBits = Kernel::limbBits;
+    const auto numKernelLimbs = getNumKernelLimbs(numLimbs, limbBits);
+    const auto laneSize = static_cast<size_t>(numKernelLimbs) * numLanes;
+
+    auto words = static_cast<Word*>(scratch);
+    auto kernelModulus = words;
+    words += numKernelLimbs;
+    auto kernelRSquared = reinterpret_cast<juce::uint32*>(words);
+    words += numLimbs;
+    auto rSquaredLanes = words;
+    words += laneSize;
+    auto oneLanes = words;
+    words += laneSize;
+    auto t = words;
+    words += static_cast<size_t>(numKernelLimbs + 2) * numLanes;
+    auto result = words;
+    words += laneSize;
+    auto table = words;
+
+    /*
+     the kernel's R is 2^(limbBits * numKernelLimbs), which is more than the caller's
+     2^(32 * numLimbs) when the limbs are 52 bits, so R^2 is doubled up to it.
+     */
+    fromLimbs32(modulus, numLimbs, kernelModulus, numKernelLimbs, 1, limbBits);
+    const auto kernelInverse = limbBits == 32 ? static_cast<Word>(inverse) : computeInverse(modulus, numLimbs, limbBits);
+
+    std::copy(rSquared, rSquared + numLimbs, kernelRSquared);
+    for( int i = 2 * limbBits * numKernelLimbs - 64 * numLimbs; --i >= 0; )
+        doubleModulo(kernelRSquared, modulus, numLimbs);
+
+    std::fill(oneLanes, oneLanes + laneSize, Word());
+    for( int lane = 0; lane < numLanes; ++lane )
+    {
+        fromLimbs32(kernelRSquared, numLimbs, rSquaredLanes + lane, numKernelLimbs, numLanes, limbBits);
+        oneLanes[lane] = 1;
+
+        if( lane < numValues )
+            fromLimbs32(values[lane], numLimbs, table + lane, numKernelLimbs, numLanes, limbBits);
+        else
+            for( int k = 0; k < numKernelLimbs; ++k )
+                table[k * numLanes + lane] = 0;
+    }
+
+    //table[k] = base^(2k + 1) in Montgomery form, the same as FixedWidthMontgomery::exponentiate()
+    Kernel::multiply(table, table, rSquaredLanes, kernelModulus, kernelInverse, numKernelLimbs, t);
+    if( tableSize > 1 )
+    {
+        Kernel::multiply(result, table, table, kernelModulus, kernelInverse, numKernelLimbs, t);
+        for( int k = 1; k < tableSize; ++k )
+            Kernel::multiply(table + static_cast<size_t>(k) * laneSize, table + static_cast<size_t>(k - 1) * laneSize,
+                             result, kernelModulus, kernelInverse, numKernelLimbs, t);
+    }
+
+    auto first = table + static_cast<size_t>(steps[0].digit >> 1) * laneSize;
+    std::copy(first, first + laneSize, result);
+
+    for( size_t i = 1; i < numSteps; ++i )
+    {
+        const auto& step = steps[i];
+        for( int k = 0; k < step.numSquarings; ++k )
+            Kernel::multiply(result, result, result, kernelModulus, kernelInverse, numKernelLimbs, t);
+
+        if( step.digit != 0 )
+            Kernel::multiply(result, result, table + static_cast<size_t>(step.digit >> 1) * laneSize,
+                             kernelModulus, kernelInverse, numKernelLimbs, t);
+    }
+
+    //multiplying by 1 takes the results back out of Montgomery form
+    Kernel::multiply(result, result, oneLanes, kernelModulus, kernelInverse, numKernelLimbs, t);
+
+    for( int lane = 0; lane < numValues; ++lane )
+        toLimbs32(result + lane, numKernelLimbs, numLanes, limbBits, values[lane], numLimbs);
+}
+} // namespace
+
+//==============================================================================
+MultiLaneMontgomery::Implementation MultiLaneMontgomery::getBestImplementation()
+{
+   #if JUCE_INTEL
+    static const auto best = juce::SystemStats::hasAVX512F() && juce::SystemStats::hasAVX512IFMA() ? Implementation::avx512ifma
+                           : juce::SystemStats::hasAVX512F()                                        ? Implementation::avx512
+                           : juce::SystemStats::hasAVX2()                                           ? Implementation::avx2
+                                                                                                    : Implementation::scalar;
+    return best;
+   #else
+    return Implementation::scalar;
+   #endif
+}
+
+int MultiLaneMontgomery::getNumLanes(Implementation implementation) noexcept
+{
+    switch( implementation )
+    {
+        case Implementation::avx2: return 4;
+        case Implementation::avx512:
+        case Implementation::avx512ifma: return 8;
+        case Implementation::scalar: break;
+    }
+
+    return 1;
+}
+
+size_t MultiLaneMontgomery::getNumScratchBytes(int numLimbs, int tableSize, Implementation implementation) noexcept
+{
+    return getNumScratchWords(numLimbs, tableSize, getNumLanes(implementation), getLimbBits(implementation)) * sizeof(Word);
+}
+
+void MultiLaneMontgomery::exponentiate(juce::uint32* const* values,
+                                       int numValues,
+                                       const juce::uint32* modulus,
+                                       const juce::uint32* rSquared,
+                                       juce::uint32 inverse,
+                                       int numLimbs,
+                                       const WindowedExponent::Step* steps,
+                                       size_t numSteps,
+                                       int tableSize,
+                                       void* scratch,
+                                       Implementation implementation) noexcept
+{
+    jassert(numValues <= getNumLanes(implementation) && numSteps > 0 && tableSize > 0);
+
+   #if JUCE_INTEL
+    if( implementation == Implementation::avx512ifma )
+        return exponentiateLanes<AVX512IFMAKernel>(values, numValues, modulus, rSquared, inverse, numLimbs, steps, numSteps, tableSize, scratch);
+
+    if( implementation == Implementation::avx512 )
+        return exponentiateLanes<AVX512Kernel>(values, numValues, modulus, rSquared, inverse, numLimbs, steps, numSteps, tableSize, scratch);
+
+    if( implementation == Implementation::avx2 )
+        return exponentiateLanes<AVX2Kernel>(values, numValues, modulus, rSquared, inverse, numLimbs, steps, numSteps, tableSize, scratch);
+   #endif
+
+    //one value at a time, reusing the scratch
+    for( int i = 0; i < numValues; ++i )
+        exponentiateLanes<ScalarKernel>(values + i, 1, modulus, rSquared, inverse, numLimbs, steps, numSteps, tableSize, scratch);
+}
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    MultiLaneMontgomery.h
+    Created: 18 Oct 2026 12:41:15am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Montgomery.h"
+
+/**
+ Runs several exponentiations with the same modulus and the same exponent side by side,
+ one in each SIMD lane.
+
+ Every lane works through the same sequence of windowed exponent steps, so the lanes
+ stay in lockstep and each table lookup is the same for all of them: only the values differ.
+ The limbs are interleaved, limb k of every lane next to each other, so one vector
+ instruction works on limb k of every value at once.
+
+ - avx512ifma: 8 lanes of 52-bit limbs, multiplied with the AVX-512 IFMA instructions
+ - avx512:     8 lanes of 32-bit limbs, each in a 64-bit element
+ - avx2:       4 lanes of 32-bit limbs, each in a 64-bit element
+ - scalar:     one lane at a time, for CPUs with none of those
+ */
+struct MultiLaneMontgomery
+{
+    enum class Implementation
+    {
+        scalar,
+        avx2,
+        avx512,
+        avx512ifma
+    };
+
+    static constexpr int maxNumLanes = 8;
+
+    ///the fastest implementation this CPU supports
+    static Implementation getBestImplementation();
+
+    ///the number of values exponentiate() works on at once
+    static int getNumLanes(Implementation implementation) noexcept;
+
+    ///the scratch bytes exponentiate() needs for a modulus of 'numLimbs' 32-bit limbs and a table of 'tableSize' powers
+    static size_t getNumScratchBytes(int numLimbs, int tableSize, Implementation implementation) noexcept;
+
+    /**
+     Replaces each of the 'numValues' values with value^exponent mod the modulus.
+
+     The values are 'numLimbs' 32-bit limbs in normal form, below the modulus, and the results are too.
+     There can be up to getNumLanes(implementation) of them; any lanes left over just do their work on zero.
+     'modulus' is odd, 'rSquared' is R^2 mod it (R = 2^(32 * numLimbs)) and 'inverse' is -modulus^-1 mod 2^32,
+     as a MontgomeryModulus or FixedWidthMontgomery holds them.
+     'scratch' must have room for getNumScratchBytes() bytes.  Nothing is allocated.
+     */
+    static void exponentiate(juce::uint32* const* values,
+                             int numValues,
+                             const juce::uint32* modulus,
+                             const juce::uint32* rSquared,
+                             juce::uint32 inverse,
+                             int numLimbs,
+                             const WindowedExponent::Step* steps,
+                             size_t numSteps,
+                             int tableSize,
+                             void* scratch,
+                             Implementation implementation = getBestImplementation()) noexcept;
+};
@@ -0,0 +1,103 @@
+/*
+  ==============================================================================
+
+    ObjectIdentifier.h
+    Created: 18 Oct 2026 2:48:20am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "DERCursor.h"
+
+/**
+ The content bytes of an OBJECT IDENTIFIER, encoded from its arcs at compile time.
+
+ Matching a node against one is a length check and a memcmp of its content, so there is no
+ dotted-string decoding or Int10 arithmetic at run time.
+ e.g.:
+ @code
+ static constexpr auto sha256 = ObjectIdentifier::fromArcs<2, 16, 840, 1, 101, 3, 4, 2, 1>();
+ if( sha256.matches(algorithmIdentifier.getChild(0)) )
+ @endcode
+ */
+struct ObjectIdentifier
+{
+    static constexpr size_t maxNumBytes = 32;
+
+    template <juce::uint64 first, juce::uint64 second, juce::uint64... rest>
+    static constexpr ObjectIdentifier fromArcs() noexcept
+    {
+        static_assert(first <= 2 && (first == 2 || second < 40), "the first two arcs are 0, 1 or 2, then below 40 unless the first is 2");
+
+        //the first two arcs share the first subidentifier
+        ObjectIdentifier oid;
+        oid.appendArc(first * 40 + second);
+        (oid.appendArc(rest), ...);
+        return oid;
+    }
+
+    constexpr const juce::uint8* getBytes() const noexcept { return bytes; }
+    constexpr size_t getNumBytes() const noexcept { return numBytes; }
+
+    ///compares the content bytes of an OBJECT IDENTIFIER, without its tag and length
+    bool matches(const void* content, size_t numContentBytes) const noexcept
+    {
+        return numContentBytes == numBytes && std::memcmp(content, bytes, numBytes) == 0;
+    }
+
+    ///returns true if the node is an OBJECT IDENTIFIER with this value
+    bool matches(const DERCursor& node) const noexcept
+    {
+        return node.isUniversal(0x06)
+            && node.getContentLength() == static_cast<juce::int64>(numBytes)
+            && std::memcmp(node.getContent(), bytes, numBytes) == 0;
+    }
+
+    constexpr bool operator==(const ObjectIdentifier& other) const noexcept
+    {
+        if( numBytes != other.numBytes )
+            return false;
+
+        for( size_t i = 0; i < numBytes; ++i )
+            if( bytes[i] != other.bytes[i] )
+                return false;
+
+        return true;
+    }
+
+    constexpr bool operator!=(const ObjectIdentifier& other) const noexcept { return ! operator==(other); }
+private:
+    juce::uint8 bytes[maxNumBytes] = {};
+    size_t numBytes = 0;
+
+    constexpr ObjectIdentifier() = default;
+
+    ///base 128, most significant group first, with the top bit set on every group but the last
+    constexpr void appendArc(juce::uint64 arc) noexcept
+    {
+        int numGroups = 1;
+        for( auto remaining = arc >> 7; remaining != 0; remaining >>= 7 )
+            ++numGroups;
+
+        for( int group = numGroups - 1; group >= 0; --group )
+            bytes[numBytes++] = static_cast<juce::uint8>(((arc >> (7 * group)) & 0x7f) | (group > 0 ? 0x80 : 0));
+    }
+};
+
+///the object identifiers the parsers look for
+struct KnownOIDs
+{
+    ///1.2.840.113549.1.1.1 rsaEncryption (PKCS #1)
+    static constexpr auto rsaEncryption = ObjectIdentifier::fromArcs<1, 2, 840, 113549, 1, 1, 1>();
+};
+
+static_assert(KnownOIDs::rsaEncryption.getNumBytes() == 9
+              && KnownOIDs::rsaEncryption.getBytes()[0] == 0x2a
+              && KnownOIDs::rsaEncryption.getBytes()[3] == 0x86
+              && KnownOIDs::rsaEncryption.getBytes()[8] == 0x01,
+              "rsaEncryption is 2a 86 48 86 f7 0d 01 01 01");
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    PEMBatchDecryptor.cpp
+    Created: 17 Oct 2026 1:18:52pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "PEMBatchDecryptor.h"
+#include "Base64Decoder.h"
+#include "PEMHelpers.h"
+
+PEMBatchDecryptor::PEMBatchDecryptor(const PEMFormatKey& key_) :
+PEMBatchDecryptor(key_, Options())
+{
+
+}
+
+PEMBatchDecryptor::PEMBatchDecryptor(const PEMFormatKey& key_, Options options_) :
+key(key_),
+options(options_),
+pool(options_.numWorkers),
+scratch(static_cast<size_t>(pool.getNumWorkers()))
+{
+    auto chunkSize = juce::jmax(static_cast<size_t>(1), options.chunkSize);
+
+    for( auto& buffers : scratch )
+    {
+        buffers.numSlotBytes = key.getMaxPlaintextSize();
+        buffers.slots.allocate(buffers.numSlotBytes * chunkSize, false);
+        buffers.decryptions.resize(chunkSize);
+        buffers.indices.resize(chunkSize);
+    }
+}
+
+std::vector<juce::String> PEMBatchDecryptor::decryptBase64Strings(const juce::String* ciphertexts,
+                                                                  size_t numCiphertexts)
+{
+    std::vector<juce::String> results(numCiphertexts);
+
+    pool.parallelFor(numCiphertexts, options.chunkSize, [&](int workerIndex, size_t begin, size_t end)
+    {
+        auto& buffers = scratch[static_cast<size_t>(workerIndex)];
+        auto numInChunk = end - begin;
+
+        //each slot has to hold a decoded ciphertext as well as its plaintext, which only an oversized one outgrows
+        auto numSlotBytes = buffers.numSlotBytes;
+        for( auto i = begin; i < end; ++i )
+            numSlotBytes = juce::jmax(numSlotBytes, Base64Decoder::getMaxDecodedSize(ciphertexts[i].getNumBytesAsUTF8()));
+
+        if( numSlotBytes > buffers.numSlotBytes || numInChunk > buffers.decryptions.size() )
+        {
+            buffers.numSlotBytes = numSlotBytes;
+            buffers.decryptions.resize(juce::jmax(numInChunk, buffers.decryptions.size()));
+            buffers.indices.resize(buffers.decryptions.size());
+            buffers.slots.allocate(numSlotBytes * buffers.decryptions.size(), false);
+        }
+
+        //decode each ciphertext into its slot, then decrypt it where it is
+        size_t numDecoded = 0;
+        for( auto i = begin; i < end; ++i )
+        {
+            auto* slot = buffers.slots + (i - begin) * numSlotBytes;
+            size_t numCiphertextBytes = 0;
+            if( Base64Decoder::decode(ciphertexts[i].toRawUTF8(), ciphertexts[i].getNumBytesAsUTF8(), slot, numCiphertextBytes) )
+            {
+                buffers.decryptions[numDecoded] = { slot, numCiphertextBytes, slot, numSlotBytes };
+                buffers.indices[numDecoded++] = i;
+            }
+        }
+
+        key.decryptBatch(buffers.decryptions.data(), numDecoded, &buffers.decrypt);
+
+        for( size_t d = 0; d < numDecoded; ++d )
+        {
+            const auto& decryption = buffers.decryptions[d];
+            if( decryption.decrypted )
+                results[buffers.indices[d]] = PEMFormatKey::getMessageString(decryption.plaintext, decryption.numPlaintextBytes);
+        }
+    });
+
+    return results;
+}
+
+std::vector<juce::String> PEMBatchDecryptor::decryptBase64Strings(const juce::StringArray& ciphertexts)
+{
+    return decryptBase64Strings(ciphertexts.begin(), static_cast<size_t>(ciphertexts.size()));
+}
+
+std::vector<juce::MemoryBlock> PEMBatchDecryptor::decryptRaw(const juce::MemoryBlock* ciphertexts,
+                                                             size_t numCiphertexts)
+{
+    std::vector<juce::MemoryBlock> results(numCiphertexts);
+    const auto maxPlaintextBytes = key.getMaxPlaintextSize();
+
+    pool.parallelFor(numCiphertexts, options.chunkSize, [&](int workerIndex, size_t begin, size_t end)
+    {
+        auto& buffers = scratch[static_cast<size_t>(workerIndex)];
+        auto numInChunk = end - begin;
+
+        if( numInChunk > buffers.decryptions.size() )
+            buffers.decryptions.resize(numInChunk);
+
+        //the plaintexts go straight into the results
+        for( auto i = begin; i < end; ++i )
+        {
+            results[i].setSize(maxPlaintextBytes, false);
+            buffers.decryptions[i - begin] = { ciphertexts[i].getData(), ciphertexts[i].getSize(), results[i].getData(), maxPlaintextBytes };
+        }
+
+        key.decryptBatch(buffers.decryptions.data(), numInChunk, &buffers.decrypt);
+
+        for( auto i = begin; i < end; ++i )
+        {
+            const auto& decryption = buffers.decryptions[i - begin];
+            results[i].setSize(decryption.decrypted ? decryption.numPlaintextBytes : 0, false);
+        }
+    });
+
+    return results;
+}
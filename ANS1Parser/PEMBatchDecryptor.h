@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    PEMBatchDecryptor.h
+    Created: 17 Oct 2026 1:18:52pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "MultiLaneMontgomery.h"
+#include "PEMFormatKey.h"
+#include "WorkStealingThreadPool.h"
+
+/**
+ Decrypts many ciphertexts under one key across a pool of worker threads.
+
+ The key is shared by reference between all the workers and is never copied,
+ so it must outlive the decryptor.  Each worker keeps its own scratch buffers.
+ Each chunk goes to PEMFormatKey::decryptBatch() in one call, so with the default chunk size
+ a worker fills every SIMD lane the key's exponentiation can use.
+ Results are returned in the same order as the input.
+ e.g.:
+ @code
+ PEMBatchDecryptor decryptor(rsaKey);
+ auto plaintexts = decryptor.decryptBase64Strings(tokens);
+ @endcode
+ */
+struct PEMBatchDecryptor
+{
+    struct Options
+    {
+        ///the number of threads, including the one calling decrypt
+        int numWorkers = juce::SystemStats::getNumCpus();
+        ///the number of ciphertexts a worker takes at a time, and decrypts side by side
+        size_t chunkSize = MultiLaneMontgomery::maxNumLanes;
+    };
+
+    explicit PEMBatchDecryptor(const PEMFormatKey& key);
+    PEMBatchDecryptor(const PEMFormatKey& key, Options options);
+
+    ///decrypts base64-encoded ciphertexts, like PEMFormatKey::decryptBase64String()
+    std::vector<juce::String> decryptBase64Strings(const juce::String* ciphertexts, size_t numCiphertexts);
+    std::vector<juce::String> decryptBase64Strings(const juce::StringArray& ciphertexts);
+
+    /**
+     Decrypts raw big-endian ciphertexts, like PEMFormatKey::decryptBytes().
+     A ciphertext that decryptBytes() would fail on, one that is zero or isn't below the modulus,
+     gives an empty block.
+     */
+    std::vector<juce::MemoryBlock> decryptRaw(const juce::MemoryBlock* ciphertexts, size_t numCiphertexts);
+
+    const Options& getOptions() const noexcept { return options; }
+private:
+    struct Scratch
+    {
+        PEMFormatKey::DecryptScratch decrypt;
+        ///one slot per ciphertext of a chunk, each holding its decoded ciphertext and then its plaintext
+        juce::HeapBlock<juce::uint8> slots;
+        size_t numSlotBytes = 0;
+        std::vector<PEMFormatKey::Decryption> decryptions;
+        ///the ciphertext each of the decryptions came from
+        std::vector<size_t> indices;
+    };
+
+    const PEMFormatKey& key;
+    const Options options;
+    WorkStealingThreadPool pool;
+    std::vector<Scratch> scratch;
+
+    JUCE_DECLARE_NON_COPYABLE(PEMBatchDecryptor)
+};
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    PEMBundleLoader.cpp
+    Created: 17 Oct 2026 7:26:15pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "PEMBundleLoader.h"
+
+std::vector<PEMHelpers::PEMBlock> PEMBundleLoader::findBlocks(const char* text, size_t numBytes)
+{
+    std::vector<PEMHelpers::PEMBlock> blocks;
+
+    //each search starts where the last block ended, so every byte is only looked at once
+    PEMHelpers::PEMBlock block;
+    for( size_t position = 0; PEMHelpers::findNextPEMBlock(text, numBytes, position, block); position = block.end )
+        blocks.push_back(block);
+
+    return blocks;
+}
+
+std::vector<PEMFormatKey> PEMBundleLoader::loadFile(const juce::File& file)
+{
+    return loadFile(file, Options());
+}
+
+std::vector<PEMFormatKey> PEMBundleLoader::loadFile(const juce::File& file, Options options)
+{
+    auto mappedFile = PEMHelpers::mapFile(file);
+    if( mappedFile == nullptr )
+        return {};
+
+    return load(static_cast<const char*>(mappedFile->getData()), mappedFile->getSize(), options);
+}
+
+std::vector<PEMFormatKey> PEMBundleLoader::load(const char* text, size_t numBytes)
+{
+    return load(text, numBytes, Options());
+}
+
+std::vector<PEMFormatKey> PEMBundleLoader::load(const char* text, size_t numBytes, Options options)
+{
+    auto blocks = findBlocks(text, numBytes);
+
+    std::vector<PEMFormatKey> keys(blocks.size());
+    std::vector<juce::uint8> loaded(blocks.size(), 0);
+
+    auto loadBlocks = [&](juce::MemoryBlock& scratch, size_t begin, size_t end)
+    {
+        for( auto i = begin; i < end; ++i )
+        {
+            keys[i].setValidation(options.validation);
+            keys[i].setAssertOnMalformedInput(false);
+            loaded[i] = keys[i].loadFromPEMBlock(text, blocks[i], scratch) ? 1 : 0;
+        }
+    };
+
+    if( options.pool == nullptr || options.pool->getNumWorkers() <= 1 || blocks.size() <= options.chunkSize )
+    {
+        juce::MemoryBlock scratch;
+        loadBlocks(scratch, 0, blocks.size());
+    }
+    else
+    {
+        std::vector<juce::MemoryBlock> scratch(static_cast<size_t>(options.pool->getNumWorkers()));
+
+        options.pool->parallelFor(blocks.size(), options.chunkSize, [&](int workerIndex, size_t begin, size_t end)
+        {
+            loadBlocks(scratch[static_cast<size_t>(workerIndex)], begin, end);
+        });
+    }
+
+    //drop the blocks that weren't keys, keeping the rest in file order
+    size_t numLoaded = 0;
+    for( size_t i = 0; i < keys.size(); ++i )
+    {
+        if( loaded[i] == 0 )
+            continue;
+
+        if( numLoaded != i )
+            keys[numLoaded] = std::move(keys[i]);
+
+        ++numLoaded;
+    }
+
+    if( numLoaded != keys.size() )
+        DBG( "skipped " + juce::String(static_cast<int>(keys.size() - numLoaded)) + " PEM blocks that weren't keys" );
+
+    keys.resize(numLoaded);
+    return keys;
+}
@@ -0,0 +1,62 @@
+/*
+  ==============================================================================
+
+    PEMBundleLoader.h
+    Created: 17 Oct 2026 7:26:15pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PEMFormatKey.h"
+#include "WorkStealingThreadPool.h"
+
+/**
+ Loads every key in a file of concatenated PEM blocks.
+
+ The file is memory-mapped and scanned once for its -----BEGIN/-----END pairs.
+ Each body is base64-decoded straight out of the mapping into a per-thread scratch
+ buffer, so the file is never copied into a juce::String.
+ Blocks can be loaded in parallel across a WorkStealingThreadPool that the caller keeps,
+ so its threads are started once rather than for every bundle.
+ e.g.:
+ @code
+ WorkStealingThreadPool pool;
+ PEMBundleLoader::Options options;
+ options.pool = &pool;
+
+ for( const auto& bundleFile : bundleFiles )
+     for( auto& key : PEMBundleLoader::loadFile(bundleFile, options) )
+         keys.push_back(std::move(key));
+ @endcode
+ */
+struct PEMBundleLoader
+{
+    struct Options
+    {
+        ///the pool whose workers load the blocks, along with the thread calling load.  nullptr loads everything inline
+        WorkStealingThreadPool* pool = nullptr;
+        ///the number of blocks a worker takes at a time
+        size_t chunkSize = 64;
+        ///how much checking each private key gets.  use structural or none for keys from a trusted source
+        PEMFormatKey::Validation validation = PEMFormatKey::Validation::full;
+    };
+
+    ///finds every -----BEGIN/-----END pair in a single pass over the text
+    static std::vector<PEMHelpers::PEMBlock> findBlocks(const char* text, size_t numBytes);
+
+    /**
+     Loads every PUBLIC KEY and PRIVATE KEY block in the file, in the order they appear.
+     Blocks of any other kind, and keys that don't load, are skipped without asserting.
+     */
+    static std::vector<PEMFormatKey> loadFile(const juce::File& file);
+    static std::vector<PEMFormatKey> loadFile(const juce::File& file, Options options);
+
+    ///the same as loadFile(), for a bundle that is already in memory
+    static std::vector<PEMFormatKey> load(const char* text, size_t numBytes);
+    static std::vector<PEMFormatKey> load(const char* text, size_t numBytes, Options options);
+};
@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    PEMDecryptionService.cpp
+    Created: 17 Oct 2026 11:52:40pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "PEMDecryptionService.h"
+#include "Base64Decoder.h"
+
+struct PEMDecryptionService::Worker : juce::Thread
+{
+    Worker(PEMDecryptionService& owner_, int index) :
+    juce::Thread("PEMDecryptionService worker " + juce::String(index)),
+    owner(owner_)
+    {
+
+    }
+
+    void run() override
+    {
+        Batch batch;
+        while( owner.waitForBatch(batch) )
+        {
+            decrypt(*batch.key, batch.requests);
+            batch.requests.clear();
+        }
+    }
+
+    /**
+     Decodes each request's ciphertext into a slot of its own and decrypts them all with one
+     decryptBatch(), so the key can run them side by side in SIMD lanes.
+     */
+    void decrypt(const PEMFormatKey& key, const std::vector<Request>& requests)
+    {
+        auto numSlotBytes = key.getMaxPlaintextSize();
+        for( const auto& request : requests )
+            numSlotBytes = juce::jmax(numSlotBytes, Base64Decoder::getMaxDecodedSize(request.base64.getNumBytesAsUTF8()));
+
+        if( numSlotBytes * requests.size() > slots.size() )
+            slots.resize(numSlotBytes * requests.size());
+
+        decryptions.clear();
+        indices.clear();
+
+        for( size_t i = 0; i < requests.size(); ++i )
+        {
+            auto* slot = slots.data() + i * numSlotBytes;
+            size_t numCiphertextBytes = 0;
+            if( Base64Decoder::decode(requests[i].base64.toRawUTF8(), requests[i].base64.getNumBytesAsUTF8(), slot, numCiphertextBytes) )
+            {
+                decryptions.push_back({ slot, numCiphertextBytes, slot, numSlotBytes });
+                indices.push_back(i);
+            }
+        }
+
+        key.decryptBatch(decryptions.data(), decryptions.size(), &scratch);
+
+        //the requests that decoded are in 'decryptions' in the same order
+        for( size_t i = 0, d = 0; i < requests.size(); ++i )
+        {
+            const auto* decryption = d < indices.size() && indices[d] == i ? &decryptions[d++] : nullptr;
+
+            if( decryption != nullptr && decryption->decrypted )
+                requests[i].callback(true, PEMFormatKey::getMessageString(decryption->plaintext, decryption->numPlaintextBytes));
+            else
+                requests[i].callback(false, {});
+        }
+    }
+
+    PEMDecryptionService& owner;
+    PEMFormatKey::DecryptScratch scratch;
+    ///one slot per request, holding its decoded ciphertext and then its plaintext
+    std::vector<juce::uint8> slots;
+    std::vector<PEMFormatKey::Decryption> decryptions;
+    ///the request each of the decryptions came from
+    std::vector<size_t> indices;
+};
+
+PEMDecryptionService::PEMDecryptionService() :
+PEMDecryptionService(Options())
+{
+
+}
+
+PEMDecryptionService::PEMDecryptionService(Options options_) :
+options(options_)
+{
+    for( int i = 0; i < juce::jmax(1, options.numWorkers); ++i )
+        workers.add(new Worker(*this, i))->startThread();
+}
+
+PEMDecryptionService::~PEMDecryptionService()
+{
+    {
+        const std::lock_guard<std::mutex> sl(lock);
+        stopping = true;
+    }
+
+    requestsWaiting.notify_all();
+
+    for( auto* worker : workers )
+        worker->stopThread(-1);
+}
+
+std::future<juce::String> PEMDecryptionService::submit(const PEMFormatKey& key, juce::String base64)
+{
+    //a std::function has to be copyable, and a promise isn't
+    auto promise = std::make_shared<std::promise<juce::String>>();
+    auto future = promise->get_future();
+
+    submit(key, std::move(base64), [promise](bool, const juce::String& plaintext)
+    {
+        promise->set_value(plaintext);
+    });
+
+    return future;
+}
+
+void PEMDecryptionService::submit(const PEMFormatKey& key, juce::String base64, Callback callback)
+{
+    jassert(callback != nullptr);
+
+    size_t numQueued = 0;
+    {
+        const std::lock_guard<std::mutex> sl(lock);
+        jassert(! stopping);
+
+        auto& queue = queues[&key];
+        queue.push_back({ std::move(base64), std::move(callback), Clock::now() });
+        numQueued = queue.size();
+    }
+
+    /*
+     a worker only needs waking when this key has something new for it to decide about:
+     its first request, which starts the wait, or the one that fills a batch.
+     */
+    if( numQueued == 1 || numQueued == options.maxBatchSize )
+        requestsWaiting.notify_one();
+}
+
+PEMDecryptionService::Statistics PEMDecryptionService::getStatistics() const
+{
+    const std::lock_guard<std::mutex> sl(lock);
+    return statistics;
+}
+
+bool PEMDecryptionService::waitForBatch(Batch& batch)
+{
+    const auto maxBatchSize = juce::jmax(static_cast<size_t>(1), options.maxBatchSize);
+    const auto maxWait = std::chrono::microseconds(juce::jmax(0, options.maxWaitMicroseconds));
+
+    std::unique_lock<std::mutex> sl(lock);
+
+    for (;;)
+    {
+        /*
+         of the keys that are ready, take the one whose oldest request has waited longest.
+         a key is ready once it has a full batch or its oldest request has waited long enough.
+         when stopping, every key is ready.
+         */
+        auto now = Clock::now();
+        auto next = queues.end();
+        auto nextDeadline = Clock::time_point::max();
+
+        for( auto it = queues.begin(); it != queues.end(); ++it )
+        {
+            auto submitted = it->second.front().submitted;
+            auto isReady = stopping || it->second.size() >= maxBatchSize || submitted + maxWait <= now;
+
+            if( isReady )
+            {
+                if( next == queues.end() || submitted < next->second.front().submitted )
+                    next = it;
+            }
+            else
+            {
+                nextDeadline = juce::jmin(nextDeadline, submitted + maxWait);
+            }
+        }
+
+        if( next != queues.end() )
+        {
+            auto& queue = next->second;
+            auto numRequests = juce::jmin(maxBatchSize, queue.size());
+
+            batch.key = next->first;
+            batch.requests.assign(std::make_move_iterator(queue.begin()),
+                                  std::make_move_iterator(queue.begin() + static_cast<std::ptrdiff_t>(numRequests)));
+            queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(numRequests));
+
+            if( queue.empty() )
+                queues.erase(next);
+
+            statistics.numRequests += static_cast<juce::int64>(numRequests);
+            ++statistics.numBatches;
+            statistics.largestBatch = juce::jmax(statistics.largestBatch, numRequests);
+
+            //there may be more ready than this worker can take
+            if( ! queues.empty() )
+                requestsWaiting.notify_one();
+
+            return true;
+        }
+
+        if( stopping )
+            return false;
+
+        if( nextDeadline == Clock::time_point::max() )
+            requestsWaiting.wait(sl);
+        else
+            requestsWaiting.wait_until(sl, nextDeadline);
+    }
+}
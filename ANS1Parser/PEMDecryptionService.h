@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    PEMDecryptionService.h
+    Created: 17 Oct 2026 11:52:40pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+#include "PEMFormatKey.h"
+
+/**
+ Decrypts base64 ciphertexts submitted from any number of threads on a set of worker threads.
+
+ Requests are queued per key.  A free worker takes the key whose oldest request has waited
+ longest, and takes up to Options::maxBatchSize of that key's requests at once, decrypting them
+ with one PEMFormatKey::decryptBatch() so that keys of the standard sizes run them side by side
+ in SIMD lanes, with the same scratch buffers and while the key is hot in its cache.
+
+ A worker takes a key's requests as soon as it is free unless Options::maxWaitMicroseconds is
+ set, so when the service is idle a request starts straight away.  Under load the workers are
+ busy, requests pile up behind them, and each worker picks up a whole batch when it comes back
+ for more.  Setting a wait holds a key's requests until there is a full batch of them or the
+ oldest has waited that long.
+
+ Keys are identified by address and must stay alive until their requests have completed.
+ e.g.:
+ @code
+ PEMDecryptionService service;
+ auto plaintext = service.submit(rsaKey, token.ciphertext);
+ ...
+ handleMessage(plaintext.get());
+ @endcode
+ */
+struct PEMDecryptionService
+{
+    struct Options
+    {
+        int numWorkers = juce::SystemStats::getNumCpus();
+        ///the most requests for one key a worker takes at a time
+        size_t maxBatchSize = 32;
+        ///how long a key's requests wait for a full batch.  0 takes them as soon as a worker is free
+        int maxWaitMicroseconds = 0;
+    };
+
+    /**
+     Called on a worker thread with the message, as PEMFormatKey::decryptBase64String() returns it,
+     or with 'decrypted' false and an empty string if the ciphertext couldn't be decoded or decrypted.
+     Keep it short: the rest of the batch waits for it.
+     */
+    using Callback = std::function<void(bool decrypted, const juce::String& plaintext)>;
+
+    PEMDecryptionService();
+    explicit PEMDecryptionService(Options options);
+    ///completes every request that has already been submitted, then stops the workers
+    ~PEMDecryptionService();
+
+    /**
+     The result is the same as PEMFormatKey::decryptBase64String() would give, which is an empty string
+     for a ciphertext that couldn't be decoded or decrypted.
+     */
+    std::future<juce::String> submit(const PEMFormatKey& key, juce::String base64);
+    void submit(const PEMFormatKey& key, juce::String base64, Callback callback);
+
+    struct Statistics
+    {
+        juce::int64 numRequests = 0;
+        juce::int64 numBatches = 0;
+        size_t largestBatch = 0;
+
+        double getMeanBatchSize() const noexcept { return numBatches > 0 ? static_cast<double>(numRequests) / static_cast<double>(numBatches) : 0; }
+    };
+
+    ///how many requests the workers have taken so far, and how they were batched
+    Statistics getStatistics() const;
+
+    const Options& getOptions() const noexcept { return options; }
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Request
+    {
+        juce::String base64;
+        Callback callback;
+        Clock::time_point submitted;
+    };
+
+    struct Batch
+    {
+        const PEMFormatKey* key = nullptr;
+        std::vector<Request> requests;
+    };
+
+    struct Worker;
+
+    const Options options;
+
+    mutable std::mutex lock;
+    std::condition_variable requestsWaiting;
+    std::unordered_map<const PEMFormatKey*, std::deque<Request>> queues;
+    bool stopping = false;
+    Statistics statistics;
+
+    juce::OwnedArray<Worker> workers;
+
+    /**
+     Moves the next batch that is ready into 'batch', waiting until there is one.
+     Returns false once the service is stopping and every queue is empty.
+     */
+    bool waitForBatch(Batch& batch);
+
+    JUCE_DECLARE_NON_COPYABLE(PEMDecryptionService)
+};
@@ -9,3 +9,306 @@
 */
 
 #include "PEMHelpers.h"
+
+namespace
+{
+const char* findText(const char* text, size_t numBytes, size_t position, const char* toFind, size_t toFindLength)
+{
+    if( numBytes < toFindLength )
+        return nullptr;
+    
+    //jump between candidate first characters with memchr, then compare the rest
+    auto lastStart = text + (numBytes - toFindLength);
+    for( auto p = text + position; p <= lastStart; ++p )
+    {
+        p = static_cast<const char*>(std::memchr(p, toFind[0], static_cast<size_t>(lastStart - p) + 1));
+        if( p == nullptr )
+            return nullptr;
+        
+        if( std::memcmp(p, toFind, toFindLength) == 0 )
+            return p;
+    }
+    
+    return nullptr;
+}
+
+///returns true if 'toFind' is at 'position'
+bool startsWith(const char* text, size_t numBytes, size_t position, const char* toFind, size_t toFindLength)
+{
+    return position <= numBytes && numBytes - position >= toFindLength
+        && std::memcmp(text + position, toFind, toFindLength) == 0;
+}
+
+///the number of base64 characters on each line of a PEM block, as OpenSSL writes them
+constexpr size_t pemLineLength = 64;
+} // namespace
+
+bool PEMHelpers::findNextPEMBlock(const char* text, size_t numBytes, size_t position, PEMBlock& block)
+{
+    static constexpr char beginMarker[] = "-----BEGIN ";
+    static constexpr char endMarker[] = "-----END ";
+    static constexpr char dashes[] = "-----";
+    
+    for( ;; )
+    {
+        auto begin = findText(text, numBytes, position, beginMarker, sizeof(beginMarker) - 1);
+        if( begin == nullptr )
+            return false;
+        
+        auto labelStart = static_cast<size_t>(begin - text) + sizeof(beginMarker) - 1;
+        auto labelEnd = findText(text, numBytes, labelStart, dashes, sizeof(dashes) - 1);
+        if( labelEnd == nullptr )
+            return false;
+        
+        //a -----BEGIN line that never closes isn't one.  the dashes found after it may start the next block
+        auto labelLength = static_cast<size_t>(labelEnd - text) - labelStart;
+        if( std::memchr(text + labelStart, '\n', labelLength) != nullptr )
+        {
+            position = static_cast<size_t>(labelEnd - text);
+            continue;
+        }
+        
+        /*
+         base64 has no dashes in it, so the next dashes after the body are the block's -----END line.
+         if they're anything else, like the -----BEGIN of the next block, this block has no -----END
+         and the search starts again from them, so the block after it isn't swallowed.
+         */
+        auto bodyStart = static_cast<size_t>(labelEnd - text) + sizeof(dashes) - 1;
+        auto end = findText(text, numBytes, bodyStart, dashes, sizeof(dashes) - 1);
+        if( end == nullptr )
+            return false;
+        
+        position = static_cast<size_t>(end - text);
+        if( ! startsWith(text, numBytes, position, endMarker, sizeof(endMarker) - 1) )
+        {
+            if( ! startsWith(text, numBytes, position, beginMarker, sizeof(beginMarker) - 1) )
+                position += sizeof(dashes) - 1;
+            
+            continue;
+        }
+        
+        auto endLabelStart = position + sizeof(endMarker) - 1;
+        auto closingDashes = findText(text, numBytes, endLabelStart, dashes, sizeof(dashes) - 1);
+        if( closingDashes == nullptr )
+            return false;
+        
+        //the -----END line has to close the block the -----BEGIN line opened
+        if( static_cast<size_t>(closingDashes - text) - endLabelStart != labelLength
+            || std::memcmp(text + endLabelStart, text + labelStart, labelLength) != 0 )
+        {
+            position = endLabelStart;
+            continue;
+        }
+        
+        block.begin = static_cast<size_t>(begin - text);
+        block.end = static_cast<size_t>(closingDashes - text) + sizeof(dashes) - 1;
+        block.labelStart = labelStart;
+        block.labelLength = labelLength;
+        block.bodyStart = bodyStart;
+        block.bodyLength = position - bodyStart;
+        
+        return true;
+    }
+}
+
+std::unique_ptr<juce::MemoryMappedFile> PEMHelpers::mapFile(const juce::File& file)
+{
+    auto mappedFile = std::make_unique<juce::MemoryMappedFile>(file, juce::MemoryMappedFile::readOnly);
+    if( mappedFile->getData() == nullptr )
+    {
+        DBG( "couldn't map " + file.getFullPathName() );
+        return nullptr;
+    }
+    
+    return mappedFile;
+}
+
+bool PEMHelpers::convertPEMBodyToPEMMemoryBlock(const juce::String& pem, juce::MemoryBlock& destination)
+{
+    auto text = pem.toRawUTF8();
+    
+    PEMBlock block;
+    if( ! findNextPEMBlock(text, pem.getNumBytesAsUTF8(), 0, block) )
+    {
+        DBG( "missing -----BEGIN or -----END line!" );
+        jassertfalse;
+        return false;
+    }
+    
+    auto ok = Base64Decoder::decode(text + block.bodyStart, block.bodyLength, destination);
+    jassert(ok);
+    
+    return ok;
+}
+
+size_t PEMHelpers::getPEMBlockSize(size_t numBytes, const char* label) noexcept
+{
+    auto labelLength = std::strlen(label);
+    auto numChars = (numBytes + 2) / 3 * 4;
+    auto numLines = (numChars + pemLineLength - 1) / pemLineLength;
+    
+    //"-----BEGIN " label "-----\n" and "-----END " label "-----\n"
+    return (11 + labelLength + 6) + numChars + numLines + (9 + labelLength + 6);
+}
+
+size_t PEMHelpers::writePEMBlock(const void* der, size_t numBytes, const char* label, char* dest) noexcept
+{
+    static constexpr char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    
+    auto labelLength = std::strlen(label);
+    auto start = dest;
+    
+    auto writeText = [&dest](const char* text, size_t length)
+    {
+        std::memcpy(dest, text, length);
+        dest += length;
+    };
+    
+    writeText("-----BEGIN ", 11);
+    writeText(label, labelLength);
+    writeText("-----\n", 6);
+    
+    /*
+     every group of three bytes is read before its four characters are written,
+     which is what lets 'der' sit at the end of 'dest'.
+     */
+    auto bytes = static_cast<const juce::uint8*>(der);
+    size_t lineLength = 0;
+    
+    for( size_t i = 0; i < numBytes; i += 3 )
+    {
+        auto numInGroup = juce::jmin(static_cast<size_t>(3), numBytes - i);
+        juce::uint32 group = static_cast<juce::uint32>(bytes[i]) << 16;
+        if( numInGroup > 1 ) group |= static_cast<juce::uint32>(bytes[i + 1]) << 8;
+        if( numInGroup > 2 ) group |= bytes[i + 2];
+        
+        dest[0] = alphabet[(group >> 18) & 0x3f];
+        dest[1] = alphabet[(group >> 12) & 0x3f];
+        dest[2] = numInGroup > 1 ? alphabet[(group >> 6) & 0x3f] : '=';
+        dest[3] = numInGroup > 2 ? alphabet[group & 0x3f] : '=';
+        dest += 4;
+        
+        lineLength += 4;
+        if( lineLength == pemLineLength )
+        {
+            *dest++ = '\n';
+            lineLength = 0;
+        }
+    }
+    
+    if( lineLength > 0 )
+        *dest++ = '\n';
+    
+    writeText("-----END ", 9);
+    writeText(label, labelLength);
+    writeText("-----\n", 6);
+    
+    jassert(static_cast<size_t>(dest - start) == getPEMBlockSize(numBytes, label));
+    return static_cast<size_t>(dest - start);
+}
+
+juce::String PEMHelpers::convertDERToPEMString(const void* der, size_t numBytes, const char* label)
+{
+    juce::HeapBlock<char> text(getPEMBlockSize(numBytes, label));
+    auto numChars = writePEMBlock(der, numBytes, label, text.get());
+    
+    return juce::String::fromUTF8(text.get(), static_cast<int>(numChars));
+}
+
+juce::BigInteger PEMHelpers::convertBigEndianBytesToBigInteger(const void* data,
+                                                               size_t numBytes,
+                                                               bool isSigned)
+{
+    auto bytes = static_cast<const juce::uint8*>(data);
+    auto isNegative = isSigned && numBytes > 0 && (bytes[0] & 0x80) != 0;
+    
+    juce::BigInteger result;
+    
+    /*
+     fill in one 32-bit word at a time, starting with the most significant one,
+     so the BigInteger only has to allocate its storage once.
+     */
+    for( auto word = (numBytes + 3) / 4; word-- > 0; )
+    {
+        juce::uint32 value = 0;
+        for( auto i = word * 4 + 4; i-- > word * 4; )
+        {
+            if( i < numBytes )
+                value = (value << 8) | bytes[numBytes - 1 - i];
+        }
+        
+        if( value != 0 )
+            result.setBitRangeAsInt(static_cast<int>(word * 32), 32, value);
+    }
+    
+    if( isNegative )
+    {
+        juce::BigInteger twoToTheN;
+        twoToTheN.setBit(static_cast<int>(numBytes * 8));
+        result -= twoToTheN;
+    }
+    
+    return result;
+}
+
+bool PEMHelpers::writeBigIntegerAsBigEndianBytes(const juce::BigInteger& value,
+                                                 void* dest,
+                                                 size_t numBytes)
+{
+    auto numBitsNeeded = static_cast<size_t>(value.getHighestBit() + 1);
+    if( numBitsNeeded > numBytes * 8 )
+        return false;
+    
+    auto bytes = static_cast<juce::uint8*>(dest);
+    for( size_t word = 0; word * 4 < numBytes; ++word )
+    {
+        auto bits = value.getBitRangeAsInt(static_cast<int>(word * 32), 32);
+        for( size_t i = word * 4; i < word * 4 + 4 && i < numBytes; ++i )
+        {
+            bytes[numBytes - 1 - i] = static_cast<juce::uint8>(bits & 0xff);
+            bits >>= 8;
+        }
+    }
+    
+    return true;
+}
+
+size_t PEMHelpers::getNumDERIntegerBytes(const juce::BigInteger& value)
+{
+    /*
+     a non-negative value needs a leading zero byte whenever its top bit lands on bit 7 of a byte.
+     a negative value -x needs the same number of bytes as x - 1.
+     */
+    if( value.isNegative() )
+    {
+        auto magnitudeMinusOne = -value;
+        --magnitudeMinusOne;
+        return static_cast<size_t>((magnitudeMinusOne.getHighestBit() + 1) / 8 + 1);
+    }
+    
+    return static_cast<size_t>((value.getHighestBit() + 1) / 8 + 1);
+}
+
+void PEMHelpers::writeDERIntegerBytes(const juce::BigInteger& value, void* dest)
+{
+    auto numBytes = getNumDERIntegerBytes(value);
+    auto bytes = static_cast<juce::uint8*>(dest);
+    
+    if( ! value.isNegative() )
+    {
+        auto ok = writeBigIntegerAsBigEndianBytes(value, bytes, numBytes);
+        jassert(ok);
+        juce::ignoreUnused(ok);
+        return;
+    }
+    
+    //two's complement: -x == ~(x - 1)
+    auto magnitudeMinusOne = -value;
+    --magnitudeMinusOne;
+    auto ok = writeBigIntegerAsBigEndianBytes(magnitudeMinusOne, bytes, numBytes);
+    jassert(ok);
+    juce::ignoreUnused(ok);
+    
+    for( size_t i = 0; i < numBytes; ++i )
+        bytes[i] = static_cast<juce::uint8>(~bytes[i]);
+}
@@ -12,32 +12,116 @@
 
 #include <JuceHeader.h>
 
+#include "Base64Decoder.h"
+
 struct PEMHelpers
 {
     static juce::MemoryBlock convertPEMStringToPEMMemoryBlock(juce::String pemString)
     {
         juce::MemoryBlock mb;
-        {
-            juce::MemoryOutputStream mos(mb, false);
-            auto ok = juce::Base64::convertFromBase64(mos, pemString);
-            jassert(ok);
-            juce::ignoreUnused(ok);
-        }
+        convertPEMStringToPEMMemoryBlock(pemString, mb);
         
         return mb;
     }
     
-    static juce::String convertPEMMemoryBlockToPEMString(juce::MemoryBlock byteArray)
+    ///decodes base64 into 'destination', reusing the storage it already has.  line breaks are skipped
+    static bool convertPEMStringToPEMMemoryBlock(const juce::String& pemString, juce::MemoryBlock& destination)
     {
-        juce::MemoryBlock resultBlock;
-        juce::MemoryOutputStream resultMOS(resultBlock, false);
-        juce::Base64::convertToBase64(resultMOS, byteArray.getData(), byteArray.getSize());
+        auto ok = Base64Decoder::decode(pemString.toRawUTF8(), pemString.getNumBytesAsUTF8(), destination);
+        jassert(ok);
         
-        auto result = resultBlock.toString();
+        return ok;
+    }
+    
+    /**
+     Decodes the base64 between the -----BEGIN and -----END lines of a PEM file into 'destination'.
+     The body is decoded where it is, line breaks and all, instead of being joined into a new string first.
+     */
+    static bool convertPEMBodyToPEMMemoryBlock(const juce::String& pem, juce::MemoryBlock& destination);
+    
+    /**
+     Where one -----BEGIN <label>----- ... -----END <label>----- pair sits in some text.
+     Everything is a byte offset from the start of the text.
+     */
+    struct PEMBlock
+    {
+        ///from the first dash of -----BEGIN to just past the dashes that close the -----END line
+        size_t begin = 0, end = 0;
+        ///e.g. "PUBLIC KEY"
+        size_t labelStart = 0, labelLength = 0;
+        ///the base64 between the two lines, line breaks included
+        size_t bodyStart = 0, bodyLength = 0;
         
-        return result;
+        bool hasLabel(const char* text, const char* label) const noexcept
+        {
+            auto length = std::strlen(label);
+            return length == labelLength && std::memcmp(text + labelStart, label, length) == 0;
+        }
+    };
+    
+    /**
+     Finds the first complete block at or after 'position'.
+     A block's -----END line must have the same label as its -----BEGIN line.  A block that has no
+     -----END line before the next -----BEGIN, or whose labels differ, is skipped, so it can't swallow
+     the blocks after it.
+     The text doesn't need to be null-terminated, so this works on memory-mapped files.
+     Returns false if there isn't one.
+     */
+    static bool findNextPEMBlock(const char* text, size_t numBytes, size_t position, PEMBlock& block);
+    
+    ///memory-maps a file read-only, so a bundle can be read without copying it.  nullptr if it can't be mapped
+    static std::unique_ptr<juce::MemoryMappedFile> mapFile(const juce::File& file);
+    
+    ///base64 on one line, without the -----BEGIN and -----END lines.  see convertDERToPEMString() for a whole block
+    static juce::String convertPEMMemoryBlockToPEMString(const juce::MemoryBlock& byteArray)
+    {
+        return juce::Base64::toBase64(byteArray.getData(), byteArray.getSize());
     }
     
+    ///the exact number of characters writePEMBlock() writes for 'numBytes' bytes of DER
+    static size_t getPEMBlockSize(size_t numBytes, const char* label) noexcept;
+    
+    /**
+     Writes 'numBytes' bytes of DER as a -----BEGIN <label>----- block, laid out the way OpenSSL writes them:
+     64 characters of base64 to a line, and "\n" after every line, the END line included.
+     The base64 and the line breaks are written in the same pass, into 'dest', which must have room for
+     getPEMBlockSize() characters.  Nothing is null-terminated.
+     'der' may be the last 'numBytes' bytes of 'dest' itself: the text never catches up with the bytes
+     still to be read, so DER can be written and armoured in a single buffer.
+     Returns the number of characters written.
+     */
+    static size_t writePEMBlock(const void* der, size_t numBytes, const char* label, char* dest) noexcept;
+    
+    ///writePEMBlock() into a String
+    static juce::String convertDERToPEMString(const void* der, size_t numBytes, const char* label);
+    
+    /**
+     Loads big-endian bytes straight into a BigInteger, without a hex string in between.
+     With 'isSigned' the bytes are read as the two's-complement content of a DER INTEGER,
+     otherwise they are read as an unsigned magnitude (e.g. an RSA ciphertext).
+     */
+    static juce::BigInteger convertBigEndianBytesToBigInteger(const void* data,
+                                                               size_t numBytes,
+                                                               bool isSigned = true);
+    
+    /**
+     Writes the magnitude of 'value' into 'dest' as exactly 'numBytes' big-endian bytes,
+     padded with leading zeros.
+     Returns false if the value doesn't fit.
+     */
+    static bool writeBigIntegerAsBigEndianBytes(const juce::BigInteger& value,
+                                                void* dest,
+                                                size_t numBytes);
+    
+    ///returns the number of bytes of the minimal two's-complement DER INTEGER encoding of 'value'
+    static size_t getNumDERIntegerBytes(const juce::BigInteger& value);
+    
+    /**
+     Writes the minimal two's-complement DER INTEGER content of 'value' into 'dest',
+     which must have room for getNumDERIntegerBytes(value) bytes.
+     */
+    static void writeDERIntegerBytes(const juce::BigInteger& value, void* dest);
+    
     static juce::String convertPEMPublicKeyToString(juce::String pubKey)
     {
         jassert( pubKey.contains("-----BEGIN"));
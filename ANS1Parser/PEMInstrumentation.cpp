@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    PEMInstrumentation.cpp
+    Created: 17 Oct 2026 10:31:06pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "PEMInstrumentation.h"
+
+namespace
+{
+struct AtomicStageStats
+{
+    std::atomic<juce::int64> count { 0 };
+    std::atomic<juce::int64> totalTicks { 0 };
+    std::atomic<juce::int64> maxTicks { 0 };
+};
+
+AtomicStageStats stageStats[PEMInstrumentation::numStages];
+std::atomic<juce::int64> counters[PEMInstrumentation::numCounters];
+std::atomic<int> asn1MaxDepth { 0 };
+std::atomic<PEMInstrumentation::Listener*> listener { nullptr };
+
+template <typename Type>
+void storeMax(std::atomic<Type>& maximum, Type value) noexcept
+{
+    auto current = maximum.load(std::memory_order_relaxed);
+    while( value > current && ! maximum.compare_exchange_weak(current, value, std::memory_order_relaxed) ) {}
+}
+
+double ticksToMicroseconds(juce::int64 ticks) noexcept
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1.0e6;
+}
+} // namespace
+
+const char* PEMInstrumentation::getName(Stage stage) noexcept
+{
+    switch( stage )
+    {
+        case Stage::unarmor: return "unarmor";
+        case Stage::keyBase64: return "key_base64";
+        case Stage::derWalk: return "der_walk";
+        case Stage::integerImport: return "integer_import";
+        case Stage::validation: return "validation";
+        case Stage::prepare: return "prepare";
+        case Stage::loadDER: return "load_der";
+        case Stage::ciphertextBase64: return "ciphertext_base64";
+        case Stage::modexp: return "modexp";
+        case Stage::decryptBase64: return "decrypt_base64";
+        case Stage::asn1Decode: return "asn1_decode";
+        case Stage::numStages: break;
+    }
+
+    jassertfalse;
+    return "";
+}
+
+const char* PEMInstrumentation::getName(Counter counter) noexcept
+{
+    switch( counter )
+    {
+        case Counter::keysLoaded: return "keys_loaded";
+        case Counter::keyLoadFailures: return "key_load_failures";
+        case Counter::decryptions: return "decryptions";
+        case Counter::decryptFailures: return "decrypt_failures";
+        case Counter::asn1NodesDecoded: return "asn1_nodes_decoded";
+        case Counter::asn1BytesScanned: return "asn1_bytes_scanned";
+        case Counter::numCounters: break;
+    }
+
+    jassertfalse;
+    return "";
+}
+
+PEMInstrumentation::Snapshot PEMInstrumentation::getSnapshot()
+{
+    Snapshot snapshot;
+
+    for( int i = 0; i < numStages; ++i )
+    {
+        snapshot.stages[i].count = stageStats[i].count.load(std::memory_order_relaxed);
+        snapshot.stages[i].totalMicroseconds = ticksToMicroseconds(stageStats[i].totalTicks.load(std::memory_order_relaxed));
+        snapshot.stages[i].maxMicroseconds = ticksToMicroseconds(stageStats[i].maxTicks.load(std::memory_order_relaxed));
+    }
+
+    for( int i = 0; i < numCounters; ++i )
+        snapshot.counters[i] = counters[i].load(std::memory_order_relaxed);
+
+    snapshot.asn1MaxDepth = asn1MaxDepth.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void PEMInstrumentation::reset()
+{
+    for( auto& stats : stageStats )
+    {
+        stats.count.store(0, std::memory_order_relaxed);
+        stats.totalTicks.store(0, std::memory_order_relaxed);
+        stats.maxTicks.store(0, std::memory_order_relaxed);
+    }
+
+    for( auto& counter : counters )
+        counter.store(0, std::memory_order_relaxed);
+
+    asn1MaxDepth.store(0, std::memory_order_relaxed);
+}
+
+void PEMInstrumentation::setListener(Listener* newListener) noexcept
+{
+    listener.store(newListener);
+}
+
+void PEMInstrumentation::recordStage(Stage stage, juce::int64 ticks) noexcept
+{
+    auto& stats = stageStats[static_cast<int>(stage)];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.totalTicks.fetch_add(ticks, std::memory_order_relaxed);
+    storeMax(stats.maxTicks, ticks);
+
+    if( auto* l = listener.load() )
+        l->stageFinished(stage, ticksToMicroseconds(ticks));
+}
+
+void PEMInstrumentation::addToCounter(Counter counter, juce::int64 amount) noexcept
+{
+    counters[static_cast<int>(counter)].fetch_add(amount, std::memory_order_relaxed);
+
+    if( auto* l = listener.load() )
+        l->counterChanged(counter, amount);
+}
+
+void PEMInstrumentation::recordASN1Depth(int depth) noexcept
+{
+    storeMax(asn1MaxDepth, depth);
+}
@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    PEMInstrumentation.h
+    Created: 17 Oct 2026 10:31:06pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Set PEM_INSTRUMENTATION to 1 in your project's preprocessor definitions to time each stage
+ of loading keys and decrypting.  When it is 0 (the default) the PEM_INSTRUMENT macros
+ expand to nothing, so the library pays nothing for it, and getSnapshot() returns zeros.
+ */
+#ifndef PEM_INSTRUMENTATION
+ #define PEM_INSTRUMENTATION 0
+#endif
+
+/**
+ Durations and counts for the stages of loading and using keys.
+
+ Everything is recorded with relaxed atomics, so any thread can record or take a snapshot
+ at any time.  Either poll getSnapshot() from your metrics pipeline, or set a Listener to be
+ told about every stage as it finishes.
+ e.g.:
+ @code
+ auto snapshot = PEMInstrumentation::getSnapshot();
+ const auto& validation = snapshot.getStage(PEMInstrumentation::Stage::validation);
+ metrics.gauge("rsa.validation.mean_us", validation.getMeanMicroseconds());
+ @endcode
+ */
+struct PEMInstrumentation
+{
+    enum class Stage
+    {
+        unarmor,            /**< finding the -----BEGIN/-----END lines of a key */
+        keyBase64,          /**< decoding a key's base64 body */
+        derWalk,            /**< finding a key's integers in its DER */
+        integerImport,      /**< turning a key's integers into juce::BigIntegers */
+        validation,         /**< checking a private key's components against each other */
+        prepare,            /**< computing the Montgomery constants and recoding the exponents */
+        loadDER,            /**< the whole of PEMFormatKey::loadFromDER() */
+        ciphertextBase64,   /**< decoding the base64 of a ciphertext */
+        modexp,             /**< the whole of PEMFormatKey::decryptBytes() */
+        decryptBase64,      /**< the whole of PEMFormatKey::decryptBase64String() */
+        asn1Decode,         /**< the whole of ASN1Decoder::decode() */
+        numStages
+    };
+
+    /**
+     The asn1 counters, like Snapshot::asn1MaxDepth, only cover ASN1Decoder and DERStreamParser.
+     PEMFormatKey finds a key's integers with a DERCursor, which isn't counted, so loading keys
+     leaves them where they were.
+     */
+    enum class Counter
+    {
+        keysLoaded,         /**< keys PEMFormatKey has loaded */
+        keyLoadFailures,    /**< keys PEMFormatKey has refused */
+        decryptions,        /**< ciphertexts decrypted one at a time or in a batch */
+        decryptFailures,    /**< ciphertexts that were out of range or didn't decrypt */
+        asn1NodesDecoded,   /**< nodes read by ASN1Decoder::decode() and DERStreamParser::parse() */
+        asn1BytesScanned,   /**< the bytes those nodes took up */
+        numCounters
+    };
+
+    static constexpr int numStages = static_cast<int>(Stage::numStages);
+    static constexpr int numCounters = static_cast<int>(Counter::numCounters);
+
+    ///a name for the stage that is safe to use as a metric name, e.g. "integer_import"
+    static const char* getName(Stage stage) noexcept;
+    static const char* getName(Counter counter) noexcept;
+
+    struct StageStats
+    {
+        juce::int64 count = 0;
+        double totalMicroseconds = 0;
+        double maxMicroseconds = 0;
+
+        double getMeanMicroseconds() const noexcept { return count > 0 ? totalMicroseconds / static_cast<double>(count) : 0; }
+    };
+
+    struct Snapshot
+    {
+        StageStats stages[numStages];
+        juce::int64 counters[numCounters] = {};
+        ///the deepest tree ASN1Decoder::decode() has built
+        int asn1MaxDepth = 0;
+
+        const StageStats& getStage(Stage stage) const noexcept { return stages[static_cast<int>(stage)]; }
+        juce::int64 getCounter(Counter counter) const noexcept { return counters[static_cast<int>(counter)]; }
+    };
+
+    static constexpr bool isEnabled() noexcept { return PEM_INSTRUMENTATION != 0; }
+
+    ///the totals since the program started or reset() was last called
+    static Snapshot getSnapshot();
+    static void reset();
+
+    /**
+     Called on the thread that did the work, straight after it.
+     Keep the callbacks short: they are on the path of every load and decrypt.
+     */
+    struct Listener
+    {
+        virtual ~Listener() = default;
+        virtual void stageFinished(Stage stage, double microseconds) = 0;
+        virtual void counterChanged(Counter counter, juce::int64 amount) { juce::ignoreUnused(counter, amount); }
+    };
+
+    /**
+     Sets the one listener, or removes it if 'listener' is nullptr.
+     A listener must not be deleted while a thread might still be calling it,
+     so only remove it while no keys are being loaded or used.
+     */
+    static void setListener(Listener* listener) noexcept;
+
+    //==============================================================================
+    ///records the time between two juce::Time::getHighResolutionTicks() readings.  used by PEM_INSTRUMENT_STAGE
+    static void recordStage(Stage stage, juce::int64 ticks) noexcept;
+    static void addToCounter(Counter counter, juce::int64 amount) noexcept;
+    static void recordASN1Depth(int depth) noexcept;
+
+    ///times the rest of the scope it is declared in
+    struct ScopedStage
+    {
+        explicit ScopedStage(Stage stage_) noexcept :
+        stage(stage_),
+        start(juce::Time::getHighResolutionTicks())
+        {
+
+        }
+
+        ~ScopedStage() { recordStage(stage, juce::Time::getHighResolutionTicks() - start); }
+    private:
+        const Stage stage;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+};
+
+#if PEM_INSTRUMENTATION
+ #define PEM_INSTRUMENT_STAGE(stage) const PEMInstrumentation::ScopedStage JUCE_JOIN_MACRO(pemInstrumentedStage, __LINE__) (PEMInstrumentation::Stage::stage)
+ #define PEM_INSTRUMENT_COUNT(counter, amount) PEMInstrumentation::addToCounter(PEMInstrumentation::Counter::counter, amount)
+#else
+ #define PEM_INSTRUMENT_STAGE(stage)
+ #define PEM_INSTRUMENT_COUNT(counter, amount) ((void) 0)
+#endif
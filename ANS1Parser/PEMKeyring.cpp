@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    PEMKeyring.cpp
+    Created: 17 Oct 2026 8:12:49pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "PEMKeyring.h"
+#include "PEMBundleLoader.h"
+#include "DEREncoder.h"
+#include "ObjectIdentifier.h"
+
+PEMKeyring::PEMKeyring(size_t maxNumCachedKeys_) :
+maxNumCachedKeys(juce::jmax(static_cast<size_t>(1), maxNumCachedKeys_))
+{
+
+}
+
+bool PEMKeyring::computeKeyIDs(const void* data,
+                               size_t numBytes,
+                               bool isPrivateKey,
+                               KeyID& fingerprint,
+                               KeyID& modulusID)
+{
+    DERCursor root(data, numBytes);
+
+    //anything but an RSA key is turned away before the integers are touched
+    if( ! KnownOIDs::rsaEncryption.matches(root.getChild(isPrivateKey ? 1 : 0).getChild(0)) )
+    {
+        DBG( "only rsaEncryption keys are supported" );
+        return false;
+    }
+
+    /*
+     a SubjectPublicKeyInfo is already the thing being fingerprinted.
+     a PrivateKeyInfo holds the modulus and public exponent, which get re-encoded as one.
+     */
+    auto rsaKey = isPrivateKey ? root.find({ 2, DERCursor::encapsulated, 0 })
+                               : root.find({ 1, DERCursor::encapsulated, 0 });
+    auto modulus = rsaKey.getChild(isPrivateKey ? 1 : 0);
+    auto exponent = modulus.getNextSibling();
+
+    if( ! modulus.isUniversal(2) || ! exponent.isUniversal(2) || modulus.getContentLength() <= 0 )
+    {
+        DBG( "couldn't find the modulus of the key!" );
+        return false;
+    }
+
+    if( isPrivateKey )
+    {
+        auto spki = DEREncoder::encodeRSASubjectPublicKeyInfo(PEMHelpers::convertBigEndianBytesToBigInteger(modulus.getContent(),
+                                                                                                             static_cast<size_t>(modulus.getContentLength())),
+                                                              PEMHelpers::convertBigEndianBytesToBigInteger(exponent.getContent(),
+                                                                                                             static_cast<size_t>(exponent.getContentLength())));
+        fingerprint = KeyID::fromSHA256(juce::SHA256(spki));
+    }
+    else
+    {
+        fingerprint = KeyID::fromSHA256(juce::SHA256(data, root.getEnd()));
+    }
+
+    //the modulus is positive, so any leading zeros are just the sign byte
+    auto modulusBytes = modulus.getContent();
+    auto numModulusBytes = static_cast<size_t>(modulus.getContentLength());
+    while( numModulusBytes > 1 && *modulusBytes == 0 )
+    {
+        ++modulusBytes;
+        --numModulusBytes;
+    }
+
+    modulusID = KeyID::fromSHA256(juce::SHA256(modulusBytes, numModulusBytes));
+    return true;
+}
+
+bool PEMKeyring::addDER(const void* data, size_t numBytes, bool isPrivateKey)
+{
+    Entry entry;
+    if( ! computeKeyIDs(data, numBytes, isPrivateKey, entry.fingerprint, entry.modulusID) )
+        return false;
+
+    entry.der = new DERBuffer(data, numBytes);
+    entry.isPrivateKey = isPrivateKey;
+
+    const juce::ScopedLock sl(lock);
+
+    if( byFingerprint.count(entry.fingerprint) != 0 )
+    {
+        DBG( "the keyring already has the key " + entry.fingerprint.toHexString() );
+        return false;
+    }
+
+    auto index = entries.size();
+    byFingerprint.emplace(entry.fingerprint, index);
+    //a private key and its public key share a modulus.  the first one added keeps the modulus ID
+    byModulusID.emplace(entry.modulusID, index);
+    entries.push_back(std::move(entry));
+
+    return true;
+}
+
+int PEMKeyring::addPEMText(const char* text, size_t numBytes)
+{
+    int numAdded = 0;
+    juce::MemoryBlock scratch;
+
+    for( const auto& block : PEMBundleLoader::findBlocks(text, numBytes) )
+    {
+        auto isPrivateKey = block.hasLabel(text, "PRIVATE KEY");
+        if( ! isPrivateKey && ! block.hasLabel(text, "PUBLIC KEY") )
+            continue;
+
+        if( Base64Decoder::decode(text + block.bodyStart, block.bodyLength, scratch)
+            && addDER(scratch.getData(), scratch.getSize(), isPrivateKey) )
+        {
+            ++numAdded;
+        }
+    }
+
+    return numAdded;
+}
+
+int PEMKeyring::addPEMString(const juce::String& pem)
+{
+    return addPEMText(pem.toRawUTF8(), pem.getNumBytesAsUTF8());
+}
+
+int PEMKeyring::addPEMBundleFile(const juce::File& file)
+{
+    auto mappedFile = PEMHelpers::mapFile(file);
+    return mappedFile != nullptr ? addPEMText(static_cast<const char*>(mappedFile->getData()), mappedFile->getSize()) : 0;
+}
+
+int PEMKeyring::getNumKeys() const
+{
+    const juce::ScopedLock sl(lock);
+    return static_cast<int>(entries.size());
+}
+
+int PEMKeyring::getNumCachedKeys() const
+{
+    const juce::ScopedLock sl(lock);
+    return static_cast<int>(leastRecentlyUsed.size());
+}
+
+PEMKeyring::CachedKey::Ptr PEMKeyring::findByFingerprint(const KeyID& fingerprint)
+{
+    return find(byFingerprint, fingerprint);
+}
+
+PEMKeyring::CachedKey::Ptr PEMKeyring::findByModulusID(const KeyID& modulusID)
+{
+    return find(byModulusID, modulusID);
+}
+
+PEMKeyring::CachedKey::Ptr PEMKeyring::find(const Index& index, const KeyID& keyID)
+{
+    size_t entryIndex = 0;
+
+    auto getEntry = [&]() -> Entry*
+    {
+        auto found = index.find(keyID);
+        if( found == index.end() )
+            return nullptr;
+
+        entryIndex = found->second;
+        return &entries[entryIndex];
+    };
+
+    //the private key checks and the decrypt precomputation run here, on a miss
+    auto load = [](const Entry& entry) -> CachedKey::Ptr
+    {
+        CachedKey::Ptr loaded = new CachedKey(entry.fingerprint, entry.modulusID);
+        loaded->key.setAssertOnMalformedInput(false);
+        return loaded->key.loadFromDER(entry.der->getData(), entry.der->getSize(), entry.isPrivateKey) ? loaded : nullptr;
+    };
+
+    //keeps the most recently used keys loaded, and lets go of the rest
+    auto used = [this, &entryIndex](Entry& entry, bool justLoaded)
+    {
+        if( ! justLoaded )
+        {
+            leastRecentlyUsed.splice(leastRecentlyUsed.begin(), leastRecentlyUsed, entry.lruPosition);
+            return;
+        }
+
+        leastRecentlyUsed.push_front(entryIndex);
+        entry.lruPosition = leastRecentlyUsed.begin();
+
+        while( leastRecentlyUsed.size() > maxNumCachedKeys )
+        {
+            entries[leastRecentlyUsed.back()].cached = nullptr;
+            leastRecentlyUsed.pop_back();
+        }
+    };
+
+    return LazyKeySlot::getOrLoad(lock, getEntry, load, used);
+}
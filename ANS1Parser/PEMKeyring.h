@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    PEMKeyring.h
+    Created: 17 Oct 2026 8:12:49pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PEMFormatKey.h"
+#include "ASN1Decoder.h"
+#include "CachedKey.h"
+#include "KeyID.h"
+
+/**
+ A set of keys that can be looked up by identifier.
+
+ Adding a key only reads enough of its DER to work out its identifiers:
+ - its fingerprint, the SHA-256 of its SubjectPublicKeyInfo DER
+   (private keys are fingerprinted by the public key they contain)
+ - its modulus ID, the SHA-256 of its modulus as unsigned big-endian bytes
+ The full load, with the private key checks and the decrypt precomputation, happens the
+ first time a key is looked up.  The most recently used keys stay loaded, up to a limit,
+ so a repeat lookup is one hash probe.
+
+ Lookups can be made from any number of threads.
+ e.g.:
+ @code
+ PEMKeyring keyring(1024);
+ keyring.addPEMBundleFile(bundleFile);
+
+ PEMKeyring::KeyID keyID;
+ if( PEMKeyring::KeyID::fromHexString(token.keyID, keyID) )
+     if( auto cached = keyring.findByFingerprint(keyID) )
+         plaintext = cached->key.decryptBase64String(token.ciphertext);
+ @endcode
+ */
+struct PEMKeyring
+{
+    using KeyID = ::KeyID;
+    ///a loaded key, which stays valid after the keyring has let go of it
+    using CachedKey = ::CachedKey;
+
+    ///'maxNumCachedKeys' is the number of loaded keys to keep
+    explicit PEMKeyring(size_t maxNumCachedKeys = 256);
+
+    /**
+     Adds one DER-encoded key: a SubjectPublicKeyInfo, or a PKCS#8 PrivateKeyInfo if 'isPrivateKey' is true.
+     Returns false if its identifiers can't be read or a key with the same fingerprint is already there.
+     */
+    bool addDER(const void* data, size_t numBytes, bool isPrivateKey);
+
+    ///adds every PUBLIC KEY and PRIVATE KEY block in the text and returns the number added
+    int addPEMText(const char* text, size_t numBytes);
+    int addPEMString(const juce::String& pem);
+    ///memory-maps the file and adds every key block in it
+    int addPEMBundleFile(const juce::File& file);
+
+    int getNumKeys() const;
+    int getNumCachedKeys() const;
+
+    /**
+     Returns the key with this fingerprint, loading it if it isn't cached, or nullptr if there's no such key
+     or it doesn't load.  A key that fails to load is remembered, and isn't loaded again.
+     */
+    CachedKey::Ptr findByFingerprint(const KeyID& fingerprint);
+    ///the same, by modulus ID
+    CachedKey::Ptr findByModulusID(const KeyID& modulusID);
+
+    ///works out the identifiers of a DER-encoded key without loading it
+    static bool computeKeyIDs(const void* data, size_t numBytes, bool isPrivateKey, KeyID& fingerprint, KeyID& modulusID);
+private:
+    using Index = std::unordered_map<KeyID, size_t, KeyID::Hash>;
+
+    ///a key's DER and identifiers, and the key itself while it is one of the most recently used
+    struct Entry : LazyKeySlot
+    {
+        DERBuffer::Ptr der;
+        bool isPrivateKey = false;
+        KeyID fingerprint, modulusID;
+
+        ///where the entry sits in 'leastRecentlyUsed', if it is cached
+        std::list<size_t>::iterator lruPosition;
+    };
+
+    const size_t maxNumCachedKeys;
+
+    juce::CriticalSection lock;
+    std::vector<Entry> entries;
+    Index byFingerprint, byModulusID;
+    ///indices into 'entries' of the cached keys, most recently used first
+    std::list<size_t> leastRecentlyUsed;
+
+    CachedKey::Ptr find(const Index& index, const KeyID& keyID);
+
+    JUCE_DECLARE_NON_COPYABLE(PEMKeyring)
+};
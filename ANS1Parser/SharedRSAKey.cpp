@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    SharedRSAKey.cpp
+    Created: 18 Oct 2026 3:21:37am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "SharedRSAKey.h"
+
+SharedRSAKey::SharedRSAKey(const PEMFormatKey& key_, const PEMFormatKey& publicKey_) :
+key(key_),
+publicKey(publicKey_)
+{
+
+}
+
+SharedRSAKey::Ptr SharedRSAKey::create(const PEMFormatKey& key)
+{
+    if( key.getMaxPlaintextSize() == 0 )
+    {
+        DBG( "the key hasn't been loaded!" );
+        jassertfalse;
+        return nullptr;
+    }
+
+    //the public half of a private key is loaded on its own, which prepares its exponent once, here
+    PEMFormatKey publicKey;
+    juce::MemoryBlock publicKeyDER;
+
+    if( key.isPrivateKey() && key.exportToDER(PEMFormatKey::DERFormat::pkcs1PublicKey, publicKeyDER) )
+    {
+        publicKey.setValidation(PEMFormatKey::Validation::none);
+        if( ! publicKey.loadFromDER(publicKeyDER.getData(), publicKeyDER.getSize(), PEMFormatKey::DERFormat::pkcs1PublicKey) )
+            return nullptr;
+    }
+
+    return new SharedRSAKey(key, publicKey);
+}
+
+PEMFormatKey::DecryptScratch& SharedRSAKey::getThreadScratch()
+{
+    thread_local DecryptScratch scratch;
+    return scratch;
+}
+
+bool SharedRSAKey::decrypt(const void* ciphertext,
+                           size_t numCiphertextBytes,
+                           void* plaintext,
+                           size_t maxPlaintextBytes,
+                           size_t& numPlaintextBytes,
+                           DecryptScratch* scratch) const
+{
+    return key.decrypt(ciphertext, numCiphertextBytes, plaintext, maxPlaintextBytes, numPlaintextBytes,
+                       scratch != nullptr ? scratch : &getThreadScratch());
+}
+
+bool SharedRSAKey::decryptBase64(const char* base64,
+                                 size_t numChars,
+                                 void* plaintext,
+                                 size_t maxPlaintextBytes,
+                                 size_t& numPlaintextBytes,
+                                 DecryptScratch* scratch) const
+{
+    return key.decryptBase64(base64, numChars, plaintext, maxPlaintextBytes, numPlaintextBytes,
+                             scratch != nullptr ? scratch : &getThreadScratch());
+}
+
+int SharedRSAKey::decryptBatch(Decryption* decryptions, size_t numDecryptions, DecryptScratch* scratch) const
+{
+    return key.decryptBatch(decryptions, numDecryptions, scratch != nullptr ? scratch : &getThreadScratch());
+}
+
+bool SharedRSAKey::encryptBytes(const void* plaintext, size_t numBytes, juce::MemoryBlock& result) const
+{
+    return getPublicKey().encryptBytes(plaintext, numBytes, result);
+}
+
+bool SharedRSAKey::verifySignature(const SignatureCheck& check) const
+{
+    return getPublicKey().verifySignature(check);
+}
+
+int SharedRSAKey::verifySignatures(const SignatureCheck* checks, size_t numChecks, bool* results) const
+{
+    return getPublicKey().verifySignatures(checks, numChecks, results);
+}
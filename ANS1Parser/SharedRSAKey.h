@@ -0,0 +1,100 @@
+/*
+  ==============================================================================
+
+    SharedRSAKey.h
+    Created: 18 Oct 2026 3:21:37am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PEMFormatKey.h"
+
+/**
+ A loaded key that is never modified again, for decrypting with it from any number of threads at once.
+
+ A PEMFormatKey is a juce::RSAKey that can be reloaded at any time, so sharing one between threads
+ takes a lock or a copy per thread.  A SharedRSAKey is created once from a key that has been loaded
+ and checked.  It keeps its own copy of everything it works from, and only has const methods, so
+ it can be shared without any locking.  For a private key the public exponent is prepared when it
+ is created too, so encrypting and checking signatures don't prepare it on every call.
+
+ Everything that changes during a call is on the stack or in a PEMFormatKey::DecryptScratch.
+ Calls that aren't given one use the calling thread's own (see getThreadScratch()), so threads never
+ write to the same memory and decrypting scales with the number of cores.  Copying a Ptr writes to
+ the key's reference count, so give each thread its own Ptr rather than copying one for every call.
+ e.g.:
+ @code
+ auto sharedKey = SharedRSAKey::create(rsaKey);
+
+ //on any thread
+ if( sharedKey->decryptBase64(base64, numChars, plaintext, maxPlaintextBytes, numPlaintextBytes) )
+     handleMessage(plaintext, numPlaintextBytes);
+ @endcode
+ */
+struct SharedRSAKey : juce::ReferenceCountedObject
+{
+    using Ptr = juce::ReferenceCountedObjectPtr<SharedRSAKey>;
+    using DecryptScratch = PEMFormatKey::DecryptScratch;
+    using Decryption = PEMFormatKey::Decryption;
+    using SignatureCheck = PEMFormatKey::SignatureCheck;
+
+    /**
+     Takes a copy of a key that has been loaded, which can then be reloaded or destroyed.
+     Returns nullptr if nothing has been loaded into it.
+     */
+    static Ptr create(const PEMFormatKey& key);
+
+    ///the scratch calls use when they aren't given one.  each thread has its own, which is freed when the thread ends
+    static DecryptScratch& getThreadScratch();
+
+    ///see PEMFormatKey::getMaxPlaintextSize()
+    size_t getMaxPlaintextSize() const { return key.getMaxPlaintextSize(); }
+
+    ///returns true if it was created from a private key (see PEMFormatKey::isPrivateKey())
+    bool isPrivateKey() const { return key.isPrivateKey(); }
+
+    ///see PEMFormatKey::decrypt()
+    bool decrypt(const void* ciphertext,
+                 size_t numCiphertextBytes,
+                 void* plaintext,
+                 size_t maxPlaintextBytes,
+                 size_t& numPlaintextBytes,
+                 DecryptScratch* scratch = nullptr) const;
+
+    ///see PEMFormatKey::decryptBase64()
+    bool decryptBase64(const char* base64,
+                       size_t numChars,
+                       void* plaintext,
+                       size_t maxPlaintextBytes,
+                       size_t& numPlaintextBytes,
+                       DecryptScratch* scratch = nullptr) const;
+
+    ///see PEMFormatKey::decryptBatch()
+    int decryptBatch(Decryption* decryptions, size_t numDecryptions, DecryptScratch* scratch = nullptr) const;
+
+    /**
+     see PEMFormatKey::encryptBytes().
+     Returns false for a key created from one that was loaded with PEMFormatKey::loadFromPreparedKey().
+     */
+    bool encryptBytes(const void* plaintext, size_t numBytes, juce::MemoryBlock& result) const;
+
+    ///see PEMFormatKey::verifySignature()
+    bool verifySignature(const SignatureCheck& check) const;
+    int verifySignatures(const SignatureCheck* checks, size_t numChecks, bool* results) const;
+private:
+    SharedRSAKey(const PEMFormatKey& key_, const PEMFormatKey& publicKey_);
+
+    ///only ever used through its const methods
+    const PEMFormatKey key;
+    ///for a private key, its public half loaded on its own.  empty for a public key, which is its own public half
+    const PEMFormatKey publicKey;
+
+    const PEMFormatKey& getPublicKey() const noexcept { return key.isPrivateKey() ? publicKey : key; }
+
+    JUCE_DECLARE_NON_COPYABLE(SharedRSAKey)
+};
@@ -0,0 +1,190 @@
+/*
+  ==============================================================================
+
+    WorkStealingThreadPool.cpp
+    Created: 17 Oct 2026 1:18:52pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "WorkStealingThreadPool.h"
+
+struct WorkStealingThreadPool::Worker : juce::Thread
+{
+    Worker(WorkStealingThreadPool& owner_, int index_) :
+    juce::Thread("WorkStealingThreadPool worker " + juce::String(index_)),
+    owner(owner_),
+    index(index_)
+    {
+
+    }
+
+    void run() override
+    {
+        for (;;)
+        {
+            wakeUp.wait(-1);
+
+            if( threadShouldExit() )
+                return;
+
+            owner.runWorker(index);
+
+            if( owner.numBusyWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1 )
+                owner.batchFinished.signal();
+        }
+    }
+
+    WorkStealingThreadPool& owner;
+    const int index;
+    juce::WaitableEvent wakeUp;
+};
+
+WorkStealingThreadPool::WorkStealingThreadPool(int numWorkers_) :
+numWorkers(juce::jmax(1, numWorkers_)),
+shares(new Share[static_cast<size_t>(juce::jmax(1, numWorkers_))])
+{
+    for( int i = 1; i < numWorkers; ++i )
+        workers.add(new Worker(*this, i))->startThread();
+}
+
+WorkStealingThreadPool::~WorkStealingThreadPool()
+{
+    for( auto* worker : workers )
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.signal();
+    }
+
+    for( auto* worker : workers )
+        worker->stopThread(-1);
+}
+
+void WorkStealingThreadPool::parallelFor(size_t numItems, size_t chunkSize, const Job& job)
+{
+    if( numItems == 0 )
+        return;
+
+    /*
+     a job that calls back into its own pool.  on workers 1..n taking the lock would wait for
+     the batch that is running the job, forever.  on worker 0 the lock is re-entrant, and
+     starting a batch would overwrite the one that is running.
+     */
+    auto workerIndex = getCurrentWorkerIndex();
+    if( workerIndex > 0 )
+    {
+        jassertfalse;
+        job(workerIndex, 0, numItems);
+        return;
+    }
+
+    const juce::ScopedLock sl(batchLock);
+
+    if( currentJob != nullptr )
+    {
+        jassertfalse;
+        job(0, 0, numItems);
+        return;
+    }
+
+    runBatch(numItems, chunkSize, job);
+}
+
+bool WorkStealingThreadPool::tryParallelFor(size_t numItems, size_t chunkSize, const Job& job)
+{
+    if( numItems == 0 )
+        return true;
+
+    const juce::ScopedTryLock sl(batchLock);
+
+    //the lock is re-entrant, so a job that calls back into its own pool would get it
+    if( ! sl.isLocked() || currentJob != nullptr )
+        return false;
+
+    runBatch(numItems, chunkSize, job);
+    return true;
+}
+
+bool WorkStealingThreadPool::allOf(WorkStealingThreadPool* pool, size_t numTasks, const std::function<bool(size_t)>& task)
+{
+    std::atomic<bool> allPassed { true };
+
+    Job job = [&](int, size_t begin, size_t end)
+    {
+        for( auto i = begin; i < end && allPassed.load(std::memory_order_relaxed); ++i )
+            if( ! task(i) )
+                allPassed.store(false, std::memory_order_relaxed);
+    };
+
+    if( pool == nullptr || ! pool->tryParallelFor(numTasks, 1, job) )
+        job(0, 0, numTasks);
+
+    return allPassed.load();
+}
+
+int WorkStealingThreadPool::getCurrentWorkerIndex() const
+{
+    auto* currentThread = juce::Thread::getCurrentThread();
+    for( auto* worker : workers )
+        if( worker == currentThread )
+            return worker->index;
+
+    return -1;
+}
+
+void WorkStealingThreadPool::runBatch(size_t numItems, size_t chunkSize, const Job& job)
+{
+    currentJob = &job;
+    currentNumItems = numItems;
+    currentChunkSize = juce::jmax(static_cast<size_t>(1), chunkSize);
+
+    auto numChunks = (numItems + currentChunkSize - 1) / currentChunkSize;
+    auto numShares = static_cast<size_t>(numWorkers);
+    for( size_t i = 0; i < numShares; ++i )
+    {
+        shares[i].next.store(numChunks * i / numShares, std::memory_order_relaxed);
+        shares[i].end = numChunks * (i + 1) / numShares;
+    }
+
+    if( numChunks == 1 || workers.size() == 0 )
+    {
+        runWorker(0);
+    }
+    else
+    {
+        batchFinished.reset();
+        numBusyWorkers.store(workers.size(), std::memory_order_release);
+
+        for( auto* worker : workers )
+            worker->wakeUp.signal();
+
+        runWorker(0);
+        batchFinished.wait(-1);
+    }
+
+    currentJob = nullptr;
+}
+
+void WorkStealingThreadPool::runWorker(int workerIndex)
+{
+    /*
+     work through our own share first, then visit the other workers' shares
+     and take whatever chunks they haven't started yet.
+     */
+    for( int i = 0; i < numWorkers; ++i )
+    {
+        auto& share = shares[static_cast<size_t>((workerIndex + i) % numWorkers)];
+
+        for (;;)
+        {
+            auto chunk = share.next.fetch_add(1, std::memory_order_relaxed);
+            if( chunk >= share.end )
+                break;
+
+            auto begin = chunk * currentChunkSize;
+            auto end = juce::jmin(begin + currentChunkSize, currentNumItems);
+            (*currentJob)(workerIndex, begin, end);
+        }
+    }
+}
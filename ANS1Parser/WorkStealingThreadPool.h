@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    WorkStealingThreadPool.h
+    Created: 17 Oct 2026 1:18:52pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ A fixed set of worker threads that run a loop over a range of items in parallel.
+
+ parallelFor() splits the range into chunks and gives each worker an equal share of them.
+ A worker that runs out of chunks steals the remaining chunks of the other workers,
+ so uneven chunk costs don't leave threads idle.
+ The calling thread takes part as worker 0, so a pool with one worker runs everything inline.
+
+ Jobs must not call back into the pool that is running them.  If one does, parallelFor()
+ asserts and runs the whole range inline on the calling worker, and tryParallelFor() returns false.
+ */
+struct WorkStealingThreadPool
+{
+    /**
+     Called with the index of the worker running it (0 to getNumWorkers() - 1)
+     and the half-open range of items to process.
+     */
+    using Job = std::function<void(int workerIndex, size_t begin, size_t end)>;
+
+    explicit WorkStealingThreadPool(int numWorkers = juce::SystemStats::getNumCpus());
+    ~WorkStealingThreadPool();
+
+    int getNumWorkers() const noexcept { return numWorkers; }
+
+    /**
+     Runs 'job' over the items [0, numItems) in chunks of 'chunkSize' and returns when every chunk is done.
+     Calls from different threads are run one after the other.
+     */
+    void parallelFor(size_t numItems, size_t chunkSize, const Job& job);
+
+    /**
+     The same as parallelFor(), unless the pool is already running a batch, in which case
+     it returns false straight away without running anything.
+     */
+    bool tryParallelFor(size_t numItems, size_t chunkSize, const Job& job);
+
+    /**
+     Runs task(0) to task(numTasks - 1) and returns true if every one of them returned true.
+     The tasks run at the same time on 'pool' if it is free, otherwise one after the other on
+     the calling thread, as they also do if 'pool' is nullptr.
+     Once a task has failed, the ones that haven't started yet are skipped.
+     */
+    static bool allOf(WorkStealingThreadPool* pool, size_t numTasks, const std::function<bool(size_t)>& task);
+private:
+    struct Worker;
+
+    ///the chunks initially assigned to one worker.  other workers steal from it by bumping 'next'
+    struct alignas(64) Share
+    {
+        std::atomic<size_t> next { 0 };
+        size_t end = 0;
+    };
+
+    const int numWorkers;
+    juce::OwnedArray<Worker> workers;
+    std::unique_ptr<Share[]> shares;
+
+    juce::CriticalSection batchLock;
+    const Job* currentJob = nullptr;
+    size_t currentNumItems = 0;
+    size_t currentChunkSize = 1;
+    std::atomic<int> numBusyWorkers { 0 };
+    juce::WaitableEvent batchFinished;
+
+    ///the index of the worker thread calling this, or -1 if it isn't one of workers 1..n
+    int getCurrentWorkerIndex() const;
+
+    ///called with batchLock held
+    void runBatch(size_t numItems, size_t chunkSize, const Job& job);
+    void runWorker(int workerIndex);
+
+    JUCE_DECLARE_NON_COPYABLE(WorkStealingThreadPool)
+};
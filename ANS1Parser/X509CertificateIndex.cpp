@@ -0,0 +1,280 @@
+/*
+  ==============================================================================
+
+    X509CertificateIndex.cpp
+    Created: 18 Oct 2026 2:05:48am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "X509CertificateIndex.h"
+#include "Base64Decoder.h"
+#include "DERCursor.h"
+#include "PEMBundleLoader.h"
+#include "PEMKeyring.h"
+
+#include <string_view>
+
+namespace
+{
+///a hash of the serial number's value, so that it doesn't matter whether it has a sign byte
+size_t hashSerialNumber(const juce::uint8* serial, size_t numBytes)
+{
+    while( numBytes > 1 && *serial == 0 )
+    {
+        ++serial;
+        --numBytes;
+    }
+
+    return std::hash<std::string_view>()(std::string_view(reinterpret_cast<const char*>(serial), numBytes));
+}
+
+bool isSameSerialNumber(const juce::uint8* a, size_t numA, const juce::uint8* b, size_t numB)
+{
+    while( numA > 1 && *a == 0 ) { ++a; --numA; }
+    while( numB > 1 && *b == 0 ) { ++b; --numB; }
+
+    return numA == numB && std::memcmp(a, b, numA) == 0;
+}
+} // namespace
+
+bool X509CertificateIndex::readCertificate(const DERBuffer::Ptr& der, size_t offset, size_t end, Certificate& certificate)
+{
+    /*
+     Certificate ::= SEQUENCE { tbsCertificate, signatureAlgorithm, signatureValue }
+     TBSCertificate ::= SEQUENCE { [0] version OPTIONAL, serialNumber, signature, issuer,
+                                   validity, subject, subjectPublicKeyInfo, ... }
+     */
+    DERCursor root(der->getData(), end, offset);
+    auto tbsCertificate = root.getChild(0);
+    if( ! root.isUniversal(0x10) || ! tbsCertificate.isUniversal(0x10) )
+        return false;
+
+    auto serialNumber = tbsCertificate.getChild(0);
+
+    //the version is an explicit [0], and v1 certificates leave it out
+    if( serialNumber.isValid() && serialNumber.getTag().tagClass == 2 && serialNumber.getTag().tagNumber == 0 )
+        serialNumber = serialNumber.getNextSibling();
+
+    auto issuer = serialNumber.getNextSibling().getNextSibling();
+    auto subject = issuer.getNextSibling().getNextSibling();
+    auto publicKey = subject.getNextSibling();
+
+    if( ! serialNumber.isUniversal(0x02) || serialNumber.getContentLength() <= 0
+        || ! subject.isUniversal(0x10) || ! publicKey.isUniversal(0x10) )
+    {
+        return false;
+    }
+
+    auto certificateEnd = root.getEnd();
+    auto subjectEnd = subject.getEnd();
+    auto publicKeyEnd = publicKey.getEnd();
+    if( certificateEnd == 0 || subjectEnd == 0 || publicKeyEnd == 0 )
+        return false;
+
+    certificate.der = der;
+    certificate.offset = offset;
+    certificate.numBytes = certificateEnd - offset;
+    certificate.serialOffset = static_cast<size_t>(serialNumber.getContent() - der->getData());
+    certificate.numSerialBytes = static_cast<size_t>(serialNumber.getContentLength());
+    certificate.subjectOffset = subject.getOffset();
+    certificate.numSubjectBytes = subjectEnd - subject.getOffset();
+    certificate.publicKeyOffset = publicKey.getOffset();
+    certificate.numPublicKeyBytes = publicKeyEnd - publicKey.getOffset();
+    certificate.subjectHash = hashName(certificate.getBytes(certificate.subjectOffset), certificate.numSubjectBytes);
+
+    return true;
+}
+
+X509CertificateIndex::KeyID X509CertificateIndex::hashName(const void* nameDER, size_t numBytes)
+{
+    return KeyID::fromSHA256(juce::SHA256(nameDER, numBytes));
+}
+
+void X509CertificateIndex::addEntries(std::vector<Entry>&& newEntries)
+{
+    const juce::ScopedLock sl(lock);
+
+    entries.reserve(entries.size() + newEntries.size());
+    for( auto& entry : newEntries )
+    {
+        const auto& certificate = entry.certificate;
+        auto index = static_cast<int>(entries.size());
+
+        bySubject.emplace(certificate.subjectHash, index);
+        bySerialNumber.emplace(hashSerialNumber(certificate.getBytes(certificate.serialOffset), certificate.numSerialBytes), index);
+        entries.push_back(std::move(entry));
+    }
+}
+
+int X509CertificateIndex::addDER(const void* data, size_t numBytes)
+{
+    DERBuffer::Ptr der = new DERBuffer(data, numBytes);
+    std::vector<Entry> newEntries;
+
+    for( size_t offset = 0; offset < numBytes; )
+    {
+        Entry entry;
+        if( ! readCertificate(der, offset, numBytes, entry.certificate) )
+        {
+            DBG( "couldn't read the certificate at offset " + juce::String(static_cast<juce::int64>(offset)) );
+            break;
+        }
+
+        offset += entry.certificate.numBytes;
+        newEntries.push_back(std::move(entry));
+    }
+
+    auto numAdded = static_cast<int>(newEntries.size());
+    addEntries(std::move(newEntries));
+    return numAdded;
+}
+
+int X509CertificateIndex::addDERFile(const juce::File& file)
+{
+    auto mappedFile = PEMHelpers::mapFile(file);
+    return mappedFile != nullptr ? addDER(mappedFile->getData(), mappedFile->getSize()) : 0;
+}
+
+int X509CertificateIndex::addPEMText(const char* text, size_t numBytes)
+{
+    std::vector<PEMHelpers::PEMBlock> blocks;
+    size_t maxNumDecodedBytes = 0;
+
+    for( const auto& block : PEMBundleLoader::findBlocks(text, numBytes) )
+    {
+        if( block.hasLabel(text, "CERTIFICATE") || block.hasLabel(text, "TRUSTED CERTIFICATE") )
+        {
+            blocks.push_back(block);
+            maxNumDecodedBytes += Base64Decoder::getMaxDecodedSize(block.bodyLength);
+        }
+    }
+
+    //every certificate is decoded into the one buffer, one after the other
+    juce::MemoryBlock decoded(maxNumDecodedBytes, false);
+    std::vector<std::pair<size_t, size_t>> ranges;
+    size_t numDecodedBytes = 0;
+
+    for( const auto& block : blocks )
+    {
+        size_t numBlockBytes = 0;
+        if( Base64Decoder::decode(text + block.bodyStart, block.bodyLength,
+                                  static_cast<juce::uint8*>(decoded.getData()) + numDecodedBytes, numBlockBytes) )
+        {
+            ranges.emplace_back(numDecodedBytes, numDecodedBytes + numBlockBytes);
+            numDecodedBytes += numBlockBytes;
+        }
+    }
+
+    decoded.setSize(numDecodedBytes);
+    DERBuffer::Ptr der = new DERBuffer(std::move(decoded));
+    std::vector<Entry> newEntries;
+
+    for( const auto& range : ranges )
+    {
+        Entry entry;
+        if( readCertificate(der, range.first, range.second, entry.certificate) )
+            newEntries.push_back(std::move(entry));
+    }
+
+    auto numAdded = static_cast<int>(newEntries.size());
+    addEntries(std::move(newEntries));
+    return numAdded;
+}
+
+int X509CertificateIndex::addPEMString(const juce::String& pem)
+{
+    return addPEMText(pem.toRawUTF8(), pem.getNumBytesAsUTF8());
+}
+
+int X509CertificateIndex::addPEMBundleFile(const juce::File& file)
+{
+    auto mappedFile = PEMHelpers::mapFile(file);
+    return mappedFile != nullptr ? addPEMText(static_cast<const char*>(mappedFile->getData()), mappedFile->getSize()) : 0;
+}
+
+int X509CertificateIndex::getNumCertificates() const
+{
+    const juce::ScopedLock sl(lock);
+    return static_cast<int>(entries.size());
+}
+
+bool X509CertificateIndex::getCertificate(int index, Certificate& result) const
+{
+    const juce::ScopedLock sl(lock);
+
+    if( ! juce::isPositiveAndBelow(index, static_cast<int>(entries.size())) )
+        return false;
+
+    result = entries[static_cast<size_t>(index)].certificate;
+    return true;
+}
+
+std::vector<int> X509CertificateIndex::findBySubject(const void* nameDER, size_t numBytes) const
+{
+    return findBySubject(hashName(nameDER, numBytes));
+}
+
+std::vector<int> X509CertificateIndex::findBySubject(const KeyID& subjectHash) const
+{
+    std::vector<int> found;
+    const juce::ScopedLock sl(lock);
+
+    auto range = bySubject.equal_range(subjectHash);
+    for( auto it = range.first; it != range.second; ++it )
+        found.push_back(it->second);
+
+    //the multimap doesn't keep them in the order they were added
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+std::vector<int> X509CertificateIndex::findBySerialNumber(const void* serial, size_t numBytes) const
+{
+    std::vector<int> found;
+    if( numBytes == 0 )
+        return found;
+
+    auto bytes = static_cast<const juce::uint8*>(serial);
+    const juce::ScopedLock sl(lock);
+
+    auto range = bySerialNumber.equal_range(hashSerialNumber(bytes, numBytes));
+    for( auto it = range.first; it != range.second; ++it )
+    {
+        const auto& certificate = entries[static_cast<size_t>(it->second)].certificate;
+        if( isSameSerialNumber(bytes, numBytes, certificate.getBytes(certificate.serialOffset), certificate.numSerialBytes) )
+            found.push_back(it->second);
+    }
+
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+CachedKey::Ptr X509CertificateIndex::getPublicKey(int index)
+{
+    auto getEntry = [this, index]() -> Entry*
+    {
+        return juce::isPositiveAndBelow(index, static_cast<int>(entries.size())) ? &entries[static_cast<size_t>(index)] : nullptr;
+    };
+
+    //certificates for keys that aren't RSA are common in CA bundles, so they're turned away before loading
+    auto load = [](const Entry& entry) -> CachedKey::Ptr
+    {
+        const auto& certificate = entry.certificate;
+        auto publicKey = certificate.getBytes(certificate.publicKeyOffset);
+        KeyID fingerprint, modulusID;
+
+        if( ! PEMKeyring::computeKeyIDs(publicKey, certificate.numPublicKeyBytes, false, fingerprint, modulusID) )
+            return nullptr;
+
+        CachedKey::Ptr loaded = new CachedKey(fingerprint, modulusID);
+        loaded->key.setAssertOnMalformedInput(false);
+        if( ! loaded->key.loadFromDER(publicKey, certificate.numPublicKeyBytes, PEMFormatKey::DERFormat::subjectPublicKeyInfo) )
+            return nullptr;
+
+        return loaded;
+    };
+
+    return LazyKeySlot::getOrLoad(lock, getEntry, load);
+}
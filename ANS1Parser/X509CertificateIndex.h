@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    X509CertificateIndex.h
+    Created: 18 Oct 2026 2:05:48am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "ASN1Decoder.h"
+#include "CachedKey.h"
+#include "KeyID.h"
+
+/**
+ An index of the X.509 certificates in a bundle, to find them by subject or serial number
+ and load their RSA public keys.
+
+ Adding a bundle makes one pass over it.  For each certificate only the headers of the
+ TBSCertificate's fields up to the subjectPublicKeyInfo are read, with a DERCursor, so the
+ extensions and the signature are never decoded.  The index keeps where each certificate's
+ serial number, subject and SubjectPublicKeyInfo are, and the SHA-256 of its subject.
+ A certificate's key is only loaded the first time it is asked for, and is kept after that.
+
+ Lookups can be made from any number of threads.
+ e.g.:
+ @code
+ X509CertificateIndex certificates;
+ certificates.addPEMBundleFile(caBundleFile);
+
+ for( auto index : certificates.findBySubject(issuerName, numIssuerNameBytes) )
+     if( auto issuerKey = certificates.getPublicKey(index) )
+         checkSignature(issuerKey->key);
+ @endcode
+ */
+struct X509CertificateIndex
+{
+    using KeyID = ::KeyID;
+
+    ///where one certificate's fields are in the DER it was indexed from
+    struct Certificate
+    {
+        DERBuffer::Ptr der;
+        ///the whole Certificate
+        size_t offset = 0, numBytes = 0;
+        ///the content of the serialNumber INTEGER
+        size_t serialOffset = 0, numSerialBytes = 0;
+        ///the subject Name, tag and length included
+        size_t subjectOffset = 0, numSubjectBytes = 0;
+        ///the subjectPublicKeyInfo, tag and length included, as PEMFormatKey::loadFromDER() takes it
+        size_t publicKeyOffset = 0, numPublicKeyBytes = 0;
+        ///the SHA-256 of the subject Name's DER
+        KeyID subjectHash;
+
+        const juce::uint8* getBytes(size_t position) const noexcept { return der->getData() + position; }
+    };
+
+    X509CertificateIndex() = default;
+
+    /**
+     Indexes a run of concatenated DER certificates and returns the number indexed.
+     Indexing stops at the first one that can't be read, since the rest can't be found without it.
+     */
+    int addDER(const void* data, size_t numBytes);
+    ///memory-maps the file and indexes the DER certificates in it
+    int addDERFile(const juce::File& file);
+
+    ///indexes every CERTIFICATE block in the text and returns the number indexed
+    int addPEMText(const char* text, size_t numBytes);
+    int addPEMString(const juce::String& pem);
+    ///memory-maps the file and indexes every CERTIFICATE block in it
+    int addPEMBundleFile(const juce::File& file);
+
+    int getNumCertificates() const;
+    ///returns false if there's no certificate at 'index'
+    bool getCertificate(int index, Certificate& result) const;
+
+    ///the SHA-256 of a Name's DER, as the index keeps it for each subject
+    static KeyID hashName(const void* nameDER, size_t numBytes);
+
+    ///the indices of the certificates whose subject is this Name, tag and length included
+    std::vector<int> findBySubject(const void* nameDER, size_t numBytes) const;
+    std::vector<int> findBySubject(const KeyID& subjectHash) const;
+
+    ///the indices of the certificates with this serial number.  leading zero bytes are ignored
+    std::vector<int> findBySerialNumber(const void* serial, size_t numBytes) const;
+
+    /**
+     Returns the certificate's public key, loading it the first time it is asked for,
+     or nullptr if there's no certificate at 'index' or its key isn't an RSA key that loads.
+     */
+    CachedKey::Ptr getPublicKey(int index);
+private:
+    ///a certificate, and its key once it has been asked for
+    struct Entry : LazyKeySlot
+    {
+        Certificate certificate;
+    };
+
+    juce::CriticalSection lock;
+    std::vector<Entry> entries;
+    std::unordered_multimap<KeyID, int, KeyID::Hash> bySubject;
+    ///keyed by a hash of the serial number without its leading zeros
+    std::unordered_multimap<size_t, int> bySerialNumber;
+
+    /**
+     Reads the certificate at 'offset' into 'certificate' and returns true if it is one.
+     Only the headers are read, apart from hashing the subject.
+     */
+    static bool readCertificate(const DERBuffer::Ptr& der, size_t offset, size_t end, Certificate& certificate);
+
+    ///adds the certificates that have been read, all at once
+    void addEntries(std::vector<Entry>&& newEntries);
+
+    JUCE_DECLARE_NON_COPYABLE(X509CertificateIndex)
+};
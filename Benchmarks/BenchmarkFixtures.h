@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    BenchmarkFixtures.h
+    Created: 17 Oct 2026 9:48:12pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Fixed keys for the benchmarks, so every run and every build measures the same inputs.
+
+ Each size has a PKCS#8 private key, its SubjectPublicKeyInfo public key and a self-signed
+ X.509 certificate for it.
+ The ciphertexts are made from getMessage() when the benchmarks start:
+ encrypted with the public key for the private key to decrypt, and signed with the
+ private key for the public key to recover.  Both are deterministic because the
+ keys apply raw RSA with no padding.
+ */
+struct BenchmarkFixtures
+{
+    struct KeyPair
+    {
+        int numBits;
+        const char* privateKeyPEM;
+        const char* publicKeyPEM;
+        ///a v1 certificate for the 2048-bit key, and v3 for the others
+        const char* certificatePEM;
+    };
+
+    ///one pair for each of 1024, 2048, 3072 and 4096 bits
+    static const std::vector<KeyPair>& getKeyPairs();
+
+    ///the plaintext behind every ciphertext
+    static const char* getMessage();
+};
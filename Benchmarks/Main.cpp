@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 17 Oct 2026 9:48:12pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "PEMBenchmarks.h"
+
+/*
+ usage: PEMBenchmarks [--iterations=N] [--warmup=N] [--filter=stage]
+                      [--json=results.json] [--csv=results.csv] [--compare=baseline.json]
+
+ build it as a console application with the ANS1Parser and Benchmarks sources
+ and the juce_core and juce_cryptography modules, in a release configuration.
+ */
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    PEMBenchmarks::Options options;
+    if( args.containsOption("--iterations") )
+        options.numIterations = juce::jmax(1, args.getValueForOption("--iterations").getIntValue());
+    if( args.containsOption("--warmup") )
+        options.numWarmupIterations = juce::jmax(0, args.getValueForOption("--warmup").getIntValue());
+    if( args.containsOption("--filter") )
+        options.stageFilter = args.getValueForOption("--filter");
+
+    std::vector<PEMBenchmarks::Result> results;
+    if( ! PEMBenchmarks::run(options, results) )
+    {
+        std::cerr << "the fixture keys failed to load or decrypt" << std::endl;
+        return 1;
+    }
+
+    std::cout << PEMBenchmarks::toTable(results) << std::endl;
+
+    if( args.containsOption("--json") )
+    {
+        juce::File file(args.getFileForOption("--json"));
+        if( ! file.replaceWithText(PEMBenchmarks::toJSON(results)) )
+            std::cerr << "couldn't write " << file.getFullPathName() << std::endl;
+    }
+
+    if( args.containsOption("--csv") )
+    {
+        juce::File file(args.getFileForOption("--csv"));
+        if( ! file.replaceWithText(PEMBenchmarks::toCSV(results)) )
+            std::cerr << "couldn't write " << file.getFullPathName() << std::endl;
+    }
+
+    if( args.containsOption("--compare") )
+    {
+        auto baseline = PEMBenchmarks::fromJSON(args.getFileForOption("--compare").loadFileAsString());
+        if( baseline.empty() )
+        {
+            std::cerr << "no results in the baseline" << std::endl;
+            return 1;
+        }
+
+        std::cout << PEMBenchmarks::compare(results, baseline) << std::endl;
+    }
+
+    return 0;
+}
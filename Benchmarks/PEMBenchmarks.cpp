@@ -0,0 +1,581 @@
+/*
+  ==============================================================================
+
+    PEMBenchmarks.cpp
+    Created: 17 Oct 2026 9:48:12pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include "PEMBenchmarks.h"
+#include "BenchmarkFixtures.h"
+
+#include "../ANS1Parser/ASN1Arena.h"
+#include "../ANS1Parser/ASN1Decoder.h"
+#include "../ANS1Parser/DERStreamParser.h"
+#include "../ANS1Parser/MultiLaneMontgomery.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "../ANS1Parser/X509CertificateIndex.h"
+
+namespace
+{
+///everything a key's stages work on, prepared before any of them are timed
+struct Fixture
+{
+    int numBits = 0;
+    bool isPrivateKey = false;
+
+    const char* pem = nullptr;
+    size_t pemLength = 0;
+    ///the key pair's certificate
+    const char* certificatePEM = nullptr;
+    PEMHelpers::PEMBlock block;
+
+    juce::MemoryBlock der;
+    DERBuffer::Ptr derBuffer;
+    std::vector<DERCursor> integers;
+
+    PEMFormatKey key;
+    juce::MemoryBlock ciphertext;
+    juce::String ciphertextBase64;
+};
+
+DERCursor findRSAKey(const DERCursor& root, bool isPrivateKey)
+{
+    //PrivateKeyInfo: OCTET STRING at index 2.  SubjectPublicKeyInfo: BIT STRING at index 1
+    return root.find({ isPrivateKey ? 2 : 1, DERCursor::encapsulated, 0 });
+}
+
+bool prepareFixture(Fixture& fixture, const char* pem, int numBits, bool isPrivateKey)
+{
+    fixture.numBits = numBits;
+    fixture.isPrivateKey = isPrivateKey;
+    fixture.pem = pem;
+    fixture.pemLength = std::strlen(pem);
+
+    if( ! PEMHelpers::findNextPEMBlock(pem, fixture.pemLength, 0, fixture.block)
+        || ! Base64Decoder::decode(pem + fixture.block.bodyStart, fixture.block.bodyLength, fixture.der) )
+    {
+        return false;
+    }
+
+    fixture.derBuffer = new DERBuffer(fixture.der.getData(), fixture.der.getSize());
+
+    DERCursor root(fixture.der.getData(), fixture.der.getSize());
+    for( auto node = findRSAKey(root, isPrivateKey).getChild(0); node.isValid(); node = node.getNextSibling() )
+        fixture.integers.push_back(node);
+
+    return fixture.key.loadFromDER(fixture.der.getData(), fixture.der.getSize(), isPrivateKey);
+}
+
+/**
+ makes a ciphertext for each key of a pair: one encrypted with the public key for the
+ private key to decrypt, and one signed with the private key for the public key to recover.
+ */
+bool prepareCiphertexts(Fixture& privateFixture, Fixture& publicFixture)
+{
+    const juce::String message(BenchmarkFixtures::getMessage());
+
+    if( ! publicFixture.key.decryptBytes(message.toRawUTF8(), message.getNumBytesAsUTF8(), privateFixture.ciphertext)
+        || ! privateFixture.key.decryptBytes(message.toRawUTF8(), message.getNumBytesAsUTF8(), publicFixture.ciphertext) )
+    {
+        return false;
+    }
+
+    for( auto* fixture : { &privateFixture, &publicFixture } )
+    {
+        fixture->ciphertextBase64 = juce::Base64::toBase64(fixture->ciphertext.getData(), fixture->ciphertext.getSize());
+        if( fixture->key.decryptBase64String(fixture->ciphertextBase64) != message )
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ where measure() puts what the stages return.  a stage whose result is never used could be
+ optimised away entirely, so every stage returns something that depends on its work.
+ */
+volatile juce::int64 sink = 0;
+
+///calls setUp() before each call to function(), outside the timed region
+template <typename SetUp, typename Function>
+PEMBenchmarks::Result measure(const PEMBenchmarks::Options& options,
+                              const Fixture& fixture,
+                              const juce::String& stage,
+                              size_t numBytes,
+                              SetUp&& setUp,
+                              Function&& function)
+{
+    juce::int64 total = 0;
+    for( int i = 0; i < options.numWarmupIterations; ++i )
+    {
+        setUp();
+        total += static_cast<juce::int64>(function());
+    }
+
+    std::vector<juce::int64> ticks(static_cast<size_t>(juce::jmax(1, options.numIterations)));
+    for( auto& sample : ticks )
+    {
+        setUp();
+        auto start = juce::Time::getHighResolutionTicks();
+        total += static_cast<juce::int64>(function());
+        sample = juce::Time::getHighResolutionTicks() - start;
+    }
+
+    sink = sink + total;
+
+    std::sort(ticks.begin(), ticks.end());
+
+    auto toNanoseconds = [](juce::int64 t) { return juce::Time::highResolutionTicksToSeconds(t) * 1.0e9; };
+    //nearest-rank percentile
+    auto percentile = [&](double p)
+    {
+        auto rank = static_cast<size_t>(std::ceil(p * static_cast<double>(ticks.size())));
+        return toNanoseconds(ticks[juce::jlimit(static_cast<size_t>(1), ticks.size(), rank) - 1]);
+    };
+
+    double totalNanoseconds = 0;
+    for( auto sample : ticks )
+        totalNanoseconds += toNanoseconds(sample);
+
+    PEMBenchmarks::Result result;
+    result.stage = stage;
+    result.numBits = fixture.numBits;
+    result.isPrivateKey = fixture.isPrivateKey;
+    result.numIterations = static_cast<int>(ticks.size());
+    result.numBytes = numBytes;
+    result.meanNanoseconds = totalNanoseconds / static_cast<double>(ticks.size());
+    result.p50Nanoseconds = percentile(0.5);
+    result.p90Nanoseconds = percentile(0.9);
+    result.p99Nanoseconds = percentile(0.99);
+    result.maxNanoseconds = toNanoseconds(ticks.back());
+    return result;
+}
+
+template <typename Function>
+PEMBenchmarks::Result measure(const PEMBenchmarks::Options& options,
+                              const Fixture& fixture,
+                              const juce::String& stage,
+                              size_t numBytes,
+                              Function&& function)
+{
+    return measure(options, fixture, stage, numBytes, [] {}, std::forward<Function>(function));
+}
+
+void runStages(const PEMBenchmarks::Options& options, const Fixture& fixture, std::vector<PEMBenchmarks::Result>& results)
+{
+    auto shouldRun = [&](const char* stage)
+    {
+        return options.stageFilter.isEmpty() || juce::String(stage).contains(options.stageFilter);
+    };
+
+    juce::MemoryBlock scratch;
+
+    if( shouldRun("unarmor") )
+    {
+        results.push_back(measure(options, fixture, "unarmor", fixture.pemLength, [&]
+        {
+            PEMHelpers::PEMBlock block;
+            PEMHelpers::findNextPEMBlock(fixture.pem, fixture.pemLength, 0, block);
+            return block.bodyLength;
+        }));
+    }
+
+    if( shouldRun("base64") )
+    {
+        results.push_back(measure(options, fixture, "base64", fixture.block.bodyLength, [&]
+        {
+            Base64Decoder::decode(fixture.pem + fixture.block.bodyStart, fixture.block.bodyLength, scratch);
+            return scratch.getSize();
+        }));
+    }
+
+    if( shouldRun("der-tree") )
+    {
+        results.push_back(measure(options, fixture, "der-tree", fixture.der.getSize(), [&]
+        {
+            return ASN1Decoder::decode(fixture.derBuffer)->sub.size();
+        }));
+    }
+
+    if( shouldRun("der-arena") )
+    {
+        //the arena is reused, as it would be for many keys, so only the first decode allocates
+        ASN1Arena arena;
+
+        results.push_back(measure(options, fixture, "der-arena", fixture.der.getSize(), [&]
+        {
+            arena.decode(fixture.der.getData(), fixture.der.getSize());
+            return arena.size();
+        }));
+    }
+
+    if( shouldRun("der-cursor") )
+    {
+        results.push_back(measure(options, fixture, "der-cursor", fixture.der.getSize(), [&]
+        {
+            DERCursor root(fixture.der.getData(), fixture.der.getSize());
+            juce::int64 numContentBytes = 0;
+            for( auto node = findRSAKey(root, fixture.isPrivateKey).getChild(0); node.isValid(); node = node.getNextSibling() )
+                numContentBytes += node.getContentLength();
+
+            return numContentBytes;
+        }));
+    }
+
+    if( shouldRun("der-stream") )
+    {
+        //reports every node without reading any content
+        DERStreamParser::Listener listener;
+        DERStreamParser parser;
+
+        results.push_back(measure(options, fixture, "der-stream", fixture.der.getSize(), [&]
+        {
+            juce::MemoryInputStream stream(fixture.der, false);
+            auto parsed = parser.parse(stream, listener);
+            return parsed ? stream.getPosition() : 0;
+        }));
+    }
+
+    if( shouldRun("integer-import") )
+    {
+        size_t numIntegerBytes = 0;
+        for( const auto& integer : fixture.integers )
+            numIntegerBytes += static_cast<size_t>(integer.getContentLength());
+
+        results.push_back(measure(options, fixture, "integer-import", numIntegerBytes, [&]
+        {
+            int numBits = 0;
+            for( const auto& integer : fixture.integers )
+                numBits += PEMHelpers::convertBigEndianBytesToBigInteger(integer.getContent(), static_cast<size_t>(integer.getContentLength())).getHighestBit();
+
+            return numBits;
+        }));
+    }
+
+    //version, n, e, d, p, q, dP, dQ, qInv
+    if( fixture.isPrivateKey && fixture.integers.size() == 9 && shouldRun("fixed-width-checks") )
+    {
+        std::vector<juce::BigInteger> values;
+        for( const auto& integer : fixture.integers )
+            values.push_back(PEMHelpers::convertBigEndianBytesToBigInteger(integer.getContent(), static_cast<size_t>(integer.getContentLength())));
+
+        //other sizes are checked with BigIntegers as part of loading, which "load" times
+        if( FixedWidthKey::getNumBitsForModulus(values[1]) != 0 )
+        {
+            results.push_back(measure(options, fixture, "fixed-width-checks", fixture.der.getSize(), [&]
+            {
+                auto checked = FixedWidthKey::checkPrivateKey(values[1], values[2], values[3], values[4],
+                                                              values[5], values[6], values[7], values[8]);
+                jassert(checked == FixedWidthKey::CheckResult::passed);
+                return static_cast<int>(checked);
+            }));
+        }
+    }
+
+    if( shouldRun("load") )
+    {
+        //the results of the full checks are cached, so forget them before each load or only the first would run them
+        const juce::String pem(fixture.pem);
+        results.push_back(measure(options, fixture, "load", fixture.pemLength, [] { PEMFormatKey::clearValidationCache(); }, [&]
+        {
+            PEMFormatKey key;
+            key.loadFromPEMFormattedString(pem);
+            return key.getMaxPlaintextSize();
+        }));
+    }
+
+    if( fixture.isPrivateKey && shouldRun("load-cached") )
+    {
+        //loading it once leaves the result of its checks in the cache
+        const juce::String pem(fixture.pem);
+        PEMFormatKey().loadFromPEMFormattedString(pem);
+
+        results.push_back(measure(options, fixture, "load-cached", fixture.pemLength, [&]
+        {
+            PEMFormatKey key;
+            key.loadFromPEMFormattedString(pem);
+            return key.getMaxPlaintextSize();
+        }));
+    }
+
+    if( shouldRun("export") )
+    {
+        //back out as the PEM it was loaded from, into a block that is reused
+        auto format = fixture.isPrivateKey ? PEMFormatKey::DERFormat::pkcs8PrivateKey : PEMFormatKey::DERFormat::subjectPublicKeyInfo;
+        juce::MemoryBlock exported;
+
+        results.push_back(measure(options, fixture, "export", fixture.pemLength, [&]
+        {
+            fixture.key.exportToPEM(format, exported);
+            return exported.getSize();
+        }));
+    }
+
+    if( ! fixture.isPrivateKey && shouldRun("x509-index") )
+    {
+        //every fixture's certificate in one bundle, with this key's found by its subject
+        juce::String bundle;
+        for( const auto& keyPair : BenchmarkFixtures::getKeyPairs() )
+            bundle += keyPair.certificatePEM;
+
+        X509CertificateIndex own;
+        X509CertificateIndex::Certificate certificate;
+        own.addPEMString(fixture.certificatePEM);
+        own.getCertificate(0, certificate);
+
+        results.push_back(measure(options, fixture, "x509-index", static_cast<size_t>(bundle.getNumBytesAsUTF8()), [&]
+        {
+            X509CertificateIndex index;
+            index.addPEMString(bundle);
+
+            auto found = index.findBySubject(certificate.subjectHash);
+            auto cached = found.empty() ? CachedKey::Ptr() : index.getPublicKey(found.front());
+            return cached != nullptr ? cached->key.getMaxPlaintextSize() : 0;
+        }));
+    }
+
+    if( shouldRun("modexp") )
+    {
+        results.push_back(measure(options, fixture, "modexp", fixture.ciphertext.getSize(), [&]
+        {
+            fixture.key.decryptBytes(fixture.ciphertext.getData(), fixture.ciphertext.getSize(), scratch);
+            return scratch.getSize();
+        }));
+    }
+
+    if( shouldRun("modexp-batch") )
+    {
+        //one iteration decrypts a full set of SIMD lanes' worth of ciphertexts
+        constexpr size_t numInBatch = MultiLaneMontgomery::maxNumLanes;
+        const auto maxPlaintextBytes = fixture.key.getMaxPlaintextSize();
+
+        PEMFormatKey::DecryptScratch decryptScratch;
+        juce::HeapBlock<juce::uint8> plaintexts(maxPlaintextBytes * numInBatch);
+        PEMFormatKey::Decryption decryptions[numInBatch];
+
+        for( size_t i = 0; i < numInBatch; ++i )
+            decryptions[i] = { fixture.ciphertext.getData(), fixture.ciphertext.getSize(), plaintexts + i * maxPlaintextBytes, maxPlaintextBytes };
+
+        results.push_back(measure(options, fixture, "modexp-batch", fixture.ciphertext.getSize() * numInBatch, [&]
+        {
+            return fixture.key.decryptBatch(decryptions, numInBatch, &decryptScratch);
+        }));
+    }
+
+    if( shouldRun("verify") && ! fixture.isPrivateKey )
+    {
+        const char* message = BenchmarkFixtures::getMessage();
+        PEMFormatKey::SignatureCheck check { fixture.ciphertext.getData(), fixture.ciphertext.getSize(),
+                                             message, std::strlen(message) };
+
+        results.push_back(measure(options, fixture, "verify", fixture.ciphertext.getSize(), [&]
+        {
+            return fixture.key.verifySignature(check);
+        }));
+    }
+
+    if( shouldRun("decrypt-base64") )
+    {
+        results.push_back(measure(options, fixture, "decrypt-base64", fixture.ciphertextBase64.getNumBytesAsUTF8(), [&]
+        {
+            return fixture.key.decryptBase64String(fixture.ciphertextBase64).length();
+        }));
+    }
+
+    if( shouldRun("decrypt-buffer") )
+    {
+        PEMFormatKey::DecryptScratch decryptScratch;
+        juce::HeapBlock<juce::uint8> plaintext(fixture.key.getMaxPlaintextSize());
+        size_t numPlaintextBytes = 0;
+
+        results.push_back(measure(options, fixture, "decrypt-buffer", fixture.ciphertextBase64.getNumBytesAsUTF8(), [&]
+        {
+            fixture.key.decryptBase64(fixture.ciphertextBase64.toRawUTF8(), fixture.ciphertextBase64.getNumBytesAsUTF8(),
+                                      plaintext, fixture.key.getMaxPlaintextSize(), numPlaintextBytes, &decryptScratch);
+            return numPlaintextBytes;
+        }));
+    }
+}
+
+juce::var toVar(const PEMBenchmarks::Result& result)
+{
+    auto* object = new juce::DynamicObject();
+    object->setProperty("name", result.getName());
+    object->setProperty("stage", result.stage);
+    object->setProperty("bits", result.numBits);
+    object->setProperty("key", result.isPrivateKey ? "private" : "public");
+    object->setProperty("iterations", result.numIterations);
+    object->setProperty("bytes", static_cast<juce::int64>(result.numBytes));
+    object->setProperty("meanNs", result.meanNanoseconds);
+    object->setProperty("p50Ns", result.p50Nanoseconds);
+    object->setProperty("p90Ns", result.p90Nanoseconds);
+    object->setProperty("p99Ns", result.p99Nanoseconds);
+    object->setProperty("maxNs", result.maxNanoseconds);
+    object->setProperty("opsPerSecond", result.getOperationsPerSecond());
+    object->setProperty("mbPerSecond", result.getMegabytesPerSecond());
+    return juce::var(object);
+}
+} // namespace
+
+//==============================================================================
+juce::String PEMBenchmarks::Result::getName() const
+{
+    return stage + "/" + juce::String(numBits) + (isPrivateKey ? "/private" : "/public");
+}
+
+double PEMBenchmarks::Result::getOperationsPerSecond() const
+{
+    return meanNanoseconds > 0 ? 1.0e9 / meanNanoseconds : 0;
+}
+
+double PEMBenchmarks::Result::getMegabytesPerSecond() const
+{
+    return meanNanoseconds > 0 ? static_cast<double>(numBytes) * 1.0e3 / meanNanoseconds : 0;
+}
+
+bool PEMBenchmarks::run(const Options& options, std::vector<Result>& results)
+{
+    for( const auto& keyPair : BenchmarkFixtures::getKeyPairs() )
+    {
+        Fixture privateFixture, publicFixture;
+        if( ! prepareFixture(privateFixture, keyPair.privateKeyPEM, keyPair.numBits, true)
+            || ! prepareFixture(publicFixture, keyPair.publicKeyPEM, keyPair.numBits, false)
+            || ! prepareCiphertexts(privateFixture, publicFixture) )
+        {
+            DBG( "the " + juce::String(keyPair.numBits) + "-bit fixture keys don't work!" );
+            jassertfalse;
+            return false;
+        }
+
+        privateFixture.certificatePEM = publicFixture.certificatePEM = keyPair.certificatePEM;
+        runStages(options, privateFixture, results);
+        runStages(options, publicFixture, results);
+    }
+
+    return true;
+}
+
+juce::String PEMBenchmarks::toTable(const std::vector<Result>& results)
+{
+    auto column = [](const juce::String& text, int width) { return text.paddedLeft(' ', width); };
+    auto microseconds = [](double ns) { return juce::String(ns / 1.0e3, 2); };
+
+    juce::String table;
+    table << juce::String("benchmark").paddedRight(' ', 32)
+          << column("mean us", 12) << column("p50 us", 12) << column("p90 us", 12) << column("p99 us", 12)
+          << column("ops/s", 12) << column("MB/s", 10) << juce::newLine;
+
+    for( const auto& result : results )
+    {
+        table << result.getName().paddedRight(' ', 32)
+              << column(microseconds(result.meanNanoseconds), 12)
+              << column(microseconds(result.p50Nanoseconds), 12)
+              << column(microseconds(result.p90Nanoseconds), 12)
+              << column(microseconds(result.p99Nanoseconds), 12)
+              << column(juce::String(result.getOperationsPerSecond(), 1), 12)
+              << column(juce::String(result.getMegabytesPerSecond(), 2), 10) << juce::newLine;
+    }
+
+    return table;
+}
+
+juce::String PEMBenchmarks::toCSV(const std::vector<Result>& results)
+{
+    juce::String csv("name,stage,bits,key,iterations,bytes,meanNs,p50Ns,p90Ns,p99Ns,maxNs,opsPerSecond,mbPerSecond\n");
+
+    for( const auto& result : results )
+    {
+        juce::StringArray fields;
+        fields.add(result.getName());
+        fields.add(result.stage);
+        fields.add(juce::String(result.numBits));
+        fields.add(result.isPrivateKey ? "private" : "public");
+        fields.add(juce::String(result.numIterations));
+        fields.add(juce::String(static_cast<juce::int64>(result.numBytes)));
+        for( auto value : { result.meanNanoseconds, result.p50Nanoseconds, result.p90Nanoseconds, result.p99Nanoseconds,
+                            result.maxNanoseconds, result.getOperationsPerSecond(), result.getMegabytesPerSecond() } )
+        {
+            fields.add(juce::String(value, 3));
+        }
+
+        csv << fields.joinIntoString(",") << "\n";
+    }
+
+    return csv;
+}
+
+juce::String PEMBenchmarks::toJSON(const std::vector<Result>& results)
+{
+    juce::Array<juce::var> resultArray;
+    for( const auto& result : results )
+        resultArray.add(toVar(result));
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty("format", 1);
+    root->setProperty("juceVersion", juce::SystemStats::getJUCEVersion());
+    root->setProperty("cpu", juce::SystemStats::getCpuModel());
+    root->setProperty("os", juce::SystemStats::getOperatingSystemName());
+    root->setProperty("time", juce::Time::getCurrentTime().toISO8601(true));
+    root->setProperty("results", resultArray);
+
+    return juce::JSON::toString(juce::var(root));
+}
+
+std::vector<PEMBenchmarks::Result> PEMBenchmarks::fromJSON(const juce::String& json)
+{
+    std::vector<Result> results;
+
+    auto root = juce::JSON::parse(json);
+    if( auto* resultArray = root["results"].getArray() )
+    {
+        for( const auto& item : *resultArray )
+        {
+            Result result;
+            result.stage = item["stage"].toString();
+            result.numBits = static_cast<int>(item["bits"]);
+            result.isPrivateKey = item["key"].toString() == "private";
+            result.numIterations = static_cast<int>(item["iterations"]);
+            result.numBytes = static_cast<size_t>(static_cast<juce::int64>(item["bytes"]));
+            result.meanNanoseconds = static_cast<double>(item["meanNs"]);
+            result.p50Nanoseconds = static_cast<double>(item["p50Ns"]);
+            result.p90Nanoseconds = static_cast<double>(item["p90Ns"]);
+            result.p99Nanoseconds = static_cast<double>(item["p99Ns"]);
+            result.maxNanoseconds = static_cast<double>(item["maxNs"]);
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
+
+juce::String PEMBenchmarks::compare(const std::vector<Result>& results, const std::vector<Result>& baseline)
+{
+    auto column = [](const juce::String& text, int width) { return text.paddedLeft(' ', width); };
+
+    juce::String table;
+    table << juce::String("benchmark").paddedRight(' ', 32)
+          << column("base p50 us", 14) << column("p50 us", 12) << column("change", 10) << juce::newLine;
+
+    for( const auto& result : results )
+    {
+        auto name = result.getName();
+        auto match = std::find_if(baseline.begin(), baseline.end(), [&](const Result& r) { return r.getName() == name; });
+
+        table << name.paddedRight(' ', 32);
+        if( match == baseline.end() || match->p50Nanoseconds <= 0 )
+        {
+            table << column("-", 14) << column(juce::String(result.p50Nanoseconds / 1.0e3, 2), 12) << column("new", 10) << juce::newLine;
+            continue;
+        }
+
+        auto change = (result.p50Nanoseconds / match->p50Nanoseconds - 1.0) * 100.0;
+        table << column(juce::String(match->p50Nanoseconds / 1.0e3, 2), 14)
+              << column(juce::String(result.p50Nanoseconds / 1.0e3, 2), 12)
+              << column((change >= 0 ? "+" : "") + juce::String(change, 1) + "%", 10) << juce::newLine;
+    }
+
+    return table;
+}
@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+    PEMBenchmarks.h
+    Created: 17 Oct 2026 9:48:12pm
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Times each stage of loading and using a key, for every size in BenchmarkFixtures.
+
+ The stages are:
+ - unarmor:        finding the -----BEGIN/-----END lines
+ - base64:         decoding the body
+ - der-tree:       ASN1Decoder::decode() building the whole tree
+ - der-arena:      ASN1Arena::decode() building the whole tree as flat nodes, into a reused arena
+ - der-cursor:     the DERCursor walk PEMFormatKey does to reach the integers
+ - der-stream:     a DERStreamParser pass over the whole key from a juce::InputStream
+ - integer-import: turning every INTEGER of the key into a juce::BigInteger
+ - fixed-width-checks: FixedWidthKey::checkPrivateKey(), the full checks for private keys of the standard sizes
+ - load:           PEMFormatKey::loadFromPEMFormattedString(), start to finish, with the validation cache cleared beforehand
+ - load-cached:    the same, with the full checks' result already in the validation cache (private keys only)
+ - export:         PEMFormatKey::exportToPEM() into a reused block
+ - x509-index:     indexing a bundle of every size's certificate, then finding this key's by subject and loading it (public keys only)
+ - modexp:         PEMFormatKey::decryptBytes()
+ - modexp-batch:   PEMFormatKey::decryptBatch() on MultiLaneMontgomery::maxNumLanes ciphertexts at a time
+ - verify:         PEMFormatKey::verifySignature() (public keys only)
+ - decrypt-base64: PEMFormatKey::decryptBase64String(), start to finish
+ - decrypt-buffer: PEMFormatKey::decryptBase64() into a reused buffer and scratch
+
+ Each stage runs on its own so that its latency percentiles aren't mixed with the others'.
+ */
+struct PEMBenchmarks
+{
+    struct Options
+    {
+        int numIterations = 200;
+        int numWarmupIterations = 10;
+        ///if not empty, only the stages whose names contain this are run
+        juce::String stageFilter;
+    };
+
+    struct Result
+    {
+        juce::String stage;
+        int numBits = 0;
+        bool isPrivateKey = false;
+        int numIterations = 0;
+        ///the size of the input one iteration works through
+        size_t numBytes = 0;
+
+        double meanNanoseconds = 0;
+        double p50Nanoseconds = 0;
+        double p90Nanoseconds = 0;
+        double p99Nanoseconds = 0;
+        double maxNanoseconds = 0;
+
+        ///e.g. "modexp/2048/private".  names are stable between runs, so results can be matched up
+        juce::String getName() const;
+        double getOperationsPerSecond() const;
+        double getMegabytesPerSecond() const;
+    };
+
+    ///returns false if a fixture fails to load or decrypt, which would make the timings meaningless
+    static bool run(const Options& options, std::vector<Result>& results);
+
+    ///a fixed-width table for reading
+    static juce::String toTable(const std::vector<Result>& results);
+    static juce::String toCSV(const std::vector<Result>& results);
+    ///includes the JUCE version, CPU and OS, so results from different machines aren't mistaken for each other
+    static juce::String toJSON(const std::vector<Result>& results);
+    ///reads the results back from toJSON()
+    static std::vector<Result> fromJSON(const juce::String& json);
+
+    ///a table of the median latency of each result against the one with the same name in 'baseline'
+    static juce::String compare(const std::vector<Result>& results, const std::vector<Result>& baseline);
+};
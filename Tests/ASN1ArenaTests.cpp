@@ -0,0 +1,143 @@
+/*
+  ==============================================================================
+
+    ASN1ArenaTests.cpp
+    Created: 18 Oct 2026 6:41:05am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/ASN1Arena.h"
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "TestFixtures.h"
+
+/**
+ Checks that the flat tree an ASN1Arena decodes has the same nodes, in the same places,
+ as the tree ASN1Decoder::decode() builds, for every form of the fixture keys.
+ */
+struct ASN1ArenaTests : juce::UnitTest
+{
+    ASN1ArenaTests() : juce::UnitTest("ASN1Arena", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& pkcs1Keys = TestFixtures::getPKCS1Keys();
+
+        //one arena for every key, as it would be used for a bundle
+        ASN1Arena arena;
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            beginTest("the same tree as ASN1Decoder, " + juce::String(keyPairs[i].numBits) + " bits");
+
+            for( auto* pem : { keyPairs[i].privateKeyPEM, keyPairs[i].publicKeyPEM, pkcs1Keys[i].privateKeyPEM, pkcs1Keys[i].publicKeyPEM } )
+            {
+                juce::MemoryBlock der;
+                expect(decodePEM(pem, der));
+
+                DERBuffer::Ptr buffer = new DERBuffer(der.getData(), der.getSize());
+                auto tree = ASN1Decoder::decode(buffer);
+                expect(tree != nullptr);
+
+                expect(arena.decode(buffer->getData(), buffer->getSize()));
+                expect(arena.getData() == buffer->getData());
+
+                if( tree != nullptr && ! arena.isEmpty() )
+                {
+                    int numNodes = 0;
+                    expectSameTree(*tree, arena, 0, ASN1FlatNode::none, numNodes);
+                    expectEquals(arena.size(), numNodes);
+                }
+            }
+        }
+
+        beginTest("an OCTET STRING that doesn't hold ASN.1 is kept as it is");
+        {
+            //SEQUENCE { OCTET STRING 01 02 03, NULL }.  01 02 looks like the header of a BOOLEAN that runs past the end of the OCTET STRING
+            const juce::uint8 der[] = { 0x30, 0x07, 0x04, 0x03, 0x01, 0x02, 0x03, 0x05, 0x00 };
+
+            expect(arena.decode(der, sizeof(der)));
+            expectEquals(arena.size(), 3);
+            expectEquals(arena.getRoot().numChildren, 2);
+
+            auto octetString = arena.getChild(0, 0);
+            auto null = arena.getChild(0, 1);
+            expect(octetString != ASN1FlatNode::none && null != ASN1FlatNode::none);
+            if( octetString != ASN1FlatNode::none && null != ASN1FlatNode::none )
+            {
+                expectEquals(static_cast<int>(arena[octetString].tag.tagNumber), 0x04);
+                expectEquals(arena[octetString].numChildren, 0);
+                expectEquals(static_cast<int>(arena[octetString].length), 3);
+                expect(arena.getContent(octetString) == der + 4);
+                expectEquals(static_cast<int>(arena[null].tag.tagNumber), 0x05);
+                expectEquals(static_cast<int>(arena[null].offset), 7);
+            }
+        }
+
+        beginTest("malformed DER leaves the arena empty");
+        {
+            juce::MemoryBlock der;
+            expect(decodePEM(keyPairs[0].publicKeyPEM, der));
+
+            expect(! arena.decode(der.getData(), der.getSize() - 1));
+            expect(arena.isEmpty());
+
+            //nested deeper than maxDepth
+            juce::MemoryBlock nested;
+            for( int i = 0; i <= ASN1Arena::maxDepth; ++i )
+                nested.append("\x30\x80", 2);
+            for( int i = 0; i <= ASN1Arena::maxDepth; ++i )
+                nested.append("\x00\x00", 2);
+
+            expect(! arena.decode(nested.getData(), nested.getSize()));
+            expect(arena.isEmpty());
+        }
+    }
+
+    static bool decodePEM(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+
+    ///walks both trees together, counting the nodes of the ASN1 tree
+    void expectSameTree(const ASN1& node, const ASN1Arena& arena, int index, int parent, int& numNodes)
+    {
+        ++numNodes;
+
+        const auto& flat = arena[index];
+        expectEquals(flat.tag.tagClass, node.tag.tagClass);
+        expect(flat.tag.tagConstructed == node.tag.tagConstructed);
+        expectEquals(flat.tag.tagNumber, node.tag.tagNumber);
+        expectEquals(flat.offset, node.offset);
+        expectEquals(flat.header, node.header);
+        expectEquals(flat.length, node.length);
+        expectEquals(flat.parent, parent);
+        expectEquals(flat.numChildren, static_cast<int>(node.sub.size()));
+        expect(arena.getContent(index) == node.getContent());
+
+        auto child = flat.firstChild;
+        for( const auto& sub : node.sub )
+        {
+            expect(child != ASN1FlatNode::none);
+            if( child == ASN1FlatNode::none )
+                return;
+
+            expectSameTree(*sub, arena, child, index, numNodes);
+            child = arena[child].nextSibling;
+        }
+
+        expect(child == ASN1FlatNode::none);
+    }
+};
+
+static ASN1ArenaTests asn1ArenaTests;
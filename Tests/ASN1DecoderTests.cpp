@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    ASN1DecoderTests.cpp
+    Created: 18 Oct 2026 10:38:21am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/ASN1Decoder.h"
+
+/**
+ Decodes nested SEQUENCEs from a juce::MemoryInputStream and checks where each node is,
+ how long it is and what it holds, for definite lengths and for BER's indefinite ones.
+ */
+struct ASN1DecoderTests : juce::UnitTest
+{
+    ASN1DecoderTests() : juce::UnitTest("ASN1Decoder", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        beginTest("a nested SEQUENCE, from the middle of a stream");
+        {
+            //two bytes before it, then SEQUENCE { INTEGER 5, SEQUENCE { BOOLEAN TRUE, INTEGER 7 } }, then one byte after it
+            const juce::uint8 data[] = { 0xAA, 0xBB,
+                                         0x30, 0x0B, 0x02, 0x01, 0x05, 0x30, 0x06, 0x01, 0x01, 0xFF, 0x02, 0x01, 0x07,
+                                         0xCC };
+
+            juce::MemoryInputStream stream(data, sizeof(data), false);
+            stream.setPosition(2);
+
+            auto root = ASN1Decoder::decode(stream);
+            expect(root != nullptr);
+            if( root == nullptr )
+                return;
+
+            //the stream is left just past the node, and the offsets count from the start of its data
+            expectEquals(static_cast<int>(stream.getPosition()), static_cast<int>(sizeof(data)) - 1);
+
+            expectNode(*root, 0x10, true, 2, 2, 11, 2);
+            expect(root->getContent() == root->buffer->getData() + 4);
+
+            if( root->sub.size() == 2 )
+            {
+                const auto& integer = *root->sub[0];
+                expectNode(integer, 0x02, false, 4, 2, 1, 0);
+                expectEquals(static_cast<int>(integer.getContent()[0]), 0x05);
+
+                const auto& inner = *root->sub[1];
+                expectNode(inner, 0x10, true, 7, 2, 6, 2);
+
+                if( inner.sub.size() == 2 )
+                {
+                    expectNode(*inner.sub[0], 0x01, false, 9, 2, 1, 0);
+                    expectEquals(static_cast<int>(inner.sub[0]->getContent()[0]), 0xFF);
+
+                    expectNode(*inner.sub[1], 0x02, false, 12, 2, 1, 0);
+                    expectEquals(static_cast<int>(inner.sub[1]->getContent()[0]), 0x07);
+                }
+
+                //every node shares the one copy of the stream's data
+                expect(inner.buffer == root->buffer && integer.buffer == root->buffer);
+            }
+        }
+
+        beginTest("indefinite lengths keep the negative length");
+        {
+            //SEQUENCE (indefinite) { INTEGER 5, SEQUENCE (indefinite) { BOOLEAN TRUE } }
+            const juce::uint8 ber[] = { 0x30, 0x80, 0x02, 0x01, 0x05, 0x30, 0x80, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+
+            juce::MemoryInputStream stream(ber, sizeof(ber), false);
+            auto root = ASN1Decoder::decode(stream);
+            expect(root != nullptr);
+            if( root == nullptr )
+                return;
+
+            expect(stream.isExhausted());
+
+            /*
+             as in asn1js, an indefinite length is stored as minus the number of bytes from the end of
+             the header to the end of the end-of-contents octets.  the end-of-contents nodes aren't children.
+             */
+            expectNode(*root, 0x10, true, 0, 2, -12, 2);
+
+            if( root->sub.size() == 2 )
+            {
+                expectNode(*root->sub[0], 0x02, false, 2, 2, 1, 0);
+                expectEquals(static_cast<int>(root->sub[0]->getContent()[0]), 0x05);
+
+                const auto& inner = *root->sub[1];
+                expectNode(inner, 0x10, true, 5, 2, -5, 1);
+
+                if( inner.sub.size() == 1 )
+                {
+                    expectNode(*inner.sub[0], 0x01, false, 7, 2, 1, 0);
+                    expectEquals(static_cast<int>(inner.sub[0]->getContent()[0]), 0xFF);
+                }
+            }
+        }
+    }
+
+    void expectNode(const ASN1& node, int tagNumber, bool constructed, int offset, int header, int length, int numChildren)
+    {
+        auto where = "the node at offset " + juce::String(offset);
+
+        expectEquals(static_cast<int>(node.tag.tagNumber), tagNumber, where);
+        expect(node.tag.tagConstructed == constructed, where);
+        expectEquals(static_cast<int>(node.offset), offset, where);
+        expectEquals(static_cast<int>(node.header), header, where);
+        expectEquals(static_cast<int>(node.tagLen), 1, where);
+        expectEquals(static_cast<int>(node.length), length, where);
+        expectEquals(static_cast<int>(node.sub.size()), numChildren, where);
+    }
+};
+
+static ASN1DecoderTests asn1DecoderTests;
@@ -0,0 +1,147 @@
+/*
+  ==============================================================================
+
+    Base64DecoderTests.cpp
+    Created: 18 Oct 2026 4:03:19am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+
+/**
+ Checks that each SIMD implementation of Base64Decoder the CPU supports decodes exactly
+ what the scalar one does, and that both decode what juce::Base64 encoded.
+ */
+struct Base64DecoderTests : juce::UnitTest
+{
+    Base64DecoderTests() : juce::UnitTest("Base64Decoder", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        beginTest("random lengths, with 0 to 3 padding characters");
+
+        for( int i = 0; i < 400; ++i )
+        {
+            auto data = makeRandomData(random, static_cast<size_t>(random.nextInt(i < 200 ? 100 : 2000)));
+            auto base64 = juce::Base64::toBase64(data.getData(), data.getSize()).trimCharactersAtEnd("=");
+
+            for( int numPadding = 0; numPadding <= 3; ++numPadding )
+            {
+                auto text = base64 + juce::String::repeatedString("=", numPadding);
+
+                //padding is optional, and may only finish off a partial group, with at most two characters
+                auto isValid = numPadding == 0 || (base64.length() % 4 != 0 && numPadding <= 2);
+                checkAllImplementations(text, isValid ? &data : nullptr);
+            }
+        }
+
+        beginTest("embedded newlines and whitespace");
+
+        for( int i = 0; i < 200; ++i )
+        {
+            auto data = makeRandomData(random, static_cast<size_t>(random.nextInt(1500)));
+            auto base64 = juce::Base64::toBase64(data.getData(), data.getSize());
+
+            //PEM's 64-character lines, with either line ending
+            juce::String lines;
+            const auto* lineEnding = i % 2 == 0 ? "\n" : "\r\n";
+            for( int start = 0; start < base64.length(); start += 64 )
+                lines << base64.substring(start, start + 64) << lineEnding;
+
+            checkAllImplementations(lines, &data);
+
+            //and whitespace anywhere at all, including inside and across vector blocks
+            std::string scattered;
+            const char* const whitespace[] = { "\n", "\r\n", " ", "\t" };
+            for( auto c : base64.toStdString() )
+            {
+                if( random.nextInt(8) == 0 )
+                    scattered += whitespace[random.nextInt(4)];
+
+                scattered += c;
+            }
+
+            checkAllImplementations(scattered.data(), scattered.size(), &data);
+        }
+
+        beginTest("invalid characters at every position of a vector block");
+
+        auto data = makeRandomData(random, 96);
+        auto base64 = juce::Base64::toBase64(data.getData(), data.getSize()).toStdString();
+        jassert( base64.size() == 128 );
+
+        //past the SIMD blocks too, into the scalar tail
+        const char invalidCharacters[] = { '!', '-', '_', '.', '*', '\0', '\x7f', '\x80', '\xff' };
+        for( size_t position = 0; position < base64.size(); ++position )
+        {
+            for( auto invalid : invalidCharacters )
+            {
+                auto text = base64;
+                text[position] = invalid;
+                checkAllImplementations(text.data(), text.size(), nullptr);
+            }
+
+            //and padding anywhere but the end
+            if( position < base64.size() - 4 )
+            {
+                auto text = base64;
+                text[position] = '=';
+                checkAllImplementations(text.data(), text.size(), nullptr);
+            }
+        }
+    }
+
+    static juce::MemoryBlock makeRandomData(juce::Random& random, size_t numBytes)
+    {
+        juce::MemoryBlock data(numBytes);
+        random.fillBitsRandomly(data.getData(), data.getSize());
+        return data;
+    }
+
+    void checkAllImplementations(const juce::String& text, const juce::MemoryBlock* expected)
+    {
+        checkAllImplementations(text.toRawUTF8(), text.getNumBytesAsUTF8(), expected);
+    }
+
+    /**
+     decodes 'text' with every implementation the CPU supports, and checks they all agree with the scalar one.
+     'expected' is the data it should decode to, or nullptr if it shouldn't decode at all.
+     */
+    void checkAllImplementations(const char* text, size_t numChars, const juce::MemoryBlock* expected)
+    {
+        const auto maxSize = Base64Decoder::getMaxDecodedSize(numChars);
+        juce::HeapBlock<juce::uint8> scalarResult(maxSize + 1), result(maxSize + 1);
+        size_t numScalarBytes = 0;
+
+        auto scalarDecoded = Base64Decoder::decode(text, numChars, scalarResult, numScalarBytes, Base64Decoder::Implementation::scalar);
+        expectEquals(scalarDecoded, expected != nullptr, "the scalar decoder got the wrong answer");
+        if( scalarDecoded && expected != nullptr )
+            expect(numScalarBytes == expected->getSize() && std::memcmp(scalarResult, expected->getData(), numScalarBytes) == 0,
+                   "the scalar decoder decoded the wrong bytes");
+
+        //the implementations are in order, so the CPU supports every one up to the best
+        for( auto implementation : { Base64Decoder::Implementation::sse41, Base64Decoder::Implementation::avx2 } )
+        {
+            if( implementation > Base64Decoder::getBestImplementation() )
+                break;
+
+            size_t numBytes = 0;
+            auto decoded = Base64Decoder::decode(text, numChars, result, numBytes, implementation);
+            expectEquals(decoded, scalarDecoded, "an implementation disagrees with the scalar one about whether it decodes");
+            if( decoded && scalarDecoded )
+                expect(numBytes == numScalarBytes && std::memcmp(result, scalarResult, numBytes) == 0,
+                       "an implementation decoded different bytes to the scalar one");
+        }
+    }
+};
+
+static Base64DecoderTests base64DecoderTests;
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    CRTDecryptionTests.cpp
+    Created: 18 Oct 2026 11:14:09am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/DERCursor.h"
+#include "../ANS1Parser/Montgomery.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "TestFixtures.h"
+
+/**
+ Checks the Chinese Remainder Theorem paths against the full-width exponentiation:
+ a MontgomeryKeyContext built from the fixture keys' primes and CRT exponents, then
+ PEMFormatKey::decryptValue() for keys of the fixed widths and for one that isn't.
+ */
+struct CRTDecryptionTests : juce::UnitTest
+{
+    CRTDecryptionTests() : juce::UnitTest("CRTDecryption", "ANS1Parser")
+    {
+
+    }
+
+    static constexpr int numValues = 8;
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+
+        for( const auto& pkcs1Key : TestFixtures::getPKCS1Keys() )
+        {
+            beginTest("MontgomeryKeyContext with and without CRT, " + juce::String(pkcs1Key.numBits) + " bits");
+
+            juce::MemoryBlock der;
+            expect(decodePEM(pkcs1Key.privateKeyPEM, der));
+
+            //RSAPrivateKey { version, n, e, d, p, q, dP, dQ, qInv }
+            juce::BigInteger components[9];
+            expect(readIntegers(der, components));
+            const auto& n = components[1];
+            const auto& e = components[2];
+            const auto& d = components[3];
+
+            MontgomeryKeyContext crt(n, d, components[4], components[5], components[6], components[7], components[8]);
+            MontgomeryKeyContext direct(n, d);
+            MontgomeryKeyContext publicKey(n, e);
+
+            expect(crt.isValid() && direct.isValid() && publicKey.isValid());
+            expect(crt.usesCRT());
+            expect(! direct.usesCRT() && ! publicKey.usesCRT());
+            expect(crt.getNumScratchLimbs() <= direct.getNumScratchLimbs(), "the CRT path needs more scratch than the direct one");
+
+            for( int i = 0; i < numValues; ++i )
+            {
+                auto value = i == 0 ? juce::BigInteger(1)
+                           : i == 1 ? n - 1
+                                    : randomBelow(random, n);
+
+                auto expected = value;
+                expected.exponentModulo(d, n);
+
+                auto viaCRT = value, viaDirect = value;
+                expect(apply(crt, viaCRT) && viaCRT == expected, "the CRT path disagrees with BigInteger for " + value.toString(16));
+                expect(apply(direct, viaDirect) && viaDirect == expected, "the direct path disagrees with BigInteger for " + value.toString(16));
+
+                //and the public exponent undoes it
+                expect(apply(publicKey, viaCRT) && viaCRT == value);
+            }
+
+            //the modulus itself isn't below the modulus, on either path
+            auto unusable = n;
+            expect(! apply(crt, unusable) && ! apply(direct, unusable));
+        }
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            beginTest("decryptValue() with the CRT components, " + juce::String(keyPairs[i].numBits) + " bits");
+
+            PEMFormatKey privateKey, publicKey;
+            privateKey.loadFromPEMFormattedString(keyPairs[i].privateKeyPEM);
+            publicKey.loadFromPEMFormattedString(keyPairs[i].publicKeyPEM);
+
+            expect(privateKey.isPrivateKey() && privateKey.hasCRTComponents());
+            expect(! publicKey.isPrivateKey() && ! publicKey.hasCRTComponents());
+
+            expectSameAsFullWidth(privateKey, random);
+        }
+
+        beginTest("a private key that isn't one of the fixed widths");
+        {
+            /*
+             a 1536-bit key, so it goes through MontgomeryKeyContext's CRT path rather than a FixedWidthKey.
+             made with: openssl genpkey -algorithm RSA -pkeyopt rsa_keygen_bits:1536, and the
+             ciphertext with: openssl pkeyutl -encrypt on BenchmarkFixtures::getMessage()
+             */
+            const char* keyDER =
+                "MIIDfQIBAAKBwQC1Z1WLbYr/xK2LEqxYjlNWMIUt4CgMeH8B5c0MbQPxGJ8YXiny"
+                "OVuQXEKhwoxuSmJ8cVZn9NQQ4WU042uCkPC1qZLItKLR9q3vBPZcNSSo2ho26K6l"
+                "1BbPqrmfbDLItUQ5Jp2VyLDSg/X7apJXzeSRSDViGjGH9efZif47wjym9m+sx3gA"
+                "dHGS3sCLutscoQg+/lj9ff0z9dzSv6eqZXsDXyZ+qSmQEMRFrNcMu559Qoy7oKth"
+                "cGSR3ZXT3N87NEsCAwEAAQKBwQCpXO+2PDDROMwaEvYLu928k5JT0XsyoXFa0TVO"
+                "y50phKZM9uVMvBZrwmeHZP79nb8zlhFo/2Da3cVCyq0+epnx0X80mcmGJDwh800b"
+                "q5Yte2uMJlOgiVI+0pN5b2g+kVStbKLtb0jsFkK/Esx3lqpvt27nYR+uTaDHnHgh"
+                "W2bDXLmsnwHVd8+o+v0bw4Zi52tHWuHM+foQ631yqWwhansUT0h7zL4Zfcj7Ecph"
+                "X4rkK4dphottthLaz/l9UFiHhQkCYQDYnO3oW5bCDsklfU9S/mOa2wM9dyyVxa4F"
+                "+ODoGsheNtKsOM7oKwmh1Ovnid1F0xrRIuhtMRf7KHVHL4h3KjuKG7QbDQLKmiIi"
+                "7CPa2ZmBoqMIuvWYNb8VIJCMh6f2il8CYQDWY3PMF97EwOiVFjHb6ILDpr4lOPDK"
+                "WitJUT6KDQfEePwb6bRRelcfiAQ79aNglcdgpvKpmN3LwEDBcZfFtQFue/a4nyBq"
+                "PyHKi2yv6ikEDJy7TYzmY4Q78FwkuoNJNZUCYHzkxruxi1QqqEmoXcNRj+aqnsyi"
+                "2R8mEne5DxxkzOCdpYzNWGc+4Vfg53/h2qY22QB6qx7CLryOkEhSHNHwlNHFtWvf"
+                "bZuZkVMnamj2C+9V8cDH43E2lA0/cHjGgs7A6wJhALu7+RH2sSegOcsb1WtZrvB/"
+                "WjCkLQ81aIRadaZUBMJCo5oZy8IxnItLA1IyJvAUGLSFXSewakDayJncy+fgOjGy"
+                "sfk3tx3yzLdd4j4lkecu2CyYm1LAQHJwZ2/uN7rrBQJgeVlRHnYKWj/WBpJ1gg4L"
+                "jPKPYWxkumxFtBkkNKquAoLSt0NegT1k0paaL5sCdRvcu1oslN1ym2A8XngB0grb"
+                "PCqsuS936bvwJI3qG7ZhGuJ3zqnJpnKURYhUrfA6+7ON";
+
+            const char* encrypted =
+                "NZVxiSRSwRKjEXlgSBy5yC5upWh81EbXMFb8ApkbvZ8CFMv6WZT/CoXGsmp/EZq8"
+                "aXtKOCEaaYhPVX326RMFKqmoRAYlZ1b2PLmgsOi8SqZIZ2/W3e01KxfooqYpnm4W"
+                "v2uwZ6YAA4r4gezd+tpUErmHwWKOEzetUgQ9nxX01PGCzfXPa65O1EVDmxk7Rk/l"
+                "+BL/YS4KRqf8fE3sxfKAXMgpPSTe0F34L9n2iSfW9IJQudgTx1wQ/DktfsW500GY";
+
+            juce::MemoryBlock der;
+            expect(Base64Decoder::decode(keyDER, strlen(keyDER), der));
+
+            PEMFormatKey key;
+            expect(key.loadFromDER(der.getData(), der.getSize(), PEMFormatKey::DERFormat::pkcs1PrivateKey));
+            expect(key.getPreparedKey() == nullptr, "1536 bits shouldn't be one of the fixed widths");
+            expect(key.hasCRTComponents());
+
+            expectEquals(key.decryptBase64String(encrypted), message);
+            expectSameAsFullWidth(key, random);
+        }
+    }
+
+    ///checks decryptValue() against juce::RSAKey::applyToValue(), which exponentiates with d and the whole modulus
+    void expectSameAsFullWidth(const PEMFormatKey& key, juce::Random& random)
+    {
+        juce::MemoryBlock der;
+        juce::BigInteger components[9];
+        expect(key.exportToDER(PEMFormatKey::DERFormat::pkcs1PrivateKey, der) && readIntegers(der, components));
+
+        const auto& n = components[1];
+        if( n.isZero() )
+            return;
+
+        for( int i = 0; i < numValues; ++i )
+        {
+            auto value = i == 0 ? n - 1 : randomBelow(random, n);
+
+            auto expected = value;
+            expect(key.juce::RSAKey::applyToValue(expected));
+
+            auto decrypted = value;
+            expect(key.decryptValue(decrypted));
+            expect(decrypted == expected, "decryptValue() disagrees with applyToValue() for " + value.toString(16));
+        }
+    }
+
+    ///applies 'context' to 'value' in place through its limbs, as PEMFormatKey does
+    static bool apply(const MontgomeryKeyContext& context, juce::BigInteger& value)
+    {
+        std::vector<juce::uint32> limbs(static_cast<size_t>(context.getNumLimbs())), scratch(context.getNumScratchLimbs());
+        MontgomeryArithmetic::fromBigInteger(limbs.data(), context.getNumLimbs(), value);
+
+        if( ! context.apply(limbs.data(), scratch.data()) )
+            return false;
+
+        value = MontgomeryArithmetic::toBigInteger(limbs.data(), context.getNumLimbs());
+        return true;
+    }
+
+    ///a random number from 2 up to 'modulus' - 1
+    static juce::BigInteger randomBelow(juce::Random& random, const juce::BigInteger& modulus)
+    {
+        juce::BigInteger value;
+        random.fillBitsRandomly(value, 0, modulus.getHighestBit() + 1);
+        value %= modulus;
+
+        return value < juce::BigInteger(2) ? juce::BigInteger(2) : value;
+    }
+
+    ///reads the INTEGERs of a top-level SEQUENCE into 'integers', which must have room for all of them
+    template <size_t numIntegers>
+    static bool readIntegers(const juce::MemoryBlock& der, juce::BigInteger (&integers)[numIntegers])
+    {
+        DERCursor sequence(der.getData(), der.getSize());
+        if( sequence.getNumChildren() != static_cast<int>(numIntegers) )
+            return false;
+
+        for( size_t i = 0; i < numIntegers; ++i )
+        {
+            auto integer = sequence.getChild(static_cast<int>(i));
+            if( ! integer.isUniversal(0x02) )
+                return false;
+
+            integers[i] = PEMHelpers::convertBigEndianBytesToBigInteger(integer.getContent(), static_cast<size_t>(integer.getContentLength()));
+        }
+
+        return true;
+    }
+
+    static bool decodePEM(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+};
+
+static CRTDecryptionTests crtDecryptionTests;
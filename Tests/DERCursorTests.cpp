@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+    DERCursorTests.cpp
+    Created: 18 Oct 2026 10:56:48am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/DERCursor.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "TestFixtures.h"
+
+/**
+ Walks the fixture keys with a DERCursor and checks it reaches the same nodes as the tree
+ ASN1Decoder::decode() builds, by getChild(), getEncapsulated() and find(), then checks
+ indefinite lengths and that malformed or missing nodes give invalid cursors.
+ */
+struct DERCursorTests : juce::UnitTest
+{
+    DERCursorTests() : juce::UnitTest("DERCursor", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& pkcs1Keys = TestFixtures::getPKCS1Keys();
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            beginTest("the same nodes as ASN1Decoder, " + juce::String(keyPairs[i].numBits) + " bits");
+
+            for( auto* pem : { keyPairs[i].privateKeyPEM, keyPairs[i].publicKeyPEM, pkcs1Keys[i].privateKeyPEM, pkcs1Keys[i].publicKeyPEM } )
+            {
+                juce::MemoryBlock der;
+                expect(decodePEM(pem, der));
+
+                DERBuffer::Ptr buffer = new DERBuffer(der.getData(), der.getSize());
+                auto tree = ASN1Decoder::decode(buffer);
+                expect(tree != nullptr);
+
+                DERCursor root(buffer->getData(), buffer->getSize());
+                expect(root.isValid());
+                expectEquals(static_cast<int>(root.getEnd()), static_cast<int>(buffer->getSize()));
+
+                if( tree != nullptr )
+                    expectSameNode(*tree, root);
+            }
+        }
+
+        beginTest("find() follows the same path as getChild() and getEncapsulated()");
+        {
+            juce::MemoryBlock spkiDER, pkcs8DER;
+            expect(decodePEM(keyPairs[0].publicKeyPEM, spkiDER));
+            expect(decodePEM(keyPairs[0].privateKeyPEM, pkcs8DER));
+
+            //SubjectPublicKeyInfo { algorithm, BIT STRING { RSAPublicKey { modulus, publicExponent } } }
+            DERCursor spki(spkiDER.getData(), spkiDER.getSize());
+            auto rsaPublicKey = spki.find({ 1, DERCursor::encapsulated, 0 });
+            expect(rsaPublicKey.isUniversal(0x10));
+            expect(rsaPublicKey.getOffset() == spki.getChild(1).getEncapsulated(0).getOffset());
+            expect(spki.find({ 1, DERCursor::encapsulated, 0, 1 }).getOffset() == rsaPublicKey.getChild(1).getOffset());
+            expect(spki.find({ 0, 0 }).isUniversal(0x06));
+            expect(spki.find({}).getOffset() == spki.getOffset());
+
+            //PrivateKeyInfo { version, algorithm, OCTET STRING { RSAPrivateKey { version, modulus, ... } } }
+            DERCursor pkcs8(pkcs8DER.getData(), pkcs8DER.getSize());
+            auto modulus = pkcs8.find({ 2, DERCursor::encapsulated, 0, 1 });
+            expect(modulus.isUniversal(0x02));
+            expect(modulus.getOffset() == pkcs8.getChild(2).getEncapsulated().getChild(1).getOffset());
+            expectEquals(pkcs8.find({ 2, DERCursor::encapsulated, 0 }).getNumChildren(), 9);
+
+            //steps that lead nowhere give an invalid cursor, however the path goes on
+            expect(! spki.find({ 2 }).isValid());
+            expect(! spki.find({ 0, 5 }).isValid());
+            expect(! spki.find({ 1, 0 }).isValid());
+            expect(! spki.find({ 0, DERCursor::encapsulated, 0 }).isValid());
+            expect(! pkcs8.find({ 0, 0, 0 }).isValid());
+            expect(! pkcs8.find({ 2, DERCursor::encapsulated, 0, 9 }).isValid());
+            expect(! pkcs8.find({ 2, DERCursor::encapsulated, 1 }).isValid());
+        }
+
+        beginTest("indefinite lengths");
+        {
+            //SEQUENCE (indefinite) { INTEGER 5, SEQUENCE (indefinite) { BOOLEAN TRUE } }, then NULL
+            const juce::uint8 ber[] = { 0x30, 0x80, 0x02, 0x01, 0x05, 0x30, 0x80, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x05, 0x00 };
+
+            DERCursor root(ber, sizeof(ber));
+            expectEquals(root.getContentLength(), static_cast<juce::int64>(-1));
+            expectEquals(static_cast<int>(root.getEnd()), 14);
+            expectEquals(root.getNumChildren(), 2);
+            expect(root.getNextSibling().isUniversal(0x05));
+
+            auto inner = root.getChild(1);
+            expectEquals(static_cast<int>(inner.getOffset()), 5);
+            expectEquals(static_cast<int>(inner.getEnd()), 12);
+            expectEquals(inner.getNumChildren(), 1);
+
+            //the end-of-contents octets aren't a node
+            expect(root.find({ 1, 0 }).isUniversal(0x01));
+            expect(! root.find({ 1, 1 }).isValid());
+            expect(! root.getChild(2).isValid());
+            expect(! inner.getNextSibling().isValid());
+
+            const juce::uint8 empty[] = { 0x30, 0x80, 0x00, 0x00 };
+            expectEquals(DERCursor(empty, sizeof(empty)).getNumChildren(), 0);
+            expect(! DERCursor(empty, sizeof(empty)).getChild(0).isValid());
+        }
+
+        beginTest("malformed nodes");
+        {
+            //a SEQUENCE whose INTEGER runs past the end of it
+            const juce::uint8 overrun[] = { 0x30, 0x03, 0x02, 0x05, 0x01 };
+            DERCursor sequence(overrun, sizeof(overrun));
+            expect(sequence.isValid());
+            expect(! sequence.getChild(0).isValid());
+            expectEquals(sequence.getNumChildren(), -1);
+
+            //a SEQUENCE that claims more bytes than there are
+            const juce::uint8 truncated[] = { 0x30, 0x05, 0x02, 0x01, 0x05 };
+            expect(! DERCursor(truncated, sizeof(truncated)).isValid());
+
+            //an OCTET STRING that doesn't hold ASN.1, and a BIT STRING with unused bits
+            const juce::uint8 octetString[] = { 0x04, 0x03, 0x01, 0x02, 0x03 };
+            expect(! DERCursor(octetString, sizeof(octetString)).getEncapsulated().isValid());
+            expectEquals(DERCursor(octetString, sizeof(octetString)).getNumEncapsulated(), -1);
+
+            const juce::uint8 bitString[] = { 0x03, 0x04, 0x01, 0x05, 0x00, 0x00 };
+            expect(! DERCursor(bitString, sizeof(bitString)).getEncapsulated().isValid());
+            expectEquals(DERCursor(bitString, sizeof(bitString)).getNumEncapsulated(), -1);
+
+            //primitive nodes have no children, and constructed ones encapsulate nothing
+            const juce::uint8 integer[] = { 0x02, 0x01, 0x05 };
+            expect(! DERCursor(integer, sizeof(integer)).getChild(0).isValid());
+            expectEquals(DERCursor(integer, sizeof(integer)).getNumChildren(), -1);
+            expectEquals(DERCursor(overrun, sizeof(overrun)).getNumEncapsulated(), -1);
+
+            expect(! DERCursor().isValid());
+            expect(! DERCursor().getChild(0).isValid());
+            expectEquals(static_cast<int>(DERCursor().getEnd()), 0);
+        }
+    }
+
+    ///checks the cursor is at the same node as 'node', then each of their children in turn
+    void expectSameNode(const ASN1& node, const DERCursor& cursor)
+    {
+        auto where = "the node at offset " + juce::String(node.offset);
+
+        expect(cursor.isValid(), where);
+        if( ! cursor.isValid() )
+            return;
+
+        expectEquals(static_cast<int>(cursor.getOffset()), static_cast<int>(node.offset), where);
+        expectEquals(static_cast<int>(cursor.getTag().tagNumber), static_cast<int>(node.tag.tagNumber), where);
+        expect(cursor.getTag().tagConstructed == node.tag.tagConstructed, where);
+        expectEquals(cursor.getContentLength(), node.length, where);
+        expect(cursor.getContent() == node.getContent(), where);
+
+        auto numChildren = static_cast<int>(node.sub.size());
+        if( node.tag.tagConstructed )
+        {
+            expectEquals(cursor.getNumChildren(), numChildren, where);
+            for( int i = 0; i < numChildren; ++i )
+                expectSameNode(*node.sub[static_cast<size_t>(i)], cursor.getChild(i));
+
+            expect(! cursor.getChild(numChildren).isValid(), where);
+        }
+        else if( numChildren > 0 )
+        {
+            //a BIT STRING or OCTET STRING that the decoder found ASN.1 in
+            expectEquals(cursor.getNumEncapsulated(), numChildren, where);
+            for( int i = 0; i < numChildren; ++i )
+                expectSameNode(*node.sub[static_cast<size_t>(i)], cursor.getEncapsulated(i));
+
+            expect(! cursor.getEncapsulated(numChildren).isValid(), where);
+        }
+    }
+
+    static bool decodePEM(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+};
+
+static DERCursorTests derCursorTests;
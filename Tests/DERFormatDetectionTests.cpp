@@ -0,0 +1,144 @@
+/*
+  ==============================================================================
+
+    DERFormatDetectionTests.cpp
+    Created: 18 Oct 2026 11:32:40am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "TestFixtures.h"
+
+/**
+ Checks PEMFormatKey::detectDERFormat() on the fixture keys as raw DER in each of the four
+ formats, that loadFromDER() loads each of them without being told the format, and that
+ a key whose algorithm isn't rsaEncryption, or DER that isn't a key at all, is unknown.
+ */
+struct DERFormatDetectionTests : juce::UnitTest
+{
+    DERFormatDetectionTests() : juce::UnitTest("DERFormatDetection", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        using DERFormat = PEMFormatKey::DERFormat;
+
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& pkcs1Keys = TestFixtures::getPKCS1Keys();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            beginTest("raw DER in every format, " + juce::String(keyPairs[i].numBits) + " bits");
+
+            struct Input
+            {
+                const char* pem;
+                DERFormat format;
+            };
+
+            const Input inputs[] =
+            {
+                { keyPairs[i].publicKeyPEM, DERFormat::subjectPublicKeyInfo },
+                { keyPairs[i].privateKeyPEM, DERFormat::pkcs8PrivateKey },
+                { pkcs1Keys[i].publicKeyPEM, DERFormat::pkcs1PublicKey },
+                { pkcs1Keys[i].privateKeyPEM, DERFormat::pkcs1PrivateKey },
+            };
+
+            juce::MemoryBlock spki;
+            expect(decodePEM(keyPairs[i].publicKeyPEM, spki));
+
+            for( const auto& input : inputs )
+            {
+                juce::String name(PEMFormatKey::getPEMLabel(input.format));
+
+                juce::MemoryBlock der;
+                expect(decodePEM(input.pem, der));
+                expect(PEMFormatKey::detectDERFormat(der.getData(), der.getSize()) == input.format, name + " wasn't detected");
+
+                PEMFormatKey key;
+                expect(key.loadFromDER(der.getData(), der.getSize()), name + " didn't load");
+
+                //each of them is the same key
+                juce::MemoryBlock exported;
+                expect(key.exportToDER(DERFormat::subjectPublicKeyInfo, exported) && exported == spki, name + " isn't the same key");
+
+                const auto isPrivate = input.format == DERFormat::pkcs8PrivateKey || input.format == DERFormat::pkcs1PrivateKey;
+                expect(key.isPrivateKey() == isPrivate);
+                if( isPrivate )
+                    expectEquals(key.decryptBase64String(ciphertexts[i].encrypted), message);
+            }
+        }
+
+        beginTest("keys for another algorithm");
+        {
+            juce::MemoryBlock spki, pkcs8;
+            expect(decodePEM(keyPairs[0].publicKeyPEM, spki));
+            expect(decodePEM(keyPairs[0].privateKeyPEM, pkcs8));
+
+            //OBJECT IDENTIFIER 1.2.840.113549.1.1.1, rsaEncryption
+            const juce::uint8 rsaEncryption[] = { 0x06, 0x09, 0x2A, 0x86, 0x48, 0x86, 0xF7, 0x0D, 0x01, 0x01, 0x01 };
+
+            for( auto* der : { &spki, &pkcs8 } )
+            {
+                auto* bytes = static_cast<juce::uint8*>(der->getData());
+                auto* oid = std::search(bytes, bytes + der->getSize(), std::begin(rsaEncryption), std::end(rsaEncryption));
+                expect(oid != bytes + der->getSize(), "no rsaEncryption OID");
+                if( oid == bytes + der->getSize() )
+                    continue;
+
+                //1.2.840.113549.1.1.11, sha256WithRSAEncryption: a signature algorithm, not a key's
+                oid[sizeof(rsaEncryption) - 1] = 0x0B;
+                expect(PEMFormatKey::detectDERFormat(der->getData(), der->getSize()) == DERFormat::unknown);
+
+                PEMFormatKey key;
+                expect(! key.loadFromDER(der->getData(), der->getSize()));
+                expectEquals(static_cast<int>(key.getMaxPlaintextSize()), 0);
+            }
+        }
+
+        beginTest("DER that isn't a key");
+        {
+            juce::MemoryBlock spki;
+            expect(decodePEM(keyPairs[0].publicKeyPEM, spki));
+
+            //cut short, so the top-level SEQUENCE runs past the end
+            expect(PEMFormatKey::detectDERFormat(spki.getData(), spki.getSize() / 2) == DERFormat::unknown);
+            expect(PEMFormatKey::detectDERFormat(spki.getData(), 0) == DERFormat::unknown);
+
+            //an INTEGER on its own, a SEQUENCE with one INTEGER, and one with an INTEGER then a NULL
+            const juce::uint8 integer[] = { 0x02, 0x01, 0x05 };
+            const juce::uint8 oneInteger[] = { 0x30, 0x03, 0x02, 0x01, 0x05 };
+            const juce::uint8 integerThenNull[] = { 0x30, 0x05, 0x02, 0x01, 0x05, 0x05, 0x00 };
+            expect(PEMFormatKey::detectDERFormat(integer, sizeof(integer)) == DERFormat::unknown);
+            expect(PEMFormatKey::detectDERFormat(oneInteger, sizeof(oneInteger)) == DERFormat::unknown);
+            expect(PEMFormatKey::detectDERFormat(integerThenNull, sizeof(integerThenNull)) == DERFormat::unknown);
+
+            //only the tags are looked at: three INTEGERs are detected as an RSAPrivateKey, but don't load as one
+            const juce::uint8 threeIntegers[] = { 0x30, 0x09, 0x02, 0x01, 0x00, 0x02, 0x01, 0x05, 0x02, 0x01, 0x03 };
+            expect(PEMFormatKey::detectDERFormat(threeIntegers, sizeof(threeIntegers)) == DERFormat::pkcs1PrivateKey);
+
+            PEMFormatKey key;
+            key.setAssertOnMalformedInput(false);
+            expect(! key.loadFromDER(threeIntegers, sizeof(threeIntegers)));
+        }
+    }
+
+    static bool decodePEM(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+};
+
+static DERFormatDetectionTests derFormatDetectionTests;
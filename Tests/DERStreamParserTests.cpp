@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    DERStreamParserTests.cpp
+    Created: 18 Oct 2026 7:58:40am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/DERStreamParser.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "TestFixtures.h"
+
+/**
+ Streams certificates through a DERStreamParser to capture their SubjectPublicKeyInfos,
+ then checks the events for BER's indefinite lengths and the limit on nesting.
+ */
+struct DERStreamParserTests : juce::UnitTest
+{
+    DERStreamParserTests() : juce::UnitTest("DERStreamParser", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& certificates = TestFixtures::getCertificates();
+
+        beginTest("the SubjectPublicKeyInfo of v1 and v3 certificates is captured from a stream");
+        {
+            //every certificate, one after the other, as in a file of DER certificates
+            juce::MemoryBlock bundle;
+            for( const auto& certificate : certificates )
+            {
+                juce::MemoryBlock der;
+                expect(decodePEM(certificate.pem, der));
+                bundle.append(der.getData(), der.getSize());
+            }
+
+            juce::MemoryInputStream stream(bundle, false);
+            KeyFinder finder;
+            expect(DERStreamParser().parse(stream, finder));
+            expect(stream.isExhausted());
+
+            expectEquals(finder.keys.size(), static_cast<int>(certificates.size()));
+            for( int i = 0; i < finder.keys.size() && i < static_cast<int>(certificates.size()); ++i )
+            {
+                auto keyPairIndex = certificates[static_cast<size_t>(i)].keyPairIndex;
+                PEMFormatKey key;
+                key.setAssertOnMalformedInput(false);
+
+                if( keyPairIndex < 0 )
+                {
+                    expect(! key.loadFromDER(finder.keys[i]->getData(), finder.keys[i]->getSize()));
+                    continue;
+                }
+
+                juce::MemoryBlock expected;
+                expect(decodePEM(keyPairs[static_cast<size_t>(keyPairIndex)].publicKeyPEM, expected));
+                expect(*finder.keys[i] == expected, "the captured SubjectPublicKeyInfo isn't the certificate's key");
+                expect(key.loadFromDER(finder.keys[i]->getData(), finder.keys[i]->getSize(), PEMFormatKey::DERFormat::subjectPublicKeyInfo));
+            }
+        }
+
+        beginTest("indefinite lengths");
+        {
+            //SEQUENCE (indefinite) { INTEGER 5, SEQUENCE (indefinite) { BOOLEAN TRUE } }
+            const juce::uint8 ber[] = { 0x30, 0x80, 0x02, 0x01, 0x05, 0x30, 0x80, 0x01, 0x01, 0xFF, 0x00, 0x00, 0x00, 0x00 };
+
+            Recorder recorder;
+            expect(parse(ber, sizeof(ber), recorder));
+            expectEquals(recorder.events.joinIntoString(" "),
+                         juce::String("start(16,0,0,-1) primitive(2,1,0,1) start(16,1,1,-1) primitive(1,2,0,1) end(16) end(16)"));
+
+            //a capture of an indefinite-length node takes everything up to its end-of-contents octets
+            recorder = Recorder();
+            recorder.captureDepth = 1;
+            expect(parse(ber, sizeof(ber), recorder));
+            expect(recorder.capturedBytes.getSize() == 7 && std::memcmp(recorder.capturedBytes.getData(), ber + 5, 7) == 0);
+
+            //primitive nodes can't have an indefinite length
+            const juce::uint8 indefinitePrimitive[] = { 0x30, 0x80, 0x04, 0x80, 0x00, 0x00, 0x00, 0x00 };
+            recorder = Recorder();
+            expect(! parse(indefinitePrimitive, sizeof(indefinitePrimitive), recorder));
+
+            //nor can a container end early with end-of-contents octets when it has a definite length
+            const juce::uint8 earlyEnd[] = { 0x30, 0x04, 0x00, 0x00, 0x05, 0x00 };
+            recorder = Recorder();
+            expect(! parse(earlyEnd, sizeof(earlyEnd), recorder));
+
+            //and the input can't end before them
+            recorder = Recorder();
+            expect(! parse(ber, sizeof(ber) - 2, recorder));
+        }
+
+        beginTest("the depth limit");
+        {
+            DERStreamParser::Options options;
+            options.maxDepth = 4;
+
+            //an INTEGER inside 'numContainers' SEQUENCEs, with definite and indefinite lengths
+            for( auto indefinite : { false, true } )
+            {
+                for( int numContainers = 1; numContainers <= options.maxDepth + 1; ++numContainers )
+                {
+                    auto ber = makeNested(numContainers, indefinite);
+                    auto shouldParse = numContainers <= options.maxDepth;
+
+                    Recorder recorder;
+                    expect(parse(ber.getData(), ber.getSize(), recorder, options) == shouldParse,
+                           juce::String(numContainers) + " containers");
+
+                    //skipping an indefinite-length node walks its nesting too
+                    recorder = Recorder();
+                    recorder.skipAll = true;
+                    expect(parse(ber.getData(), ber.getSize(), recorder, options) == (shouldParse || ! indefinite));
+                }
+            }
+        }
+    }
+
+    static bool decodePEM(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+
+    static bool parse(const void* data, size_t numBytes, DERStreamParser::Listener& listener,
+                      DERStreamParser::Options options = {})
+    {
+        juce::MemoryInputStream stream(data, numBytes, false);
+        return DERStreamParser(options).parse(stream, listener);
+    }
+
+    static juce::MemoryBlock makeNested(int numContainers, bool indefinite)
+    {
+        juce::MemoryBlock ber;
+        const juce::uint8 integer[] = { 0x02, 0x01, 0x05 };
+
+        if( indefinite )
+        {
+            for( int i = 0; i < numContainers; ++i )
+                ber.append("\x30\x80", 2);
+
+            ber.append(integer, sizeof(integer));
+
+            for( int i = 0; i < numContainers; ++i )
+                ber.append("\x00\x00", 2);
+
+            return ber;
+        }
+
+        ber.append(integer, sizeof(integer));
+        for( int i = 0; i < numContainers; ++i )
+        {
+            juce::MemoryBlock container;
+            container.append("\x30", 1);
+            auto length = static_cast<juce::uint8>(ber.getSize());
+            container.append(&length, 1);
+            container.append(ber.getData(), ber.getSize());
+            ber = container;
+        }
+
+        return ber;
+    }
+
+    ///the listener from the example in DERStreamParser.h, keeping the captured DER instead of loading it
+    struct KeyFinder : DERStreamParser::Listener
+    {
+        Action start(const DERStreamParser::Node& node) override
+        {
+            if( node.depth == 0 )
+                return Action::enter;
+
+            if( node.depth == 1 )
+            {
+                hasVersion = false;
+                return node.index == 0 ? Action::enter : Action::skip;
+            }
+
+            if( node.index == 0 && node.tag.tagClass == 2 && node.tag.tagNumber == 0 )
+                hasVersion = true;
+
+            return node.depth == 2 && node.index == (hasVersion ? 6 : 5) ? Action::capture : Action::skip;
+        }
+
+        Action captured(const DERStreamParser::Node&, const void* der, size_t numBytes) override
+        {
+            keys.add(new juce::MemoryBlock(der, numBytes));
+            return Action::skip;
+        }
+
+        juce::OwnedArray<juce::MemoryBlock> keys;
+        bool hasVersion = false;
+    };
+
+    ///writes down every event as "what(tag,depth,index,length)"
+    struct Recorder : DERStreamParser::Listener
+    {
+        Action start(const DERStreamParser::Node& node) override
+        {
+            if( skipAll )
+                return Action::skip;
+
+            if( node.depth == captureDepth )
+                return Action::capture;
+
+            events.add("start(" + describe(node) + ")");
+            return Action::enter;
+        }
+
+        Action end(const DERStreamParser::Node& node) override
+        {
+            events.add("end(" + juce::String(node.tag.tagNumber) + ")");
+            return Action::skip;
+        }
+
+        Action primitive(const DERStreamParser::Node& node, juce::InputStream&) override
+        {
+            events.add("primitive(" + describe(node) + ")");
+            return Action::skip;
+        }
+
+        Action captured(const DERStreamParser::Node&, const void* encoding, size_t numBytes) override
+        {
+            capturedBytes.replaceAll(encoding, numBytes);
+            return Action::skip;
+        }
+
+        static juce::String describe(const DERStreamParser::Node& node)
+        {
+            return juce::String(node.tag.tagNumber) + "," + juce::String(node.depth) + ","
+                 + juce::String(node.index) + "," + juce::String(node.length);
+        }
+
+        juce::StringArray events;
+        juce::MemoryBlock capturedBytes;
+        int captureDepth = -1;
+        bool skipAll = false;
+    };
+};
+
+static DERStreamParserTests derStreamParserTests;
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    DecryptionTests.cpp
+    Created: 18 Oct 2026 3:40:12am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/PEMBatchDecryptor.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "TestFixtures.h"
+
+/**
+ Decrypts ciphertexts that OpenSSL padded, and checks every path hands back the message
+ that follows the padding.
+ */
+struct DecryptionTests : juce::UnitTest
+{
+    DecryptionTests() : juce::UnitTest("Decryption", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            const auto& keyPair = keyPairs[i];
+            const auto& padded = ciphertexts[i];
+            jassert( padded.numBits == keyPair.numBits );
+
+            beginTest("PKCS#1 v1.5 padding, " + juce::String(keyPair.numBits) + " bits");
+
+            PEMFormatKey privateKey, publicKey;
+            privateKey.loadFromPEMFormattedString(keyPair.privateKeyPEM);
+            publicKey.loadFromPEMFormattedString(keyPair.publicKeyPEM);
+            expect(privateKey.getMaxPlaintextSize() > 0, "the private key didn't load");
+            expect(publicKey.getMaxPlaintextSize() > 0, "the public key didn't load");
+
+            //block type 1: a signature, recovered with the public key
+            expectEquals(publicKey.decryptBase64String(padded.signature), message);
+            //block type 2: an encryption, decrypted with the private key
+            expectEquals(privateKey.decryptBase64String(padded.encrypted), message);
+
+            //the whole block comes back from decryptBase64(), with the message at the end of it
+            PEMFormatKey::DecryptScratch scratch;
+            juce::HeapBlock<juce::uint8> plaintext(privateKey.getMaxPlaintextSize());
+            size_t numPlaintextBytes = 0;
+            const auto* signature = padded.signature;
+            expect(publicKey.decryptBase64(signature, strlen(signature), plaintext, privateKey.getMaxPlaintextSize(), numPlaintextBytes, &scratch));
+            expect(plaintext[0] == 0x01);
+            expectEquals(numPlaintextBytes - PEMFormatKey::getMessageOffset(plaintext, numPlaintextBytes), static_cast<size_t>(message.length()));
+            expectEquals(PEMFormatKey::getMessageString(plaintext, numPlaintextBytes), message);
+
+            const auto* encrypted = padded.encrypted;
+            expect(privateKey.decryptBase64(encrypted, strlen(encrypted), plaintext, privateKey.getMaxPlaintextSize(), numPlaintextBytes, &scratch));
+            expect(plaintext[0] == 0x02);
+            expectEquals(PEMFormatKey::getMessageString(plaintext, numPlaintextBytes), message);
+
+            //and the batch decryptor strips it the same way
+            juce::StringArray batch;
+            for( int n = 0; n < 9; ++n )
+                batch.add(encrypted);
+
+            PEMBatchDecryptor decryptor(privateKey);
+            for( const auto& result : decryptor.decryptBase64Strings(batch) )
+                expectEquals(result, message);
+        }
+
+        beginTest("zero, and ciphertexts that aren't below the modulus, fail everywhere");
+        {
+            for( const auto& keyPair : keyPairs )
+            {
+                PEMFormatKey key;
+                key.loadFromPEMFormattedString(keyPair.privateKeyPEM);
+                auto numModulusBytes = key.getMaxPlaintextSize();
+
+                //every bit set is above any modulus of that width, and a byte more is above it too
+                juce::MemoryBlock zero(numModulusBytes, true), allOnes(numModulusBytes), tooLong(numModulusBytes + 1);
+                allOnes.fillWith(0xff);
+                tooLong.fillWith(0x01);
+
+                juce::StringArray base64;
+                std::vector<PEMFormatKey::Decryption> decryptions;
+                std::vector<juce::HeapBlock<juce::uint8>> plaintexts;
+
+                for( const auto* ciphertext : { &zero, &allOnes, &tooLong } )
+                {
+                    auto name = juce::String(keyPair.numBits) + " bits, " + juce::String(static_cast<int>(ciphertext->getSize())) + " bytes";
+
+                    juce::MemoryBlock result("x", 1);
+                    expect(! key.decryptBytes(ciphertext->getData(), ciphertext->getSize(), result), name);
+                    expect(result.isEmpty(), name);
+
+                    juce::HeapBlock<juce::uint8> plaintext(numModulusBytes);
+                    size_t numPlaintextBytes = 0;
+                    expect(! key.decrypt(ciphertext->getData(), ciphertext->getSize(), plaintext, numModulusBytes, numPlaintextBytes), name);
+
+                    base64.add(juce::Base64::toBase64(ciphertext->getData(), ciphertext->getSize()));
+                    expect(key.decryptBase64String(base64[base64.size() - 1]).isEmpty(), name);
+
+                    plaintexts.emplace_back(numModulusBytes);
+                    decryptions.push_back({ ciphertext->getData(), ciphertext->getSize(), plaintexts.back().get(), numModulusBytes });
+                }
+
+                expectEquals(key.decryptBatch(decryptions.data(), decryptions.size()), 0);
+                for( const auto& decryption : decryptions )
+                    expect(! decryption.decrypted);
+
+                const juce::MemoryBlock raw[] = { zero, allOnes, tooLong };
+                PEMBatchDecryptor decryptor(key);
+                for( const auto& result : decryptor.decryptRaw(raw, 3) )
+                    expect(result.isEmpty());
+
+                for( const auto& result : decryptor.decryptBase64Strings(base64) )
+                    expect(result.isEmpty());
+            }
+        }
+
+        beginTest("primes that don't match the modulus, without validation");
+        {
+            /*
+             the modulus and private exponent of a 1536-bit key, which isn't one of the fixed widths,
+             with the primes and CRT values of the 1024-bit fixture key, which are too narrow for it.
+             made with: openssl genpkey -algorithm RSA -pkeyopt rsa_keygen_bits:1536, and the
+             ciphertext with: openssl pkeyutl -encrypt on BenchmarkFixtures::getMessage()
+             */
+            const char* mismatchedKey =
+                "MIIC3QIBAAKBwQC1Z1WLbYr/xK2LEqxYjlNWMIUt4CgMeH8B5c0MbQPxGJ8YXiny"
+                "OVuQXEKhwoxuSmJ8cVZn9NQQ4WU042uCkPC1qZLItKLR9q3vBPZcNSSo2ho26K6l"
+                "1BbPqrmfbDLItUQ5Jp2VyLDSg/X7apJXzeSRSDViGjGH9efZif47wjym9m+sx3gA"
+                "dHGS3sCLutscoQg+/lj9ff0z9dzSv6eqZXsDXyZ+qSmQEMRFrNcMu559Qoy7oKth"
+                "cGSR3ZXT3N87NEsCAwEAAQKBwQCpXO+2PDDROMwaEvYLu928k5JT0XsyoXFa0TVO"
+                "y50phKZM9uVMvBZrwmeHZP79nb8zlhFo/2Da3cVCyq0+epnx0X80mcmGJDwh800b"
+                "q5Yte2uMJlOgiVI+0pN5b2g+kVStbKLtb0jsFkK/Esx3lqpvt27nYR+uTaDHnHgh"
+                "W2bDXLmsnwHVd8+o+v0bw4Zi52tHWuHM+foQ631yqWwhansUT0h7zL4Zfcj7Ecph"
+                "X4rkK4dphottthLaz/l9UFiHhQkCQQD4dPZZiNQh0z+04cgCcOr/Av656p5TM8sq"
+                "iSPQ20HfU1AgYTdw90JxupDdJRzMi6Ym/ASOjEl6khIVTYHiMZtzAkEAwIUIqePm"
+                "XutO0CPuQM1n4m8SzK60yi1xVJJutIghDE9hZaPCbCKtnJjPreNFHYOxXW5UTm5w"
+                "wp9/5pA6y1exQQJAd05C1W+c3blBCCy7DGEIlvfrNX9yE2X1kzFTX4FJumGZQlMs"
+                "ejRhVZdO5MJjd90/Jc0yqvi2eAMYZ95WFjXX/QJAf6MzvT8lauTjGcfYnAoSx+MQ"
+                "ObfSkQBT1NhIoVRnZLv0POi3a+4J4HrHpee52PmIzALrzhwWklIhAAG7mTkIgQJB"
+                "ALD0NIf8iYWza92/TJyFEV5ZIzADDX4iel7vjHYxUPR8U3Yy+Re/Jfb0MMyDrZbi"
+                "ayZN3HzhSgY6wkHG0adsC7w=";
+
+            const char* encrypted =
+                "NZVxiSRSwRKjEXlgSBy5yC5upWh81EbXMFb8ApkbvZ8CFMv6WZT/CoXGsmp/EZq8"
+                "aXtKOCEaaYhPVX326RMFKqmoRAYlZ1b2PLmgsOi8SqZIZ2/W3e01KxfooqYpnm4W"
+                "v2uwZ6YAA4r4gezd+tpUErmHwWKOEzetUgQ9nxX01PGCzfXPa65O1EVDmxk7Rk/l"
+                "+BL/YS4KRqf8fE3sxfKAXMgpPSTe0F34L9n2iSfW9IJQudgTx1wQ/DktfsW500GY";
+
+            juce::MemoryBlock der;
+            expect(Base64Decoder::decode(mismatchedKey, strlen(mismatchedKey), der));
+
+            PEMFormatKey key;
+            key.setValidation(PEMFormatKey::Validation::none);
+            expect(key.loadFromDER(der.getData(), der.getSize(), PEMFormatKey::DERFormat::pkcs1PrivateKey));
+
+            //the primes can't be used, so it decrypts with the private exponent and the whole modulus
+            expectEquals(key.decryptBase64String(encrypted), message);
+
+            //the full checks turn it away
+            PEMFormatKey checked;
+            checked.setAssertOnMalformedInput(false);
+            expect(! checked.loadFromDER(der.getData(), der.getSize(), PEMFormatKey::DERFormat::pkcs1PrivateKey));
+        }
+
+        beginTest("messages without padding");
+
+        const juce::uint8 unpadded[] = { 't', 'e', 's', 't' };
+        expectEquals(PEMFormatKey::getMessageOffset(unpadded, sizeof(unpadded)), static_cast<size_t>(0));
+        expectEquals(PEMFormatKey::getMessageString(unpadded, sizeof(unpadded)), juce::String("test"));
+
+        const juce::uint8 emptyMessage[] = { 0x02, 0x5a, 0x00 };
+        expectEquals(PEMFormatKey::getMessageOffset(emptyMessage, sizeof(emptyMessage)), sizeof(emptyMessage));
+        expect(PEMFormatKey::getMessageString(emptyMessage, sizeof(emptyMessage)).isEmpty());
+    }
+};
+
+static DecryptionTests decryptionTests;
@@ -0,0 +1,201 @@
+/*
+  ==============================================================================
+
+    FixedWidthKeyTests.cpp
+    Created: 18 Oct 2026 3:52:46am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/FixedWidthKey.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "TestFixtures.h"
+
+/**
+ Checks every way of applying a FixedWidthKey against juce::BigInteger arithmetic,
+ and that none of them accept zero or anything that isn't below the modulus.
+ */
+struct FixedWidthKeyTests : juce::UnitTest
+{
+    FixedWidthKeyTests() : juce::UnitTest("FixedWidthKey", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        for( const auto& keyPair : BenchmarkFixtures::getKeyPairs() )
+        {
+            beginTest("fixture keys against BigInteger, " + juce::String(keyPair.numBits) + " bits");
+
+            for( auto* pem : { keyPair.privateKeyPEM, keyPair.publicKeyPEM } )
+            {
+                PEMFormatKey key;
+                key.loadFromPEMFormattedString(pem);
+
+                auto prepared = key.getPreparedKey();
+                expect(prepared != nullptr, "the key wasn't prepared");
+                if( prepared == nullptr )
+                    continue;
+
+                checkAgainstBigInteger(*prepared, random, [&key](juce::BigInteger& value) { return key.juce::RSAKey::applyToValue(value); });
+                checkRejectsUnusableInputs(*prepared);
+            }
+        }
+
+        for( auto numBits : { 1024, 2048 } )
+        {
+            beginTest("random odd moduli against BigInteger, " + juce::String(numBits) + " bits");
+
+            for( int i = 0; i < 4; ++i )
+            {
+                juce::BigInteger modulus;
+                random.fillBitsRandomly(modulus, 0, numBits);
+                modulus.setBit(numBits - 1);
+                modulus.setBit(0);
+
+                //both the small odd exponent path and the windowed path
+                juce::BigInteger exponent;
+                if( i % 2 == 0 )
+                    exponent = 65537;
+                else
+                    random.fillBitsRandomly(exponent, 0, numBits - 1);
+
+                auto key = FixedWidthKey::create(modulus, exponent);
+                expect(key != nullptr);
+                if( key == nullptr )
+                    continue;
+
+                checkAgainstBigInteger(*key, random, [&](juce::BigInteger& value)
+                {
+                    value.exponentModulo(exponent, modulus);
+                    return true;
+                });
+                checkRejectsUnusableInputs(*key);
+            }
+        }
+    }
+
+    template <typename ReferenceFunction>
+    void checkAgainstBigInteger(const FixedWidthKey& key, juce::Random& random, ReferenceFunction&& reference)
+    {
+        constexpr size_t numInputs = 9;
+
+        const auto modulus = key.getModulus();
+        const auto numModulusBytes = static_cast<size_t>(modulus.getHighestBit() + 8) / 8;
+
+        juce::MemoryBlock inputs[numInputs];
+        juce::BigInteger expected[numInputs];
+
+        for( size_t i = 0; i < numInputs; ++i )
+        {
+            //the smallest and largest inputs there are, and random ones in between
+            auto value = i == 0 ? juce::BigInteger(1)
+                       : i == 1 ? modulus - 1
+                                : random.nextLargeNumber(modulus);
+            if( value.isZero() )
+                value = 2;
+
+            inputs[i] = toBigEndian(value, numModulusBytes);
+
+            auto applied = value;
+            expect(key.apply(applied));
+            expected[i] = value;
+            expect(reference(expected[i]));
+            expect(applied == expected[i], "apply(BigInteger&) disagrees with BigInteger");
+
+            juce::MemoryBlock minimal;
+            expect(key.apply(inputs[i].getData(), inputs[i].getSize(), minimal));
+            expect(minimal == toBigEndian(expected[i], static_cast<size_t>(expected[i].getHighestBit() + 8) / 8),
+                   "apply(MemoryBlock&) disagrees with BigInteger");
+
+            juce::MemoryBlock padded(numModulusBytes);
+            expect(key.apply(inputs[i].getData(), inputs[i].getSize(), padded.getData(), padded.getSize()));
+            expect(padded == toBigEndian(expected[i], numModulusBytes), "apply(void*) disagrees with BigInteger");
+        }
+
+        //every lane of a batch, including a last set that leaves some lanes idle
+        const void* inputPointers[numInputs];
+        size_t numInputBytes[numInputs];
+        juce::MemoryBlock results[numInputs];
+        void* resultPointers[numInputs];
+        bool succeeded[numInputs];
+
+        for( size_t i = 0; i < numInputs; ++i )
+        {
+            inputPointers[i] = inputs[i].getData();
+            numInputBytes[i] = inputs[i].getSize();
+            results[i].setSize(numModulusBytes);
+            resultPointers[i] = results[i].getData();
+        }
+
+        juce::HeapBlock<juce::uint8> scratch(key.getBatchScratchSize());
+        expectEquals(key.applyBatch(inputPointers, numInputBytes, resultPointers, numModulusBytes, succeeded, numInputs, scratch),
+                     static_cast<int>(numInputs));
+
+        for( size_t i = 0; i < numInputs; ++i )
+            expect(succeeded[i] && results[i] == toBigEndian(expected[i], numModulusBytes), "applyBatch() disagrees with BigInteger");
+    }
+
+    void checkRejectsUnusableInputs(const FixedWidthKey& key)
+    {
+        const auto modulus = key.getModulus();
+        const auto numModulusBytes = static_cast<size_t>(modulus.getHighestBit() + 8) / 8;
+
+        //zero fails like it does with BigInteger arithmetic, and so does anything that isn't below the modulus
+        const juce::BigInteger unusable[] = { juce::BigInteger(0), modulus, modulus + 1 };
+        for( const auto& value : unusable )
+        {
+            auto copy = value;
+            expect(! key.apply(copy), "apply(BigInteger&) accepted " + value.toString(16));
+
+            auto bytes = toBigEndian(value, numModulusBytes + 1);
+            juce::MemoryBlock result;
+            expect(! key.apply(bytes.getData(), bytes.getSize(), result), "apply(MemoryBlock&) accepted " + value.toString(16));
+
+            juce::MemoryBlock padded(numModulusBytes);
+            expect(! key.apply(bytes.getData(), bytes.getSize(), padded.getData(), padded.getSize()),
+                   "apply(void*) accepted " + value.toString(16));
+        }
+
+        //empty input is zero too
+        juce::MemoryBlock result;
+        expect(! key.apply(nullptr, 0, result));
+
+        //and they fail on their own in a batch, leaving the lanes around them alone
+        auto zero = toBigEndian(0, numModulusBytes);
+        auto one = toBigEndian(1, numModulusBytes);
+        const void* inputs[] = { zero.getData(), one.getData(), zero.getData() };
+        const size_t numInputBytes[] = { zero.getSize(), one.getSize(), zero.getSize() };
+        juce::MemoryBlock results[3];
+        void* resultPointers[3];
+        for( int i = 0; i < 3; ++i )
+        {
+            results[i].setSize(numModulusBytes);
+            resultPointers[i] = results[i].getData();
+        }
+
+        bool succeeded[3];
+        juce::HeapBlock<juce::uint8> scratch(key.getBatchScratchSize());
+        expectEquals(key.applyBatch(inputs, numInputBytes, resultPointers, numModulusBytes, succeeded, 3, scratch), 1);
+        expect(! succeeded[0] && succeeded[1] && ! succeeded[2]);
+        expect(results[1] == one, "1 to any power is 1");
+    }
+
+    static juce::MemoryBlock toBigEndian(const juce::BigInteger& value, size_t numBytes)
+    {
+        juce::MemoryBlock block(numBytes, true);
+        auto* bytes = static_cast<juce::uint8*>(block.getData());
+        for( size_t i = 0; i < numBytes; ++i )
+            bytes[numBytes - 1 - i] = static_cast<juce::uint8>(value.getBitRangeAsInt(static_cast<int>(i * 8), 8));
+
+        return block;
+    }
+};
+
+static FixedWidthKeyTests fixedWidthKeyTests;
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    KeyExportTests.cpp
+    Created: 18 Oct 2026 4:52:26am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "TestFixtures.h"
+
+/**
+ Checks that a key loaded from any of the four forms OpenSSL writes is exported as exactly
+ the text and DER OpenSSL wrote for every form the key holds.
+ */
+struct KeyExportTests : juce::UnitTest
+{
+    KeyExportTests() : juce::UnitTest("KeyExport", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        using DERFormat = PEMFormatKey::DERFormat;
+
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& pkcs1Keys = TestFixtures::getPKCS1Keys();
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            const KeyForm forms[] =
+            {
+                { DERFormat::pkcs8PrivateKey, keyPairs[i].privateKeyPEM },
+                { DERFormat::subjectPublicKeyInfo, keyPairs[i].publicKeyPEM },
+                { DERFormat::pkcs1PrivateKey, pkcs1Keys[i].privateKeyPEM },
+                { DERFormat::pkcs1PublicKey, pkcs1Keys[i].publicKeyPEM }
+            };
+
+            for( const auto& from : forms )
+            {
+                beginTest(juce::String(PEMFormatKey::getPEMLabel(from.format)) + " round trip, "
+                          + juce::String(keyPairs[i].numBits) + " bits");
+
+                juce::MemoryBlock der;
+                expect(getDER(from.pem, der));
+
+                PEMFormatKey fromPEM, fromDER;
+                fromPEM.loadFromPEMFormattedString(from.pem);
+                expect(fromDER.loadFromDER(der.getData(), der.getSize(), from.format));
+                expect(fromPEM.getMaxPlaintextSize() > 0 && fromDER.getMaxPlaintextSize() > 0);
+
+                for( auto* key : { &fromPEM, &fromDER } )
+                {
+                    for( const auto& to : forms )
+                    {
+                        //a public key can't be written as a private one
+                        if( isPrivate(to.format) && ! isPrivate(from.format) )
+                        {
+                            juce::MemoryBlock unwritten;
+                            expect(! key->exportToPEM(to.format, unwritten));
+                            expect(! key->exportToDER(to.format, unwritten));
+                            expect(key->exportToPEMString(to.format).isEmpty());
+                            continue;
+                        }
+
+                        expectExported(*key, to);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct KeyForm
+    {
+        PEMFormatKey::DERFormat format;
+        const char* pem;
+    };
+
+    static bool isPrivate(PEMFormatKey::DERFormat format)
+    {
+        return format == PEMFormatKey::DERFormat::pkcs8PrivateKey || format == PEMFormatKey::DERFormat::pkcs1PrivateKey;
+    }
+
+    ///decodes the body of the first block in 'pem'
+    static bool getDER(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+
+    void expectExported(const PEMFormatKey& key, const KeyForm& expected)
+    {
+        const juce::String label(PEMFormatKey::getPEMLabel(expected.format));
+        auto numChars = std::strlen(expected.pem);
+
+        juce::MemoryBlock pem;
+        expect(key.exportToPEM(expected.format, pem));
+        expect(pem.getSize() == numChars && std::memcmp(pem.getData(), expected.pem, numChars) == 0,
+               "the " + label + " PEM isn't the one OpenSSL wrote");
+        expect(key.exportToPEMString(expected.format) == juce::String(expected.pem),
+               "the " + label + " PEM string isn't the one OpenSSL wrote");
+
+        juce::MemoryBlock der, expectedDER;
+        expect(getDER(expected.pem, expectedDER));
+        expect(key.exportToDER(expected.format, der));
+        expect(der.getSize() == expectedDER.getSize()
+               && std::memcmp(der.getData(), expectedDER.getData(), der.getSize()) == 0,
+               "the " + label + " DER isn't the one OpenSSL wrote");
+    }
+};
+
+static KeyExportTests keyExportTests;
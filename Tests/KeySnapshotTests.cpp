@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    KeySnapshotTests.cpp
+    Created: 18 Oct 2026 7:31:16am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/KeySnapshot.h"
+#include "TestFixtures.h"
+
+/**
+ Writes the fixture keys to a snapshot, maps it and decrypts with the keys that come out of it,
+ then checks that a truncated snapshot and one with a damaged checksum are refused.
+ */
+struct KeySnapshotTests : juce::UnitTest
+{
+    KeySnapshotTests() : juce::UnitTest("KeySnapshot", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+        const juce::String message(BenchmarkFixtures::getMessage());
+
+        std::vector<PEMFormatKey> keys(keyPairs.size());
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+            keys[i].loadFromPEMFormattedString(keyPairs[i].privateKeyPEM);
+
+        juce::MemoryBlock snapshot;
+        juce::TemporaryFile tempFile(".rsasnapshot");
+        const auto& file = tempFile.getFile();
+
+        beginTest("write, map and load");
+        {
+            expect(KeySnapshot::write(keys, snapshot));
+            expect(KeySnapshot::writeToFile(keys, file));
+            expectEquals(file.getSize(), static_cast<juce::int64>(snapshot.getSize()));
+
+            for( auto verifyChecksum : { true, false } )
+            {
+                auto loaded = KeySnapshot::loadFile(file, verifyChecksum);
+                expectEquals(static_cast<int>(loaded.size()), static_cast<int>(keys.size()));
+
+                for( size_t i = 0; i < loaded.size() && i < keys.size(); ++i )
+                {
+                    expectEquals(static_cast<int>(loaded[i].getMaxPlaintextSize()), static_cast<int>(keys[i].getMaxPlaintextSize()));
+                    expectEquals(loaded[i].decryptBase64String(ciphertexts[i].encrypted), message);
+                }
+            }
+        }
+
+        beginTest("a truncated snapshot is refused");
+        {
+            for( auto numBytes : { snapshot.getSize() - 1, snapshot.getSize() / 2, static_cast<size_t>(16) } )
+            {
+                expect(file.replaceWithData(snapshot.getData(), numBytes));
+                expect(KeySnapshot::loadFile(file).empty());
+                expect(KeySnapshot::loadFile(file, false).empty());
+            }
+        }
+
+        beginTest("a damaged checksum is refused");
+        {
+            //the header is 64 bytes, and ends with the checksum
+            juce::MemoryBlock damaged(snapshot);
+            static_cast<juce::uint8*>(damaged.getData())[63] ^= 0x80;
+
+            expect(file.replaceWithData(damaged.getData(), damaged.getSize()));
+            expect(KeySnapshot::loadFile(file).empty());
+
+            //so is damage anywhere after the header, which the checksum covers
+            damaged = snapshot;
+            static_cast<juce::uint8*>(damaged.getData())[damaged.getSize() - 1] ^= 0x80;
+
+            expect(file.replaceWithData(damaged.getData(), damaged.getSize()));
+            expect(KeySnapshot::loadFile(file).empty());
+        }
+    }
+};
+
+static KeySnapshotTests keySnapshotTests;
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 3:40:12am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+/*
+ usage: ANS1ParserTests [--seed=N]
+
+ build it as a console application with the ANS1Parser, Benchmarks and Tests sources
+ and the juce_core and juce_cryptography modules.  returns non-zero if any test fails.
+ */
+int main(int argc, char* argv[])
+{
+    juce::ArgumentList args(argc, argv);
+
+    juce::int64 seed = 0;
+    if( args.containsOption("--seed") )
+        seed = args.getValueForOption("--seed").getLargeIntValue();
+
+    juce::UnitTestRunner runner;
+    runner.runTestsInCategory("ANS1Parser", seed);
+
+    int numFailures = 0;
+    for( int i = 0; i < runner.getNumResults(); ++i )
+        numFailures += runner.getResult(i)->failures;
+
+    if( numFailures > 0 )
+    {
+        std::cerr << numFailures << " test(s) failed" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    MultiLaneMontgomeryTests.cpp
+    Created: 18 Oct 2026 4:41:33am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/FixedWidthInteger.h"
+#include "../ANS1Parser/MultiLaneMontgomery.h"
+
+/**
+ Runs every MultiLaneMontgomery implementation the CPU supports, and checks each lane against
+ FixedWidthMontgomery::exponentiate() and juce::BigInteger::exponentModulo().
+ */
+struct MultiLaneMontgomeryTests : juce::UnitTest
+{
+    MultiLaneMontgomeryTests() : juce::UnitTest("MultiLaneMontgomery", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+
+        checkWidth<1024>(random);
+        checkWidth<2048>(random);
+        checkWidth<3072>(random);
+        checkWidth<4096>(random);
+    }
+
+    static juce::String getName(MultiLaneMontgomery::Implementation implementation)
+    {
+        switch( implementation )
+        {
+            case MultiLaneMontgomery::Implementation::scalar: return "scalar";
+            case MultiLaneMontgomery::Implementation::avx2: return "avx2";
+            case MultiLaneMontgomery::Implementation::avx512: return "avx512";
+            case MultiLaneMontgomery::Implementation::avx512ifma: return "avx512ifma";
+        }
+
+        return {};
+    }
+
+    template <int numBits>
+    void checkWidth(juce::Random& random)
+    {
+        using Integer = FixedWidthInteger<numBits>;
+        constexpr int numValues = MultiLaneMontgomery::maxNumLanes;
+
+        juce::BigInteger modulus;
+        random.fillBitsRandomly(modulus, 0, numBits);
+        modulus.setBit(numBits - 1);
+        modulus.setBit(0);
+
+        const MontgomeryModulus montgomeryModulus(modulus);
+        const FixedWidthMontgomery<numBits> fixedWidth(montgomeryModulus);
+
+        //a public exponent, and a private-sized one that takes the widest window
+        juce::BigInteger largeExponent;
+        random.fillBitsRandomly(largeExponent, 0, numBits);
+        largeExponent.setBit(numBits - 1);
+
+        for( const auto& exponent : { juce::BigInteger(65537), largeExponent } )
+        {
+            beginTest(juce::String(numBits) + " bits, " + juce::String(exponent.getHighestBit() + 1) + "-bit exponent");
+
+            const WindowedExponent windowed(exponent);
+            const auto& steps = windowed.getSteps();
+            const auto tableSize = windowed.getTableSize();
+
+            //the values, with a zero in the middle like the lanes a batch zeroes when their input is invalid
+            Integer values[numValues], expected[numValues];
+            for( int i = 0; i < numValues; ++i )
+            {
+                auto value = i == 3 ? juce::BigInteger() : random.nextLargeNumber(modulus);
+                values[i].fromBigInteger(value);
+
+                Integer base;
+                fixedWidth.toMontgomery(base, values[i]);
+                fixedWidth.exponentiate(expected[i], base, windowed);
+                fixedWidth.fromMontgomery(expected[i], expected[i]);
+
+                value.exponentModulo(exponent, modulus);
+                expect(expected[i].toBigInteger() == value, "FixedWidthMontgomery disagrees with BigInteger");
+            }
+
+            for( auto implementation : { MultiLaneMontgomery::Implementation::scalar,
+                                         MultiLaneMontgomery::Implementation::avx2,
+                                         MultiLaneMontgomery::Implementation::avx512,
+                                         MultiLaneMontgomery::Implementation::avx512ifma } )
+            {
+                //the implementations are in order, so the CPU supports every one up to the best
+                if( implementation > MultiLaneMontgomery::getBestImplementation() )
+                    break;
+
+                const auto numLanes = MultiLaneMontgomery::getNumLanes(implementation);
+                juce::HeapBlock<juce::uint8> scratch(MultiLaneMontgomery::getNumScratchBytes(Integer::numLimbs, tableSize, implementation));
+
+                //every batch size from none to all the lanes, so some batches leave lanes idle
+                for( int numInLanes = 0; numInLanes <= numLanes; ++numInLanes )
+                {
+                    Integer results[numValues];
+                    juce::uint32* lanes[numValues];
+                    for( int i = 0; i < numValues; ++i )
+                    {
+                        results[i] = values[i];
+                        lanes[i] = results[i].limbs;
+                    }
+
+                    MultiLaneMontgomery::exponentiate(lanes, numInLanes,
+                                                      fixedWidth.getModulus().limbs, fixedWidth.getRSquared().limbs,
+                                                      fixedWidth.getInverse(), Integer::numLimbs,
+                                                      steps.data(), steps.size(), tableSize, scratch, implementation);
+
+                    for( int i = 0; i < numValues; ++i )
+                    {
+                        //the lanes past the batch are left alone
+                        const auto& shouldBe = i < numInLanes ? expected[i] : values[i];
+                        expect(std::equal(results[i].limbs, results[i].limbs + Integer::numLimbs, shouldBe.limbs),
+                               getName(implementation) + " got lane " + juce::String(i) + " of " + juce::String(numInLanes) + " wrong");
+                    }
+                }
+            }
+        }
+    }
+};
+
+static MultiLaneMontgomeryTests multiLaneMontgomeryTests;
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    PEMBundleLoaderTests.cpp
+    Created: 18 Oct 2026 4:16:52am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/PEMBundleLoader.h"
+#include "TestFixtures.h"
+
+/**
+ Checks that broken blocks in a bundle are skipped without taking the blocks around them,
+ that malformed keys are turned away without asserting, and that a pool the caller keeps
+ loads the same keys as loading inline, bundle after bundle.
+ */
+struct PEMBundleLoaderTests : juce::UnitTest
+{
+    PEMBundleLoaderTests() : juce::UnitTest("PEMBundleLoader", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const juce::String publicKey1(keyPairs[0].publicKeyPEM), publicKey2(keyPairs[1].publicKeyPEM);
+        const juce::String privateKey1(keyPairs[0].privateKeyPEM);
+
+        beginTest("the END label has to match the BEGIN label");
+        {
+            auto mismatched = publicKey1.replace("-----END PUBLIC KEY-----", "-----END PRIVATE KEY-----");
+            auto bundle = mismatched + publicKey2;
+
+            auto blocks = findBlocks(bundle);
+            expectEquals(static_cast<int>(blocks.size()), 1);
+            if( blocks.size() == 1 )
+                expect(blocks[0].begin == static_cast<size_t>(mismatched.length()), "the mismatched block was found");
+        }
+
+        beginTest("a block without an END line doesn't swallow the next one");
+        {
+            auto truncated = publicKey1.upToFirstOccurrenceOf("-----END", false, false);
+            auto bundle = "some text before the keys\n" + truncated + publicKey2 + privateKey1;
+
+            auto blocks = findBlocks(bundle);
+            expectEquals(static_cast<int>(blocks.size()), 2);
+            if( blocks.size() == 2 )
+            {
+                expect(blocks[0].hasLabel(bundle.toRawUTF8(), "PUBLIC KEY"));
+                expect(blocks[1].hasLabel(bundle.toRawUTF8(), "PRIVATE KEY"));
+                expect(blocks[1].end == static_cast<size_t>(bundle.length()) - 1, "the last block doesn't end at its END line");
+            }
+
+            //nor does one whose BEGIN line never closes
+            bundle = "-----BEGIN PUBLIC KEY\n" + publicKey2;
+            expectEquals(static_cast<int>(findBlocks(bundle).size()), 1);
+        }
+
+        beginTest("malformed keys are skipped without asserting");
+        {
+            /*
+             a SubjectPublicKeyInfo with an extra field, a PKCS#8 key missing its OCTET STRING,
+             an RSAPrivateKey that isn't version 0, and a private key whose coefficient is off by one,
+             which passes the structural checks and fails the full ones.
+             */
+            const juce::uint8 extraField[] = { 0x30, 0x09, 0x30, 0x00, 0x03, 0x01, 0x00, 0x02, 0x01, 0x00, 0x05 };
+            const juce::uint8 noOctetString[] = { 0x30, 0x05, 0x02, 0x01, 0x00, 0x30, 0x00 };
+            const juce::uint8 version1[] = { 0x30, 0x03, 0x02, 0x01, 0x01 };
+
+            PEMFormatKey privateKey;
+            privateKey.loadFromPEMFormattedString(privateKey1);
+            juce::MemoryBlock wrongCoefficient;
+            expect(privateKey.exportToDER(PEMFormatKey::DERFormat::pkcs1PrivateKey, wrongCoefficient));
+            static_cast<juce::uint8*>(wrongCoefficient.getData())[wrongCoefficient.getSize() - 1] ^= 1;
+
+            auto bundle = PEMHelpers::convertDERToPEMString(extraField, sizeof(extraField), "PUBLIC KEY")
+                        + publicKey1
+                        + PEMHelpers::convertDERToPEMString(noOctetString, sizeof(noOctetString), "PRIVATE KEY")
+                        + PEMHelpers::convertDERToPEMString(version1, sizeof(version1), "RSA PRIVATE KEY")
+                        + PEMHelpers::convertDERToPEMString(wrongCoefficient.getData(), wrongCoefficient.getSize(), "RSA PRIVATE KEY")
+                        + publicKey2;
+
+            expectEquals(static_cast<int>(findBlocks(bundle).size()), 6);
+
+            PEMBundleLoader::Options options;
+            options.validation = PEMFormatKey::Validation::full;
+            auto keys = PEMBundleLoader::load(bundle.toRawUTF8(), bundle.getNumBytesAsUTF8(), options);
+
+            expectEquals(static_cast<int>(keys.size()), 2);
+            if( keys.size() == 2 )
+            {
+                expectEquals(keys[0].exportToPEMString(PEMFormatKey::DERFormat::subjectPublicKeyInfo), publicKey1);
+                expectEquals(keys[1].exportToPEMString(PEMFormatKey::DERFormat::subjectPublicKeyInfo), publicKey2);
+            }
+        }
+
+        beginTest("loading on the caller's pool");
+        {
+            //every public key a few times over, in chunks small enough that every worker gets some
+            juce::String bundle;
+            for( int n = 0; n < 8; ++n )
+                for( const auto& keyPair : keyPairs )
+                    bundle += keyPair.publicKeyPEM;
+
+            PEMBundleLoader::Options onCallingThread;
+            onCallingThread.chunkSize = 2;
+            auto expected = PEMBundleLoader::load(bundle.toRawUTF8(), bundle.getNumBytesAsUTF8(), onCallingThread);
+            expectEquals(static_cast<int>(expected.size()), static_cast<int>(8 * keyPairs.size()));
+
+            WorkStealingThreadPool pool(4);
+            auto options = onCallingThread;
+            options.pool = &pool;
+
+            //the same pool, for one bundle after another
+            for( int n = 0; n < 3; ++n )
+            {
+                auto keys = PEMBundleLoader::load(bundle.toRawUTF8(), bundle.getNumBytesAsUTF8(), options);
+                expectEquals(static_cast<int>(keys.size()), static_cast<int>(expected.size()));
+
+                for( size_t i = 0; i < keys.size() && i < expected.size(); ++i )
+                    expectEquals(keys[i].exportToPEMString(PEMFormatKey::DERFormat::subjectPublicKeyInfo),
+                                 expected[i].exportToPEMString(PEMFormatKey::DERFormat::subjectPublicKeyInfo));
+            }
+        }
+    }
+
+    static std::vector<PEMHelpers::PEMBlock> findBlocks(const juce::String& bundle)
+    {
+        return PEMBundleLoader::findBlocks(bundle.toRawUTF8(), bundle.getNumBytesAsUTF8());
+    }
+};
+
+static PEMBundleLoaderTests pemBundleLoaderTests;
@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+    PEMDecryptionServiceTests.cpp
+    Created: 18 Oct 2026 8:51:17am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <thread>
+
+#include "../ANS1Parser/PEMDecryptionService.h"
+#include "TestFixtures.h"
+
+/**
+ Submits the fixture ciphertexts to a PEMDecryptionService from many threads and checks what comes
+ back, including for ciphertexts that can't be decrypted, then checks when batches are taken with
+ Options::maxWaitMicroseconds set, and that the destructor completes every request that is still waiting.
+ */
+struct PEMDecryptionServiceTests : juce::UnitTest
+{
+    PEMDecryptionServiceTests() : juce::UnitTest("PEMDecryptionService", "ANS1Parser")
+    {
+
+    }
+
+    static constexpr int numRequestsPerThread = 24;
+    ///long enough that nothing in the tests should wait for it
+    static constexpr int longWaitMicroseconds = 20 * 1000 * 1000;
+
+    void runTest() override
+    {
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+        const auto numThreads = juce::jlimit(4, 16, static_cast<int>(std::thread::hardware_concurrency()));
+
+        std::vector<PEMFormatKey> keys(keyPairs.size());
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+            keys[i].loadFromPEMFormattedString(keyPairs[i].privateKeyPEM);
+
+        //not base64, so it can't be decrypted
+        const juce::String garbage("!!!!");
+
+        //base64 of a ciphertext as wide as the first key's modulus with every bit set, so not below it
+        juce::MemoryBlock allOnes(keys[0].getMaxPlaintextSize());
+        allOnes.fillWith(0xff);
+        const auto outOfRange = juce::Base64::toBase64(allOnes.getData(), allOnes.getSize());
+
+        beginTest("a ciphertext that isn't below the modulus gives what decryptBase64String() gives");
+        {
+            PEMDecryptionService service;
+            auto future = service.submit(keys[0], outOfRange);
+
+            expect(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+            if( future.wait_for(std::chrono::seconds(0)) == std::future_status::ready )
+                expectEquals(future.get(), keys[0].decryptBase64String(outOfRange));
+
+            expect(keys[0].decryptBase64String(outOfRange).isEmpty());
+        }
+
+        beginTest(juce::String(numThreads) + " threads submitting to every key");
+        {
+            PEMDecryptionService::Options options;
+            options.numWorkers = 4;
+            options.maxBatchSize = 8;
+            PEMDecryptionService service(options);
+
+            std::vector<std::vector<std::future<juce::String>>> futures(static_cast<size_t>(numThreads));
+            std::vector<std::thread> threads;
+            std::atomic<bool> go { false };
+
+            for( size_t t = 0; t < futures.size(); ++t )
+            {
+                threads.emplace_back([&, t]
+                {
+                    while( ! go.load() )
+                        std::this_thread::yield();
+
+                    //each thread starts on a different key, and every eighth request is garbage
+                    for( int n = 0; n < numRequestsPerThread; ++n )
+                    {
+                        auto i = (t + static_cast<size_t>(n)) % keys.size();
+                        futures[t].push_back(service.submit(keys[i], n % 8 == 7 ? garbage : juce::String(ciphertexts[i].encrypted)));
+                    }
+                });
+            }
+
+            go = true;
+            for( auto& thread : threads )
+                thread.join();
+
+            int numWrong = 0;
+            for( size_t t = 0; t < futures.size(); ++t )
+            {
+                for( size_t n = 0; n < futures[t].size(); ++n )
+                {
+                    auto expected = n % 8 == 7 ? juce::String() : message;
+                    if( futures[t][n].get() != expected )
+                        ++numWrong;
+                }
+            }
+
+            expectEquals(numWrong, 0);
+
+            auto statistics = service.getStatistics();
+            expectEquals(statistics.numRequests, static_cast<juce::int64>(numThreads * numRequestsPerThread));
+            expect(statistics.largestBatch <= options.maxBatchSize);
+        }
+
+        beginTest("a full batch doesn't wait for maxWaitMicroseconds");
+        {
+            PEMDecryptionService::Options options;
+            options.numWorkers = 1;
+            options.maxBatchSize = 4;
+            options.maxWaitMicroseconds = longWaitMicroseconds;
+            PEMDecryptionService service(options);
+
+            std::vector<std::future<juce::String>> futures;
+            for( size_t n = 0; n < options.maxBatchSize; ++n )
+                futures.push_back(service.submit(keys[1], ciphertexts[1].encrypted));
+
+            for( auto& future : futures )
+            {
+                expect(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+                if( future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready )
+                    expectEquals(future.get(), message);
+            }
+
+            auto statistics = service.getStatistics();
+            expectEquals(statistics.numBatches, static_cast<juce::int64>(1));
+            expectEquals(static_cast<int>(statistics.largestBatch), static_cast<int>(options.maxBatchSize));
+        }
+
+        beginTest("a request on its own is taken after maxWaitMicroseconds");
+        {
+            PEMDecryptionService::Options options;
+            options.numWorkers = 1;
+            options.maxWaitMicroseconds = 200 * 1000;
+            PEMDecryptionService service(options);
+
+            auto start = std::chrono::steady_clock::now();
+            auto future = service.submit(keys[0], ciphertexts[0].encrypted);
+
+            expect(future.wait_for(std::chrono::seconds(5)) == std::future_status::ready);
+            auto waited = std::chrono::steady_clock::now() - start;
+            expect(waited >= std::chrono::microseconds(options.maxWaitMicroseconds),
+                   juce::String(std::chrono::duration_cast<std::chrono::milliseconds>(waited).count()) + "ms");
+
+            if( future.wait_for(std::chrono::seconds(0)) == std::future_status::ready )
+                expectEquals(future.get(), message);
+        }
+
+        beginTest("callbacks");
+        {
+            PEMDecryptionService service;
+
+            std::atomic<int> numCalled { 0 }, numDecrypted { 0 }, numWrong { 0 };
+            juce::WaitableEvent allCalled;
+            const int numRequests = static_cast<int>(keys.size()) + 2;
+
+            auto submit = [&](const PEMFormatKey& key, const juce::String& base64, bool shouldDecrypt)
+            {
+                service.submit(key, base64, [&, shouldDecrypt](bool decrypted, const juce::String& plaintext)
+                {
+                    if( decrypted != shouldDecrypt || plaintext != (shouldDecrypt ? message : juce::String()) )
+                        ++numWrong;
+
+                    if( decrypted )
+                        ++numDecrypted;
+
+                    if( ++numCalled == numRequests )
+                        allCalled.signal();
+                });
+            };
+
+            for( size_t i = 0; i < keys.size(); ++i )
+                submit(keys[i], ciphertexts[i].encrypted, true);
+
+            submit(keys[0], garbage, false);
+            submit(keys[0], outOfRange, false);
+
+            expect(allCalled.wait(5000));
+            expectEquals(numCalled.load(), numRequests);
+            expectEquals(numDecrypted.load(), numRequests - 2);
+            expectEquals(numWrong.load(), 0);
+        }
+
+        beginTest("the destructor completes every request still waiting");
+        {
+            std::atomic<int> numCalled { 0 }, numWrong { 0 };
+            std::vector<std::future<juce::String>> futures;
+            const int numRequests = 10;
+
+            auto start = std::chrono::steady_clock::now();
+            {
+                //none of them would be taken for a long time
+                PEMDecryptionService::Options options;
+                options.numWorkers = 2;
+                options.maxBatchSize = 64;
+                options.maxWaitMicroseconds = longWaitMicroseconds;
+                PEMDecryptionService service(options);
+
+                for( int n = 0; n < numRequests; ++n )
+                {
+                    auto i = static_cast<size_t>(n) % keys.size();
+                    futures.push_back(service.submit(keys[i], ciphertexts[i].encrypted));
+                    service.submit(keys[i], ciphertexts[i].encrypted, [&](bool decrypted, const juce::String& plaintext)
+                    {
+                        if( ! decrypted || plaintext != message )
+                            ++numWrong;
+
+                        ++numCalled;
+                    });
+                }
+
+                expectEquals(service.getStatistics().numRequests, static_cast<juce::int64>(0));
+            }
+
+            expect(std::chrono::steady_clock::now() - start < std::chrono::microseconds(longWaitMicroseconds));
+            expectEquals(numCalled.load(), numRequests);
+            expectEquals(numWrong.load(), 0);
+
+            for( auto& future : futures )
+            {
+                expect(future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+                if( future.wait_for(std::chrono::seconds(0)) == std::future_status::ready )
+                    expectEquals(future.get(), message);
+            }
+        }
+    }
+};
+
+static PEMDecryptionServiceTests pemDecryptionServiceTests;
@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    PEMInstrumentationTests.cpp
+    Created: 18 Oct 2026 9:47:05am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include <atomic>
+
+#include "../ANS1Parser/ASN1Decoder.h"
+#include "../ANS1Parser/DERStreamParser.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "../ANS1Parser/PEMInstrumentation.h"
+#include "TestFixtures.h"
+
+/**
+ Loads keys, decrypts with them and decodes some DER, then checks the stage timings and counters
+ moved if PEM_INSTRUMENTATION is 1, or stayed at zero without calling the listener if it is 0.
+ */
+struct PEMInstrumentationTests : juce::UnitTest
+{
+    PEMInstrumentationTests() : juce::UnitTest("PEMInstrumentation", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        using Stage = PEMInstrumentation::Stage;
+        using Counter = PEMInstrumentation::Counter;
+
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+        const auto numKeys = static_cast<juce::int64>(keyPairs.size());
+        const auto enabled = PEMInstrumentation::isEnabled();
+
+        //SEQUENCE { INTEGER 5, SEQUENCE { BOOLEAN TRUE } }: four nodes, three deep
+        const juce::uint8 der[] = { 0x30, 0x08, 0x02, 0x01, 0x05, 0x30, 0x03, 0x01, 0x01, 0xFF };
+
+        Recorder recorder;
+        PEMInstrumentation::setListener(&recorder);
+        PEMInstrumentation::reset();
+
+        std::vector<PEMFormatKey> keys(keyPairs.size());
+
+        beginTest("loading keys, and a key that doesn't load");
+        {
+            for( size_t i = 0; i < keyPairs.size(); ++i )
+                keys[i].loadFromPEMFormattedString(keyPairs[i].privateKeyPEM);
+
+            //not a key in any format, so it fails before loadFromDER() starts walking it
+            PEMFormatKey broken;
+            broken.setAssertOnMalformedInput(false);
+            expect(! broken.loadFromDER(der, sizeof(der)));
+
+            auto snapshot = PEMInstrumentation::getSnapshot();
+            expectEquals(snapshot.getCounter(Counter::keysLoaded), enabled ? numKeys : 0);
+            expectEquals(snapshot.getCounter(Counter::keyLoadFailures), static_cast<juce::int64>(enabled ? 1 : 0));
+            expectEquals(snapshot.getStage(Stage::unarmor).count, enabled ? numKeys : 0);
+            expectEquals(snapshot.getStage(Stage::loadDER).count, enabled ? numKeys : 0);
+            expect((snapshot.getStage(Stage::loadDER).totalMicroseconds > 0) == enabled);
+            expect(snapshot.getStage(Stage::loadDER).maxMicroseconds <= snapshot.getStage(Stage::loadDER).totalMicroseconds);
+
+            //keys are walked with a DERCursor, which the asn1 counters don't cover
+            expectEquals(snapshot.getCounter(Counter::asn1NodesDecoded), static_cast<juce::int64>(0));
+            expectEquals(snapshot.getCounter(Counter::asn1BytesScanned), static_cast<juce::int64>(0));
+        }
+
+        beginTest("decrypting, and a ciphertext that doesn't decrypt");
+        {
+            PEMInstrumentation::reset();
+
+            juce::MemoryBlock zero(keys[0].getMaxPlaintextSize(), true), result;
+            expect(! keys[0].decryptBytes(zero.getData(), zero.getSize(), result));
+
+            for( size_t i = 0; i < keys.size(); ++i )
+                expectEquals(keys[i].decryptBase64String(ciphertexts[i].encrypted), juce::String(BenchmarkFixtures::getMessage()));
+
+            auto snapshot = PEMInstrumentation::getSnapshot();
+            expectEquals(snapshot.getCounter(Counter::decryptions), enabled ? numKeys + 1 : 0);
+            expectEquals(snapshot.getCounter(Counter::decryptFailures), static_cast<juce::int64>(enabled ? 1 : 0));
+            expectEquals(snapshot.getStage(Stage::decryptBase64).count, enabled ? numKeys : 0);
+            expectEquals(snapshot.getStage(Stage::ciphertextBase64).count, enabled ? numKeys : 0);
+            expectEquals(snapshot.getStage(Stage::modexp).count, enabled ? numKeys + 1 : 0);
+            expectEquals(snapshot.getCounter(Counter::keysLoaded), static_cast<juce::int64>(0));
+        }
+
+        beginTest("ASN1Decoder and DERStreamParser");
+        {
+            PEMInstrumentation::reset();
+
+            juce::MemoryInputStream stream(der, sizeof(der), false);
+            expect(ASN1Decoder::decode(stream) != nullptr);
+
+            auto snapshot = PEMInstrumentation::getSnapshot();
+            expectEquals(snapshot.getStage(Stage::asn1Decode).count, static_cast<juce::int64>(enabled ? 1 : 0));
+            expectEquals(snapshot.getCounter(Counter::asn1NodesDecoded), static_cast<juce::int64>(enabled ? 4 : 0));
+            expectEquals(snapshot.getCounter(Counter::asn1BytesScanned), static_cast<juce::int64>(enabled ? sizeof(der) : 0));
+            expectEquals(snapshot.asn1MaxDepth, enabled ? 3 : 0);
+
+            juce::MemoryInputStream again(der, sizeof(der), false);
+            DERStreamParser::Listener enterEverything;
+            expect(DERStreamParser().parse(again, enterEverything));
+
+            snapshot = PEMInstrumentation::getSnapshot();
+            expectEquals(snapshot.getCounter(Counter::asn1NodesDecoded), static_cast<juce::int64>(enabled ? 8 : 0));
+            expectEquals(snapshot.getCounter(Counter::asn1BytesScanned), static_cast<juce::int64>(enabled ? 2 * sizeof(der) : 0));
+        }
+
+        beginTest("the listener");
+        {
+            PEMInstrumentation::setListener(nullptr);
+
+            expect((recorder.numStages.load() > 0) == enabled);
+            expect((recorder.numCounterChanges.load() > 0) == enabled);
+
+            //not called once it is removed
+            auto numStages = recorder.numStages.load();
+            PEMFormatKey key;
+            key.loadFromPEMFormattedString(keyPairs[0].publicKeyPEM);
+            expectEquals(recorder.numStages.load(), numStages);
+
+            PEMInstrumentation::reset();
+            auto snapshot = PEMInstrumentation::getSnapshot();
+            for( int i = 0; i < PEMInstrumentation::numStages; ++i )
+                expectEquals(snapshot.stages[i].count, static_cast<juce::int64>(0));
+            for( int i = 0; i < PEMInstrumentation::numCounters; ++i )
+                expectEquals(snapshot.counters[i], static_cast<juce::int64>(0));
+        }
+    }
+
+    struct Recorder : PEMInstrumentation::Listener
+    {
+        void stageFinished(PEMInstrumentation::Stage, double) override { ++numStages; }
+        void counterChanged(PEMInstrumentation::Counter, juce::int64) override { ++numCounterChanges; }
+
+        std::atomic<int> numStages { 0 }, numCounterChanges { 0 };
+    };
+};
+
+static PEMInstrumentationTests pemInstrumentationTests;
@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    PEMKeyringTests.cpp
+    Created: 18 Oct 2026 7:05:33am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/PEMInstrumentation.h"
+#include "../ANS1Parser/PEMKeyring.h"
+#include "TestFixtures.h"
+
+/**
+ Looks keys up in a PEMKeyring by both of their identifiers, and checks that the least recently
+ used keys are let go of at capacity and load again, and that a key which doesn't load is only tried once.
+ */
+struct PEMKeyringTests : juce::UnitTest
+{
+    PEMKeyringTests() : juce::UnitTest("PEMKeyring", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+        const juce::String message(BenchmarkFixtures::getMessage());
+
+        //worked out from the public keys, which the private keys are fingerprinted by
+        std::vector<KeyID> fingerprints, modulusIDs;
+        juce::String privateKeys, publicKeys;
+        for( const auto& keyPair : keyPairs )
+        {
+            PEMFormatKey publicKey;
+            publicKey.loadFromPEMFormattedString(keyPair.publicKeyPEM);
+
+            juce::MemoryBlock spki;
+            expect(publicKey.exportToDER(PEMFormatKey::DERFormat::subjectPublicKeyInfo, spki));
+
+            KeyID fingerprint, modulusID;
+            expect(PEMKeyring::computeKeyIDs(spki.getData(), spki.getSize(), false, fingerprint, modulusID));
+            expect(fingerprint == KeyID::fromSHA256(juce::SHA256(spki)));
+
+            fingerprints.push_back(fingerprint);
+            modulusIDs.push_back(modulusID);
+            privateKeys += keyPair.privateKeyPEM;
+            publicKeys += keyPair.publicKeyPEM;
+        }
+
+        auto decrypts = [&](const PEMKeyring::CachedKey::Ptr& cached, size_t i)
+        {
+            return cached != nullptr && cached->key.decryptBase64String(ciphertexts[i].encrypted) == message;
+        };
+
+        beginTest("keys are found by fingerprint and by modulus ID");
+        {
+            PEMKeyring keyring(keyPairs.size());
+            expectEquals(keyring.addPEMString(privateKeys), static_cast<int>(keyPairs.size()));
+            //the same keys, as far as their fingerprints go
+            expectEquals(keyring.addPEMString(publicKeys), 0);
+            expectEquals(keyring.getNumKeys(), static_cast<int>(keyPairs.size()));
+            expectEquals(keyring.getNumCachedKeys(), 0);
+
+            for( size_t i = 0; i < keyPairs.size(); ++i )
+            {
+                auto byFingerprint = keyring.findByFingerprint(fingerprints[i]);
+                expect(decrypts(byFingerprint, i));
+                expect(byFingerprint != nullptr && byFingerprint->key.isPrivateKey());
+                expect(byFingerprint != nullptr && byFingerprint->modulusID == modulusIDs[i]);
+
+                //already loaded, so it's the same key
+                expect(keyring.findByModulusID(modulusIDs[i]) == byFingerprint);
+            }
+
+            expectEquals(keyring.getNumCachedKeys(), static_cast<int>(keyPairs.size()));
+
+            KeyID unknown;
+            expect(keyring.findByFingerprint(unknown) == nullptr);
+            expect(keyring.findByModulusID(unknown) == nullptr);
+        }
+
+        beginTest("the least recently used key is let go of at capacity, and loads again");
+        {
+            PEMKeyring keyring(2);
+            expectEquals(keyring.addPEMString(privateKeys), static_cast<int>(keyPairs.size()));
+
+            auto key0 = keyring.findByFingerprint(fingerprints[0]);
+            auto key1 = keyring.findByFingerprint(fingerprints[1]);
+            expect(keyring.findByFingerprint(fingerprints[0]) == key0);
+
+            //key 1 is now the least recently used
+            auto key2 = keyring.findByFingerprint(fingerprints[2]);
+            expect(decrypts(key2, 2));
+            expectEquals(keyring.getNumCachedKeys(), 2);
+            expect(keyring.findByFingerprint(fingerprints[0]) == key0);
+            expect(keyring.findByFingerprint(fingerprints[2]) == key2);
+
+            //the keyring let go of it, but it still works for whoever holds it
+            expect(decrypts(key1, 1));
+
+            auto reloaded = keyring.findByModulusID(modulusIDs[1]);
+            expect(reloaded != nullptr && reloaded != key1);
+            expect(decrypts(reloaded, 1));
+            expectEquals(keyring.getNumCachedKeys(), 2);
+
+            //which let go of key 0
+            expect(keyring.findByFingerprint(fingerprints[2]) == key2);
+            auto key0Reloaded = keyring.findByFingerprint(fingerprints[0]);
+            expect(key0Reloaded != key0);
+            expect(decrypts(key0Reloaded, 0));
+        }
+
+        beginTest("a key that doesn't load is only tried once");
+        {
+            //passes the structural checks, and fails the full ones
+            juce::MemoryBlock wrongCoefficient;
+            {
+                PEMFormatKey key;
+                key.loadFromPEMFormattedString(keyPairs[0].privateKeyPEM);
+                expect(key.exportToDER(PEMFormatKey::DERFormat::pkcs8PrivateKey, wrongCoefficient));
+                static_cast<juce::uint8*>(wrongCoefficient.getData())[wrongCoefficient.getSize() - 1] ^= 1;
+            }
+
+            PEMKeyring keyring;
+            expect(keyring.addDER(wrongCoefficient.getData(), wrongCoefficient.getSize(), true));
+
+            auto numFailuresBefore = PEMInstrumentation::getSnapshot().getCounter(PEMInstrumentation::Counter::keyLoadFailures);
+
+            for( int i = 0; i < 3; ++i )
+            {
+                expect(keyring.findByFingerprint(fingerprints[0]) == nullptr);
+                expect(keyring.findByModulusID(modulusIDs[0]) == nullptr);
+            }
+
+            expectEquals(keyring.getNumCachedKeys(), 0);
+
+            if( PEMInstrumentation::isEnabled() )
+            {
+                auto numFailures = PEMInstrumentation::getSnapshot().getCounter(PEMInstrumentation::Counter::keyLoadFailures);
+                expectEquals(numFailures - numFailuresBefore, static_cast<juce::int64>(1));
+            }
+        }
+    }
+};
+
+static PEMKeyringTests pemKeyringTests;
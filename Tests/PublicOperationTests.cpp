@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    PublicOperationTests.cpp
+    Created: 18 Oct 2026 4:29:05am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/DEREncoder.h"
+#include "../ANS1Parser/SharedRSAKey.h"
+#include "TestFixtures.h"
+
+/**
+ Checks that the public operations of a private key use its public exponent, including
+ for a private key that was loaded without some of its CRT components.
+ */
+struct PublicOperationTests : juce::UnitTest
+{
+    PublicOperationTests() : juce::UnitTest("PublicOperation", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            const auto& keyPair = keyPairs[i];
+            beginTest("private and public keys agree, " + juce::String(keyPair.numBits) + " bits");
+
+            PEMFormatKey privateKey, publicKey;
+            privateKey.loadFromPEMFormattedString(keyPair.privateKeyPEM);
+            publicKey.loadFromPEMFormattedString(keyPair.publicKeyPEM);
+            expect(privateKey.isPrivateKey());
+            expect(! publicKey.isPrivateKey());
+
+            //the same key without its coefficient, which validation would have turned away
+            PEMFormatKey incompleteKey;
+            incompleteKey.setValidation(PEMFormatKey::Validation::none);
+            expect(loadWithoutCoefficient(privateKey, incompleteKey));
+            expect(incompleteKey.isPrivateKey(), "a private key missing a CRT component isn't a private key");
+            expect(! incompleteKey.hasCRTComponents());
+
+            juce::MemoryBlock expected;
+            expect(publicKey.encryptBytes(message.toRawUTF8(), message.getNumBytesAsUTF8(), expected));
+
+            //an OpenSSL signature, whose PKCS#1 v1.5 block is 01 FF .. FF 00 message
+            juce::MemoryBlock signature, block;
+            expect(Base64Decoder::decode(ciphertexts[i].signature, std::strlen(ciphertexts[i].signature), signature));
+            block.append("\x01", 1);
+            block.setSize(static_cast<size_t>(keyPair.numBits / 8) - 2 - message.getNumBytesAsUTF8(), false);
+            std::memset(static_cast<juce::uint8*>(block.getData()) + 1, 0xff, block.getSize() - 1);
+            block.append("\0", 1);
+            block.append(message.toRawUTF8(), message.getNumBytesAsUTF8());
+
+            PEMFormatKey::SignatureCheck check;
+            check.signature = signature.getData();
+            check.numSignatureBytes = signature.getSize();
+            check.expected = block.getData();
+            check.numExpectedBytes = block.getSize();
+
+            auto sharedPrivateKey = SharedRSAKey::create(privateKey);
+            auto sharedIncompleteKey = SharedRSAKey::create(incompleteKey);
+            expect(sharedPrivateKey != nullptr && sharedIncompleteKey != nullptr);
+            if( sharedPrivateKey == nullptr || sharedIncompleteKey == nullptr )
+                continue;
+
+            expect(sharedPrivateKey->isPrivateKey() && sharedIncompleteKey->isPrivateKey());
+
+            for( auto* key : { &publicKey, &privateKey, &incompleteKey } )
+            {
+                juce::MemoryBlock encrypted;
+                expect(key->encryptBytes(message.toRawUTF8(), message.getNumBytesAsUTF8(), encrypted));
+                expect(encrypted == expected, "encryptBytes() didn't use the public exponent");
+                expect(key->verifySignature(check), "verifySignature() didn't use the public exponent");
+            }
+
+            for( auto* key : { sharedPrivateKey.get(), sharedIncompleteKey.get() } )
+            {
+                juce::MemoryBlock encrypted;
+                expect(key->encryptBytes(message.toRawUTF8(), message.getNumBytesAsUTF8(), encrypted));
+                expect(encrypted == expected, "SharedRSAKey::encryptBytes() didn't use the public exponent");
+                expect(key->verifySignature(check), "SharedRSAKey::verifySignature() didn't use the public exponent");
+            }
+        }
+    }
+
+    ///re-encodes 'privateKey' with a zero coefficient and loads it into 'destination'
+    static bool loadWithoutCoefficient(const PEMFormatKey& privateKey, PEMFormatKey& destination)
+    {
+        juce::MemoryBlock der;
+        if( ! privateKey.exportToDER(PEMFormatKey::DERFormat::pkcs1PrivateKey, der) )
+            return false;
+
+        //RSAPrivateKey ::= SEQUENCE { version, n, e, d, p, q, d mod (p - 1), d mod (q - 1), q^-1 mod p }
+        DERCursor rsaPrivateKey(der.getData(), der.getSize());
+        juce::BigInteger fields[9];
+        for( int i = 0; i < 9; ++i )
+        {
+            auto field = rsaPrivateKey.getChild(i);
+            fields[i] = PEMHelpers::convertBigEndianBytesToBigInteger(field.getContent(), static_cast<size_t>(field.getContentLength()), true);
+        }
+
+        const juce::BigInteger zero;
+        const DEREncoder::RSAPrivateKeyParts parts { fields[1], fields[2], fields[3], fields[4], fields[5], fields[6], fields[7], zero };
+
+        juce::MemoryBlock incomplete(DEREncoder::getRSAPrivateKeySize(parts));
+        DEREncoder::writeRSAPrivateKey(static_cast<juce::uint8*>(incomplete.getData()), parts);
+
+        return destination.loadFromDER(incomplete.getData(), incomplete.getSize(), PEMFormatKey::DERFormat::pkcs1PrivateKey);
+    }
+};
+
+static PublicOperationTests publicOperationTests;
@@ -0,0 +1,168 @@
+/*
+  ==============================================================================
+
+    SharedRSAKeyTests.cpp
+    Created: 18 Oct 2026 5:03:48am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <thread>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/SharedRSAKey.h"
+#include "TestFixtures.h"
+
+/**
+ Uses one SharedRSAKey from many threads at once, and checks every result each of them gets.
+ */
+struct SharedRSAKeyTests : juce::UnitTest
+{
+    SharedRSAKeyTests() : juce::UnitTest("SharedRSAKey", "ANS1Parser")
+    {
+
+    }
+
+    static constexpr int numIterations = 8;
+    static constexpr size_t batchSize = 9;
+
+    void runTest() override
+    {
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+        const auto numThreads = juce::jlimit(4, 16, static_cast<int>(std::thread::hardware_concurrency()));
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            const auto& keyPair = keyPairs[i];
+            beginTest(juce::String(numThreads) + " threads sharing a key, " + juce::String(keyPair.numBits) + " bits");
+
+            PEMFormatKey privateKey, publicKey;
+            privateKey.loadFromPEMFormattedString(keyPair.privateKeyPEM);
+            publicKey.loadFromPEMFormattedString(keyPair.publicKeyPEM);
+
+            auto sharedKey = SharedRSAKey::create(privateKey);
+            expect(sharedKey != nullptr);
+            if( sharedKey == nullptr )
+                continue;
+
+            //every thread should get these, worked out here on one thread
+            Inputs inputs;
+            inputs.message = message;
+            inputs.encryptedBase64 = ciphertexts[i].encrypted;
+            expect(Base64Decoder::decode(ciphertexts[i].encrypted, std::strlen(ciphertexts[i].encrypted), inputs.encrypted));
+            expect(Base64Decoder::decode(ciphertexts[i].signature, std::strlen(ciphertexts[i].signature), inputs.signature));
+            expect(publicKey.encryptBytes(message.toRawUTF8(), message.getNumBytesAsUTF8(), inputs.expectedEncryption));
+            expect(publicKey.decryptBytes(inputs.signature.getData(), inputs.signature.getSize(), inputs.signedBlock));
+            expectEquals(PEMFormatKey::getMessageString(inputs.signedBlock.getData(), inputs.signedBlock.getSize()), message);
+
+            std::vector<Results> results(static_cast<size_t>(numThreads));
+            std::vector<std::thread> threads;
+            std::atomic<bool> go { false };
+
+            for( auto& threadResults : results )
+            {
+                //each thread has its own Ptr, and they all point at the same key
+                threads.emplace_back([key = sharedKey, &inputs, &threadResults, &go]
+                {
+                    while( ! go.load() )
+                        std::this_thread::yield();
+
+                    for( int n = 0; n < numIterations; ++n )
+                        run(*key, inputs, n % 2 == 0, threadResults);
+                });
+            }
+
+            go = true;
+            for( auto& thread : threads )
+                thread.join();
+
+            for( const auto& threadResults : results )
+            {
+                expectEquals(threadResults.numChecked, numIterations * Results::numChecksPerIteration);
+                expectEquals(threadResults.numFailed, 0);
+            }
+        }
+    }
+
+private:
+    struct Inputs
+    {
+        juce::String message;
+        const char* encryptedBase64 = nullptr;
+        juce::MemoryBlock encrypted, signature;
+        ///what encryptBytes() gives for the message, and what the public exponent gives for the signature
+        juce::MemoryBlock expectedEncryption, signedBlock;
+    };
+
+    struct Results
+    {
+        static constexpr int numChecksPerIteration = 4 + static_cast<int>(batchSize);
+
+        int numChecked = 0;
+        int numFailed = 0;
+
+        void check(bool passed) noexcept
+        {
+            ++numChecked;
+            if( ! passed )
+                ++numFailed;
+        }
+    };
+
+    ///one of every call, on the calling thread.  the UnitTest's expect() isn't for other threads, so the results are counted
+    static void run(const SharedRSAKey& key, const Inputs& inputs, bool ownScratch, Results& results)
+    {
+        PEMFormatKey::DecryptScratch scratch;
+        auto* scratchToUse = ownScratch ? &scratch : nullptr;
+
+        auto maxPlaintextBytes = key.getMaxPlaintextSize();
+        juce::HeapBlock<juce::uint8> plaintext(maxPlaintextBytes);
+        size_t numPlaintextBytes = 0;
+
+        auto isMessage = [&inputs](const void* data, size_t numBytes)
+        {
+            return PEMFormatKey::getMessageString(data, numBytes) == inputs.message;
+        };
+
+        results.check(key.decryptBase64(inputs.encryptedBase64, std::strlen(inputs.encryptedBase64),
+                                        plaintext, maxPlaintextBytes, numPlaintextBytes, scratchToUse)
+                      && isMessage(plaintext, numPlaintextBytes));
+
+        results.check(key.decrypt(inputs.encrypted.getData(), inputs.encrypted.getSize(),
+                                  plaintext, maxPlaintextBytes, numPlaintextBytes, scratchToUse)
+                      && isMessage(plaintext, numPlaintextBytes));
+
+        juce::HeapBlock<juce::uint8> batchPlaintexts(maxPlaintextBytes * batchSize);
+        SharedRSAKey::Decryption decryptions[batchSize];
+        for( size_t i = 0; i < batchSize; ++i )
+        {
+            decryptions[i].ciphertext = inputs.encrypted.getData();
+            decryptions[i].numCiphertextBytes = inputs.encrypted.getSize();
+            decryptions[i].plaintext = batchPlaintexts + i * maxPlaintextBytes;
+            decryptions[i].maxPlaintextBytes = maxPlaintextBytes;
+        }
+
+        key.decryptBatch(decryptions, batchSize, scratchToUse);
+        for( const auto& decryption : decryptions )
+            results.check(decryption.decrypted && isMessage(decryption.plaintext, decryption.numPlaintextBytes));
+
+        juce::MemoryBlock encrypted;
+        results.check(key.encryptBytes(inputs.message.toRawUTF8(), inputs.message.getNumBytesAsUTF8(), encrypted)
+                      && encrypted == inputs.expectedEncryption);
+
+        SharedRSAKey::SignatureCheck check;
+        check.signature = inputs.signature.getData();
+        check.numSignatureBytes = inputs.signature.getSize();
+        check.expected = inputs.signedBlock.getData();
+        check.numExpectedBytes = inputs.signedBlock.getSize();
+        results.check(key.verifySignature(check));
+    }
+};
+
+static SharedRSAKeyTests sharedRSAKeyTests;
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    TestFixtures.h
+    Created: 18 Oct 2026 3:40:12am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "../Benchmarks/BenchmarkFixtures.h"
+
+/**
+ Inputs for the tests that were made by OpenSSL rather than by this library, so the tests
+ check against what other implementations produce.
+
+ The keys are BenchmarkFixtures::getKeyPairs().  The ciphertexts were made with:
+ @code
+     printf 'this is a test message' > message
+     openssl pkeyutl -sign -inkey private.pem -in message | base64
+     openssl pkeyutl -encrypt -pubin -inkey public.pem -in message | base64
+ @endcode
+ and the PKCS#1 forms of the keys with:
+ @code
+     openssl rsa -in private.pem -traditional
+     openssl rsa -pubin -in public.pem -RSAPublicKey_out
+ @endcode
+ and the certificate for a key that isn't RSA with:
+ @code
+     openssl req -x509 -newkey ec -pkeyopt ec_paramgen_curve:P-256 -nodes -subj "/O=ANS1Parser Tests/CN=Shared Subject" -set_serial 0x77 -days 36500 -sha256
+ @endcode
+ */
+struct TestFixtures
+{
+    struct PaddedCiphertexts
+    {
+        int numBits;
+        ///BenchmarkFixtures::getMessage() signed by the private key, with PKCS#1 v1.5 block type 1 padding
+        const char* signature;
+        ///BenchmarkFixtures::getMessage() encrypted with the public key, with PKCS#1 v1.5 block type 2 padding
+        const char* encrypted;
+    };
+
+    ///one for each of BenchmarkFixtures::getKeyPairs(), in the same order
+    static const std::vector<PaddedCiphertexts>& getPaddedCiphertexts();
+
+    struct PKCS1Keys
+    {
+        int numBits;
+        ///the private key as an RSAPrivateKey, in an "RSA PRIVATE KEY" block
+        const char* privateKeyPEM;
+        ///the public key as an RSAPublicKey, in an "RSA PUBLIC KEY" block
+        const char* publicKeyPEM;
+    };
+
+    ///the same keys as BenchmarkFixtures::getKeyPairs(), in the same order
+    static const std::vector<PKCS1Keys>& getPKCS1Keys();
+
+    struct Certificate
+    {
+        ///a "CERTIFICATE" block
+        const char* pem;
+        ///1, which has no [0] version field, or 3
+        int version;
+        ///the content of the serialNumber INTEGER, in hex, leading zero included
+        const char* serialNumberHex;
+        ///the DER of the subject Name, in hex
+        const char* subjectHex;
+        ///its key's index in BenchmarkFixtures::getKeyPairs(), or -1 for a key that isn't RSA
+        int keyPairIndex;
+    };
+
+    /**
+     The certificates of BenchmarkFixtures::getKeyPairs(), in the same order, and then a v3 certificate
+     for a P-256 key, which has the same subject as the 2048-bit key's v1 one.  All of them are self-signed.
+     */
+    static const std::vector<Certificate>& getCertificates();
+};
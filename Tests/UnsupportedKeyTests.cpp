@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    UnsupportedKeyTests.cpp
+    Created: 18 Oct 2026 4:44:10am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/PEMFormatKey.h"
+
+/**
+ Checks that keys for other algorithms, which share the PKCS #8 and SubjectPublicKeyInfo
+ structures with RSA keys, are turned away without asserting, even by a key that asserts
+ on malformed input.
+ */
+struct UnsupportedKeyTests : juce::UnitTest
+{
+    UnsupportedKeyTests() : juce::UnitTest("UnsupportedKey", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        //made with: openssl genpkey -algorithm EC -pkeyopt ec_paramgen_curve:P-256, and -algorithm ed25519
+        struct UnsupportedKey
+        {
+            const char* name;
+            const char* privateKeyBase64;
+            const char* publicKeyBase64;
+        };
+
+        const UnsupportedKey keys[] =
+        {
+            {
+                "P-256",
+                "MIGHAgEAMBMGByqGSM49AgEGCCqGSM49AwEHBG0wawIBAQQggvirFwvJcq0NO96k"
+                "Ady//QK5QbCx5JGzporCPh0RduKhRANCAATJVXzZIi0WMet6DD6PU8UhBPaWTU1S"
+                "RalJ7yCs82ULKg892lrydPdx376tUUNOq/uduzZFPkpbTT2yGa20NDhl",
+                "MFkwEwYHKoZIzj0CAQYIKoZIzj0DAQcDQgAEyVV82SItFjHregw+j1PFIQT2lk1N"
+                "UkWpSe8grPNlCyoPPdpa8nT3cd++rVFDTqv7nbs2RT5KW009shmttDQ4ZQ=="
+            },
+            {
+                //its AlgorithmIdentifier has no parameters, so it has one child rather than an RSA key's two
+                "Ed25519",
+                "MC4CAQAwBQYDK2VwBCIEIAQ8j1xL2ngm2mTfiLps6IemsCA6uiBMD8HhNJXIuhOL",
+                "MCowBQYDK2VwAyEAevFIxx2NGqLz5SDiM/kiXmKubtaMVYs1gy+qQq4U+N4="
+            },
+        };
+
+        for( const auto& key : keys )
+        {
+            beginTest(juce::String(key.name) + " keys aren't loaded");
+
+            juce::MemoryBlock privateKeyDER, publicKeyDER;
+            expect(Base64Decoder::decode(key.privateKeyBase64, std::strlen(key.privateKeyBase64), privateKeyDER));
+            expect(Base64Decoder::decode(key.publicKeyBase64, std::strlen(key.publicKeyBase64), publicKeyDER));
+
+            PEMFormatKey rsaKey;
+            expect(rsaKey.getAssertOnMalformedInput());
+
+            expect(! rsaKey.loadFromDER(privateKeyDER.getData(), privateKeyDER.getSize(), PEMFormatKey::DERFormat::pkcs8PrivateKey));
+            expect(! rsaKey.loadFromDER(publicKeyDER.getData(), publicKeyDER.getSize(), PEMFormatKey::DERFormat::subjectPublicKeyInfo));
+            expect(! rsaKey.loadFromDER(privateKeyDER.getData(), privateKeyDER.getSize()));
+            expect(! rsaKey.loadFromDER(publicKeyDER.getData(), publicKeyDER.getSize()));
+            expectEquals(static_cast<int>(rsaKey.getMaxPlaintextSize()), 0);
+        }
+    }
+};
+
+static UnsupportedKeyTests unsupportedKeyTests;
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    ValidationCacheTests.cpp
+    Created: 18 Oct 2026 6:20:41am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/PEMFormatKey.h"
+#include "TestFixtures.h"
+
+/**
+ Loads the same private keys more than once, so the second load of each gets the result of the
+ full checks from the cache, and checks that a key which failed them is still turned away.
+ */
+struct ValidationCacheTests : juce::UnitTest
+{
+    ValidationCacheTests() : juce::UnitTest("ValidationCache", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const juce::String message(BenchmarkFixtures::getMessage());
+        const auto& ciphertexts = TestFixtures::getPaddedCiphertexts();
+
+        PEMFormatKey::clearValidationCache();
+
+        for( size_t i = 0; i < keyPairs.size(); ++i )
+        {
+            beginTest("a " + juce::String(keyPairs[i].numBits) + "-bit key that passed loads again");
+
+            for( int n = 0; n < 2; ++n )
+            {
+                PEMFormatKey key;
+                expect(key.getValidation() == PEMFormatKey::Validation::full);
+                key.loadFromPEMFormattedString(keyPairs[i].privateKeyPEM);
+
+                expect(key.isPrivateKey());
+                expectEquals(key.decryptBase64String(ciphertexts[i].encrypted), message);
+            }
+        }
+
+        beginTest("a key that failed is still turned away");
+        {
+            //passes the structural checks, and fails the full ones
+            juce::MemoryBlock wrongCoefficient;
+            {
+                PEMFormatKey key;
+                key.loadFromPEMFormattedString(keyPairs[0].privateKeyPEM);
+                expect(key.exportToDER(PEMFormatKey::DERFormat::pkcs1PrivateKey, wrongCoefficient));
+                static_cast<juce::uint8*>(wrongCoefficient.getData())[wrongCoefficient.getSize() - 1] ^= 1;
+            }
+
+            auto load = [&wrongCoefficient](PEMFormatKey::Validation validation)
+            {
+                PEMFormatKey key;
+                key.setAssertOnMalformedInput(false);
+                key.setValidation(validation);
+                return key.loadFromDER(wrongCoefficient.getData(), wrongCoefficient.getSize(), PEMFormatKey::DERFormat::pkcs1PrivateKey);
+            };
+
+            //the first time is checked, the second comes from the cache
+            expect(! load(PEMFormatKey::Validation::full));
+            expect(! load(PEMFormatKey::Validation::full));
+
+            //the cache is only asked for full checks
+            expect(load(PEMFormatKey::Validation::structural));
+
+            PEMFormatKey::clearValidationCache();
+            expect(! load(PEMFormatKey::Validation::full));
+        }
+
+        beginTest("the good key still passes after the bad one was cached");
+        {
+            PEMFormatKey key;
+            key.loadFromPEMFormattedString(keyPairs[0].privateKeyPEM);
+            expect(key.isPrivateKey());
+            expectEquals(key.decryptBase64String(ciphertexts[0].encrypted), message);
+        }
+    }
+};
+
+static ValidationCacheTests validationCacheTests;
@@ -0,0 +1,204 @@
+/*
+  ==============================================================================
+
+    X509CertificateIndexTests.cpp
+    Created: 18 Oct 2026 8:24:52am
+    Author:  Charles Schiermeyer
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../ANS1Parser/Base64Decoder.h"
+#include "../ANS1Parser/PEMHelpers.h"
+#include "../ANS1Parser/X509CertificateIndex.h"
+#include "TestFixtures.h"
+
+/**
+ Indexes a bundle of v1 and v3 certificates, finds them by subject and by serial number, and checks
+ that their keys are the ones they were made for, and that a key which isn't RSA stays unloaded.
+ */
+struct X509CertificateIndexTests : juce::UnitTest
+{
+    X509CertificateIndexTests() : juce::UnitTest("X509CertificateIndex", "ANS1Parser")
+    {
+
+    }
+
+    void runTest() override
+    {
+        const auto& keyPairs = BenchmarkFixtures::getKeyPairs();
+        const auto& certificates = TestFixtures::getCertificates();
+        const auto numCertificates = static_cast<int>(certificates.size());
+
+        juce::String bundle;
+        juce::MemoryBlock derBundle;
+        for( const auto& certificate : certificates )
+        {
+            bundle += certificate.pem;
+
+            juce::MemoryBlock der;
+            expect(decodePEM(certificate.pem, der));
+            derBundle.append(der.getData(), der.getSize());
+        }
+
+        X509CertificateIndex index;
+
+        beginTest("a PEM bundle and a run of DER certificates are indexed the same");
+        {
+            expectEquals(index.addPEMString(bundle), numCertificates);
+            expectEquals(index.getNumCertificates(), numCertificates);
+
+            X509CertificateIndex derIndex;
+            expectEquals(derIndex.addDER(derBundle.getData(), derBundle.getSize()), numCertificates);
+
+            for( int i = 0; i < numCertificates; ++i )
+            {
+                X509CertificateIndex::Certificate fromPEM, fromDER;
+                expect(index.getCertificate(i, fromPEM) && derIndex.getCertificate(i, fromDER));
+                expect(fromPEM.subjectHash == fromDER.subjectHash);
+                expectEquals(static_cast<int>(fromPEM.numBytes), static_cast<int>(fromDER.numBytes));
+                expect(std::memcmp(fromPEM.getBytes(fromPEM.offset), fromDER.getBytes(fromDER.offset), fromPEM.numBytes) == 0);
+            }
+
+            X509CertificateIndex::Certificate none;
+            expect(! index.getCertificate(-1, none));
+            expect(! index.getCertificate(numCertificates, none));
+        }
+
+        beginTest("the fields of v1 and v3 certificates");
+        {
+            for( int i = 0; i < numCertificates; ++i )
+            {
+                const auto& expected = certificates[static_cast<size_t>(i)];
+                X509CertificateIndex::Certificate certificate;
+                expect(index.getCertificate(i, certificate));
+
+                expectEquals(toHex(certificate.getBytes(certificate.serialOffset), certificate.numSerialBytes),
+                             juce::String(expected.serialNumberHex), "version " + juce::String(expected.version));
+                expectEquals(toHex(certificate.getBytes(certificate.subjectOffset), certificate.numSubjectBytes),
+                             juce::String(expected.subjectHex), "version " + juce::String(expected.version));
+                expect(certificate.subjectHash == X509CertificateIndex::hashName(certificate.getBytes(certificate.subjectOffset),
+                                                                                 certificate.numSubjectBytes));
+            }
+        }
+
+        beginTest("certificates are found by the DER of their subject Name");
+        {
+            for( const auto& certificate : certificates )
+            {
+                juce::MemoryBlock subject;
+                subject.loadFromHexString(certificate.subjectHex);
+
+                std::vector<int> expected;
+                for( int i = 0; i < numCertificates; ++i )
+                    if( juce::String(certificates[static_cast<size_t>(i)].subjectHex) == certificate.subjectHex )
+                        expected.push_back(i);
+
+                expect(index.findBySubject(subject.getData(), subject.getSize()) == expected);
+                expect(index.findBySubject(X509CertificateIndex::hashName(subject.getData(), subject.getSize())) == expected);
+            }
+
+            //two of them share a subject
+            juce::MemoryBlock shared;
+            shared.loadFromHexString(certificates[1].subjectHex);
+            expectEquals(static_cast<int>(index.findBySubject(shared.getData(), shared.getSize()).size()), 2);
+
+            const juce::uint8 emptyName[] = { 0x30, 0x00 };
+            expect(index.findBySubject(emptyName, sizeof(emptyName)).empty());
+        }
+
+        beginTest("certificates are found by serial number, with and without a leading zero");
+        {
+            for( int i = 0; i < numCertificates; ++i )
+            {
+                juce::MemoryBlock serial;
+                serial.loadFromHexString(certificates[static_cast<size_t>(i)].serialNumberHex);
+                auto* bytes = static_cast<const juce::uint8*>(serial.getData());
+
+                const std::vector<int> expected { i };
+                expect(index.findBySerialNumber(bytes, serial.getSize()) == expected);
+
+                if( bytes[0] == 0 )
+                {
+                    expect(index.findBySerialNumber(bytes + 1, serial.getSize() - 1) == expected);
+                }
+                else
+                {
+                    juce::MemoryBlock withZero(1, true);
+                    withZero.append(bytes, serial.getSize());
+                    expect(index.findBySerialNumber(withZero.getData(), withZero.getSize()) == expected);
+                }
+            }
+
+            const juce::uint8 unknown[] = { 0x12, 0x35 };
+            expect(index.findBySerialNumber(unknown, sizeof(unknown)).empty());
+            expect(index.findBySerialNumber(unknown, 0).empty());
+        }
+
+        beginTest("a certificate's public key is the key it was made for");
+        {
+            for( int i = 0; i < numCertificates; ++i )
+            {
+                auto keyPairIndex = certificates[static_cast<size_t>(i)].keyPairIndex;
+                if( keyPairIndex < 0 )
+                    continue;
+
+                PEMFormatKey expected;
+                expected.loadFromPEMFormattedString(keyPairs[static_cast<size_t>(keyPairIndex)].publicKeyPEM);
+                juce::MemoryBlock expectedDER;
+                expect(expected.exportToDER(PEMFormatKey::DERFormat::subjectPublicKeyInfo, expectedDER));
+
+                auto cached = index.getPublicKey(i);
+                expect(cached != nullptr);
+                if( cached == nullptr )
+                    continue;
+
+                juce::MemoryBlock der;
+                expect(cached->key.exportToDER(PEMFormatKey::DERFormat::subjectPublicKeyInfo, der));
+                expect(der == expectedDER);
+                expect(cached->fingerprint == KeyID::fromSHA256(juce::SHA256(expectedDER)));
+
+                //kept after the first time
+                expect(index.getPublicKey(i) == cached);
+            }
+
+            expect(index.getPublicKey(-1) == nullptr);
+            expect(index.getPublicKey(numCertificates) == nullptr);
+        }
+
+        beginTest("a key that isn't RSA doesn't load, and that is remembered");
+        {
+            for( int i = 0; i < numCertificates; ++i )
+            {
+                if( certificates[static_cast<size_t>(i)].keyPairIndex >= 0 )
+                    continue;
+
+                X509CertificateIndex fresh;
+                expectEquals(fresh.addPEMString(bundle), numCertificates);
+
+                for( int n = 0; n < 3; ++n )
+                    expect(fresh.getPublicKey(i) == nullptr);
+
+                //which doesn't stop the others loading
+                expect(fresh.getPublicKey(0) != nullptr);
+                expect(fresh.getPublicKey(i) == nullptr);
+            }
+        }
+    }
+
+    static bool decodePEM(const char* pem, juce::MemoryBlock& der)
+    {
+        PEMHelpers::PEMBlock block;
+        return PEMHelpers::findNextPEMBlock(pem, std::strlen(pem), 0, block)
+            && Base64Decoder::decode(pem + block.bodyStart, block.bodyLength, der);
+    }
+
+    static juce::String toHex(const juce::uint8* data, size_t numBytes)
+    {
+        return juce::String::toHexString(data, static_cast<int>(numBytes), 0).toUpperCase();
+    }
+};
+
+static X509CertificateIndexTests x509CertificateIndexTests;